@@ -0,0 +1,93 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 对比同一个容器在 std::allocator、BPoolAllocator 和 BArenaAllocator 下的表现
+//
+// 每次迭代模拟一次“请求”：创建内存资源和容器、填充 n 个元素、销毁容器和资源，
+// 因此测得的时间包含了所有内存的申请与归还
+//
+
+#include "bench_common.h"
+#include "baby_allocator.h"
+#include "baby_list.h"
+#include "baby_map.h"
+
+
+// @{  // 三种分配策略，屏蔽不同分配器在构造方式上的差异
+namespace {
+
+struct StdPolicy {
+    struct Resource {};
+
+    template<typename Tp>
+    using Alloc = std::allocator<Tp>;
+
+    template<typename Tp>
+    static Alloc<Tp> make(Resource &) { return {}; }
+};
+
+struct PoolPolicy {
+    using Resource = BNodePool;
+
+    template<typename Tp>
+    using Alloc = BPoolAllocator<Tp>;
+
+    template<typename Tp>
+    static Alloc<Tp> make(Resource &pool) { return Alloc<Tp>(pool); }
+};
+
+struct ArenaPolicy {
+    using Resource = BArena;
+
+    template<typename Tp>
+    using Alloc = BArenaAllocator<Tp>;
+
+    template<typename Tp>
+    static Alloc<Tp> make(Resource &arena) { return Alloc<Tp>(arena); }
+};
+
+}  // namespace
+// @}  // 三种分配策略
+
+
+// @{  // 基准测试的实现
+// 创建一个 BList 并在尾部添加 n 个元素
+template<typename Policy>
+void BM_ListBuild(benchmark::State &state) {
+    using List = BList<int, typename Policy::template Alloc<int>>;
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        typename Policy::Resource res;
+        List list(Policy::template make<int>(res));
+        for (std::int64_t i = 0; i < n; i++) list.push_back(static_cast<int>(i));
+        benchmark::DoNotOptimize(list);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 创建一个 BMap 并以随机顺序插入 n 个键
+template<typename Policy>
+void BM_MapBuild(benchmark::State &state) {
+    using Value = std::pair<const int, int>;
+    using Map = BMap<int, int, std::less<int>, typename Policy::template Alloc<Value>>;
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        typename Policy::Resource res;
+        Map map(Policy::template make<Value>(res));
+        for (int k : keys) map.insert({k, k});
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试
+BENCHMARK_TEMPLATE(BM_ListBuild, StdPolicy)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ListBuild, PoolPolicy)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ListBuild, ArenaPolicy)->Apply(bench::linear_sizes);
+
+BENCHMARK_TEMPLATE(BM_MapBuild, StdPolicy)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_MapBuild, PoolPolicy)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_MapBuild, ArenaPolicy)->Apply(bench::linear_sizes);
+// @}  // 注册基准测试
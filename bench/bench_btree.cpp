@@ -0,0 +1,156 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// B+ 树容器 BBTreeMap 与 BMap、std::map 的对比基准测试
+//
+
+#include <map>
+
+#include "bench_common.h"
+#include "baby_map.h"
+#include "baby_btree_map.h"
+
+// 元素数目的上限，默认 16M。内存充足的机器上可以通过 -D 放大，例如 6400 万个元素：
+// -DCPPBABYSTL_BENCH_BTREE_MAX=67108864
+#ifndef CPPBABYSTL_BENCH_BTREE_MAX
+#define CPPBABYSTL_BENCH_BTREE_MAX (1 << 24)
+#endif
+
+
+// @{  // 辅助函数
+namespace {
+
+// 从 1K 到 CPPBABYSTL_BENCH_BTREE_MAX，规模越大越能体现缓存未命中的代价
+void btree_sizes(benchmark::internal::Benchmark *b) {
+    bench::size_range(b, 1 << 10, CPPBABYSTL_BENCH_BTREE_MAX);
+    b->Unit(benchmark::kMillisecond);
+}
+
+// 范围扫描中每次 lower_bound 之后顺序访问的元素数目
+constexpr int kScanLength = 64;
+
+// 查找使用与插入不同的随机顺序，避免节点的分配顺序与访问顺序一致
+std::vector<int> lookup_order(std::vector<int> keys) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(bench::kSeed + 1));
+    return keys;
+}
+
+template<typename C>
+C make_filled(const std::vector<int> &keys) {
+    C c;
+    for (int k : keys) c.insert(std::pair<int, int>(k, k));
+    return c;
+}
+
+}  // namespace
+// @}  // 辅助函数
+
+
+// @{  // 基准测试的实现
+// 以随机顺序插入 n 个互不相同的键，rss_per_entry 为建成后每个元素占用的内存
+template<typename C>
+void BM_BTreeInsert(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    double rss_per_entry = 0;
+    for (auto _ : state) {
+        bench::trim_heap();
+        const auto rss_before = static_cast<double>(bench::current_rss_bytes());
+        C c;
+        for (int k : keys) c.insert(std::pair<int, int>(k, k));
+        benchmark::DoNotOptimize(c);
+        rss_per_entry = (static_cast<double>(bench::current_rss_bytes()) - rss_before) / state.range(0);
+    }
+    state.counters["rss_per_entry"] = rss_per_entry;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 按升序插入 n 个键
+template<typename C>
+void BM_BTreeInsertSorted(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int k = 0; k < n; k++) c.insert(std::pair<int, int>(k, k));
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序查找 n 个存在的键
+template<typename C>
+void BM_BTreeFind(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const C c = make_filled<C>(keys);
+    const auto order = lookup_order(keys);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int k : order) hits += (c.find(k) != c.end());
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 范围扫描：lower_bound 定位到随机的键后顺序读取 kScanLength 个元素
+template<typename C>
+void BM_BTreeRangeScan(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const C c = make_filled<C>(keys);
+    const auto order = lookup_order(keys);
+    const std::size_t scans = std::min<std::size_t>(order.size(), 1 << 16);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (std::size_t i = 0; i < scans; i++) {
+            auto it = c.lower_bound(order[i]);
+            for (int j = 0; j < kScanLength && it != c.end(); j++, ++it) sum += (*it).second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * scans * kScanLength);
+}
+
+// 按顺序遍历全部元素
+template<typename C>
+void BM_BTreeIterate(benchmark::State &state) {
+    const C c = make_filled<C>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto it = c.begin(); it != c.end(); ++it) sum += (*it).second;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序逐个删除容器中的所有键
+template<typename C>
+void BM_BTreeErase(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const auto order = lookup_order(keys);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        for (int k : order) c.erase(k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，每个测试依次运行 BBTreeMap、BMap 和 std::map
+using BBTreeMapInt = BBTreeMap<int, int>;
+using BMapInt = BMap<int, int>;
+using StdMapInt = std::map<int, int>;
+
+#define BTREE_BENCH(func)                                                       \
+    BENCHMARK_TEMPLATE(func, BBTreeMapInt)->Apply(btree_sizes);                 \
+    BENCHMARK_TEMPLATE(func, BMapInt)->Apply(btree_sizes);                      \
+    BENCHMARK_TEMPLATE(func, StdMapInt)->Apply(btree_sizes)
+
+BTREE_BENCH(BM_BTreeInsert);
+BTREE_BENCH(BM_BTreeInsertSorted);
+BTREE_BENCH(BM_BTreeFind);
+BTREE_BENCH(BM_BTreeRangeScan);
+BTREE_BENCH(BM_BTreeIterate);
+BTREE_BENCH(BM_BTreeErase);
+// @}  // 注册基准测试
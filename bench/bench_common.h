@@ -0,0 +1,122 @@
+//
+// Created by DELL on 2026/10/16.
+//
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifndef CPPBABYSTL_BENCH_COMMON_H
+#define CPPBABYSTL_BENCH_COMMON_H
+
+namespace bench {
+
+// 所有基准测试共用的随机数种子，保证不同构建之间的输入完全一致
+constexpr std::uint32_t kSeed = 20240710;
+
+/*
+ * @brief 生成 [0, n) 的一个随机排列
+ * @param n 排列的长度
+ *
+ * 用作关联容器的键，保证键互不相同且插入顺序随机
+ * */
+inline std::vector<int> shuffled_keys(std::size_t n) {
+    std::vector<int> keys(n);
+    for (std::size_t i = 0; i < n; i++) keys[i] = static_cast<int>(i);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(kSeed));
+    return keys;
+}
+
+/*
+ * @brief 生成长度为 n 的随机小写字母串
+ * @param n 字符串的长度
+ * */
+inline std::vector<char> random_letters(std::size_t n) {
+    std::mt19937 rng(kSeed);
+    std::vector<char> buf(n);
+    for (auto &c : buf) c = static_cast<char>('a' + rng() % 26);
+    return buf;
+}
+
+/*
+ * @brief 在序列容器中线性查找 val，返回其出现的次数
+ *
+ * 部分 B 系列容器的迭代器没有提供 iterator_traits，无法直接使用
+ * std::find，因此统一使用范围 for 进行查找
+ * */
+template<typename Container, typename Tp>
+std::size_t linear_count(const Container &c, const Tp &val) {
+    std::size_t cnt = 0;
+    for (const auto &it : c) {
+        if (it == val) ++cnt;
+    }
+    return cnt;
+}
+
+/*
+ * @brief 返回当前进程的常驻内存（RSS）字节数
+ *
+ * 只在 Linux 上读取 /proc/self/statm，其他平台返回 0
+ * */
+inline std::size_t current_rss_bytes() {
+#if defined(__linux__)
+    std::FILE *f = std::fopen("/proc/self/statm", "r");
+    if (f == nullptr) return 0;
+    unsigned long size = 0, resident = 0;
+    int got = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    if (got != 2) return 0;
+    return static_cast<std::size_t>(resident) * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// 把 malloc 缓存的空闲内存还给操作系统，使前面测试释放的内存不影响 RSS 的增量
+inline void trim_heap() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+// 以 8 为倍率，在 [lo, hi] 范围内生成参数
+inline void size_range(benchmark::internal::Benchmark *b,
+                       std::int64_t lo, std::int64_t hi) {
+    b->RangeMultiplier(8)->Range(lo, hi);
+}
+
+// 线性时间操作（push_back、iterate、copy等）使用的参数范围
+inline void linear_sizes(benchmark::internal::Benchmark *b) {
+    size_range(b, 1 << 10, 1 << 20);
+}
+
+// 平方时间操作（在中间位置插入、删除等）使用的参数范围
+inline void quadratic_sizes(benchmark::internal::Benchmark *b) {
+    size_range(b, 1 << 8, 1 << 14);
+}
+
+}  // namespace bench
+
+/*
+ * 成对注册 B 系列容器与对应 std:: 容器的同一个基准测试
+ * @param func  基准测试函数模板
+ * @param btype B 系列容器类型
+ * @param stype 对应的 std:: 容器类型
+ * @param sizes 参数范围，如 bench::linear_sizes
+ * */
+#define BENCH_PAIR(func, btype, stype, sizes)           \
+    BENCHMARK_TEMPLATE(func, btype)->Apply(sizes);      \
+    BENCHMARK_TEMPLATE(func, stype)->Apply(sizes)
+
+#endif //CPPBABYSTL_BENCH_COMMON_H
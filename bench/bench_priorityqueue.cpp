@@ -0,0 +1,89 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// BPriorityQueue 与 std::priority_queue 的对比基准测试
+//
+
+#include <queue>
+
+#include "bench_common.h"
+#include "baby_priorityqueue.h"
+
+
+namespace {
+
+template<typename Q>
+Q make_filled(const std::vector<int> &keys) {
+    Q q;
+    for (int k : keys) q.push(k);
+    return q;
+}
+
+}  // namespace
+
+
+// @{  // 基准测试的实现
+// 以随机顺序压入 n 个元素
+template<typename Q>
+void BM_Push(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        Q q;
+        for (int k : keys) q.push(k);
+        benchmark::DoNotOptimize(q);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 逐个弹出堆顶元素，直到队列为空（相当于堆排序）
+template<typename Q>
+void BM_Pop(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Q q = make_filled<Q>(keys);
+        state.ResumeTiming();
+        long long sum = 0;
+        while (!q.empty()) {
+            sum += q.top();
+            q.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 拷贝构造一个含有 n 个元素的优先队列
+template<typename Q>
+void BM_Copy(benchmark::State &state) {
+    const Q src = make_filled<Q>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        Q dst(src);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 移动构造 + 交换，理想情况下与 n 无关
+template<typename Q>
+void BM_Move(benchmark::State &state) {
+    Q q = make_filled<Q>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        Q tmp(std::move(q));
+        q.swap(tmp);
+        benchmark::DoNotOptimize(q);
+    }
+    if (q.size() != static_cast<std::size_t>(state.range(0))) {
+        state.SkipWithError("queue lost elements after move");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，BPriorityQueue 与 std::priority_queue 成对出现以便于对比
+BENCH_PAIR(BM_Push, BPriorityQueue<int>, std::priority_queue<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Pop, BPriorityQueue<int>, std::priority_queue<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Copy, BPriorityQueue<int>, std::priority_queue<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Move, BPriorityQueue<int>, std::priority_queue<int>, bench::linear_sizes);
+// @}  // 注册基准测试
@@ -0,0 +1,337 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 序列容器（BVector、BDeque、BList、BForwardList）与对应 std:: 容器的对比基准测试
+//
+
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "baby_vector.h"
+#include "baby_deque.h"
+#include "baby_list.h"
+#include "baby_forwardlist.h"
+
+
+// @{  // 屏蔽不同容器之间接口差异的辅助函数
+namespace {
+
+// 在容器尾部添加元素，单链表没有尾指针，只能在头部添加
+template<typename C>
+void push_one(C &c, int val) { c.push_back(val); }
+
+template<typename Tp>
+void push_one(BForwardList<Tp> &c, int val) { c.push_front(val); }
+
+template<typename Tp>
+void push_one(std::forward_list<Tp> &c, int val) { c.push_front(val); }
+
+template<typename C>
+C make_filled(std::int64_t n) {
+    C c;
+    for (std::int64_t i = 0; i < n; i++) push_one(c, static_cast<int>(i));
+    return c;
+}
+
+// 在索引 idx 处插入元素
+template<typename Tp>
+void insert_at(BVector<Tp> &c, std::size_t idx, int val) { c.insert(idx, val); }
+
+template<typename Tp>
+void insert_at(BDeque<Tp> &c, std::size_t idx, int val) { c.insert(idx, val); }
+
+template<typename Tp>
+void insert_at(BList<Tp> &c, std::size_t idx, int val) {
+    auto it = c.begin();
+    for (std::size_t i = 0; i < idx; i++) ++it;
+    c.insert(it, val);
+}
+
+template<typename C>
+void insert_at(C &c, std::size_t idx, int val) {
+    c.insert(std::next(c.begin(), static_cast<std::ptrdiff_t>(idx)), val);
+}
+
+// 在索引 idx 处插入 [first, last) 内的所有元素
+template<typename Tp, typename Iter>
+void insert_range_at(BVector<Tp> &c, std::size_t idx, Iter first, Iter last) {
+    c.insert(idx, first, last);
+}
+
+template<typename Tp, typename Iter>
+void insert_range_at(std::vector<Tp> &c, std::size_t idx, Iter first, Iter last) {
+    c.insert(c.begin() + static_cast<std::ptrdiff_t>(idx), first, last);
+}
+
+// 删除索引为 idx 的元素
+template<typename Tp>
+void erase_at(BVector<Tp> &c, std::size_t idx) { c.erase(idx); }
+
+template<typename Tp>
+void erase_at(BDeque<Tp> &c, std::size_t idx) { c.erase(idx); }
+
+template<typename Tp>
+void erase_at(BList<Tp> &c, std::size_t idx) {
+    auto it = c.begin();
+    for (std::size_t i = 0; i < idx; i++) ++it;
+    c.erase(it);
+}
+
+template<typename C>
+void erase_at(C &c, std::size_t idx) {
+    c.erase(std::next(c.begin(), static_cast<std::ptrdiff_t>(idx)));
+}
+
+// 返回容器的元素数目，std::forward_list 没有 size()
+template<typename C>
+std::size_t size_of(const C &c) { return c.size(); }
+
+template<typename Tp>
+std::size_t size_of(const std::forward_list<Tp> &c) {
+    return static_cast<std::size_t>(std::distance(c.begin(), c.end()));
+}
+
+/*
+ * 统计拷贝构造与移动构造次数的元素类型
+ *
+ * 持有一块堆上的负载，拷贝的代价远高于移动，用于检查容器在添加右值时
+ * 是否发生了不必要的深拷贝
+ * */
+struct Tracked {
+    static inline std::int64_t copies = 0;
+    static inline std::int64_t moves = 0;
+
+    std::string payload;
+
+    explicit Tracked(std::int64_t i) : payload(64, static_cast<char>('a' + i % 26)) {}
+    Tracked(const Tracked &other) : payload(other.payload) { ++copies; }
+    Tracked(Tracked &&other) noexcept : payload(std::move(other.payload)) { ++moves; }
+    Tracked &operator=(const Tracked &other) = default;
+    Tracked &operator=(Tracked &&other) noexcept = default;
+
+    static void reset() { copies = moves = 0; }
+};
+
+}  // namespace
+// @}  // 屏蔽不同容器之间接口差异的辅助函数
+
+
+// @{  // 基准测试的实现
+// 通过 push_back 逐个添加 n 个元素
+template<typename C>
+void BM_PushBack(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i++) c.push_back(static_cast<int>(i));
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 通过 emplace_back 逐个添加 n 个超出 SSO 长度的 std::string，考察扩容时搬迁元素的开销
+template<typename C>
+void BM_PushBackString(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i++) c.emplace_back(32, 'a');
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+/*
+ * 通过 push_back(Tp&&) 逐个添加 n 个右值，并统计平均每个元素触发的
+ * 拷贝构造（copies）与移动构造（moves）次数，扩容时的搬迁也计算在内
+ * */
+template<typename C>
+void BM_PushBackRvalue(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    Tracked::reset();
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i++) c.push_back(Tracked(i));
+        benchmark::DoNotOptimize(c);
+    }
+    const double items = static_cast<double>(state.iterations() * n);
+    state.counters["copies"] = static_cast<double>(Tracked::copies) / items;
+    state.counters["moves"] = static_cast<double>(Tracked::moves) / items;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 通过 push_front 逐个添加 n 个元素
+template<typename C>
+void BM_PushFront(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i++) c.push_front(static_cast<int>(i));
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 每次都在容器的正中间插入元素，直到容器中有 n 个元素
+template<typename C>
+void BM_InsertMiddle(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i++) {
+            insert_at(c, static_cast<std::size_t>(i / 2), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 每次在容器正中间插入 64 个元素，直到容器中有 n 个元素
+template<typename C>
+void BM_InsertRangeMiddle(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const std::vector<int> chunk(64, 1);
+    for (auto _ : state) {
+        C c;
+        for (std::int64_t i = 0; i < n; i += 64) {
+            insert_range_at(c, static_cast<std::size_t>(i / 2), chunk.begin(), chunk.end());
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 线性查找一个不存在的元素（最坏情况）
+template<typename C>
+void BM_Find(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const C c = make_filled<C>(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench::linear_count(c, -1));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 顺序遍历容器中的所有元素
+template<typename C>
+void BM_Iterate(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const C c = make_filled<C>(n);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto &it : c) sum += it;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 每次都删除容器正中间的元素，直到容器为空
+template<typename C>
+void BM_EraseMiddle(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(n);
+        state.ResumeTiming();
+        for (std::int64_t i = n; i > 0; i--) {
+            erase_at(c, static_cast<std::size_t>(i / 2));
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 逐个删除容器的首元素，直到容器为空
+template<typename C>
+void BM_PopFront(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(n);
+        state.ResumeTiming();
+        for (std::int64_t i = 0; i < n; i++) c.pop_front();
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 拷贝构造一个含有 n 个元素的容器
+template<typename C>
+void BM_Copy(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const C src = make_filled<C>(n);
+    for (auto _ : state) {
+        C dst(src);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 移动构造 + 移动赋值，理想情况下与 n 无关
+template<typename C>
+void BM_Move(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    C c = make_filled<C>(n);
+    for (auto _ : state) {
+        C tmp(std::move(c));
+        c = std::move(tmp);
+        benchmark::DoNotOptimize(c);
+    }
+    if (size_of(c) != static_cast<std::size_t>(n)) {
+        state.SkipWithError("container lost elements after move");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，B 系列容器与 std:: 容器成对出现以便于对比
+BENCH_PAIR(BM_PushBack, BVector<int>, std::vector<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PushBack, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PushBack, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PushBackString, BVector<std::string>, std::vector<std::string>, bench::linear_sizes);
+BENCH_PAIR(BM_PushBackRvalue, BVector<Tracked>, std::vector<Tracked>, bench::linear_sizes);
+
+BENCH_PAIR(BM_PushFront, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PushFront, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PushFront, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+
+// BForwardList 只支持在头部插入，不参与中间位置的插入/删除测试
+BENCH_PAIR(BM_InsertMiddle, BVector<int>, std::vector<int>, bench::quadratic_sizes);
+BENCH_PAIR(BM_InsertMiddle, BDeque<int>, std::deque<int>, bench::quadratic_sizes);
+BENCH_PAIR(BM_InsertMiddle, BList<int>, std::list<int>, bench::quadratic_sizes);
+
+BENCH_PAIR(BM_InsertRangeMiddle, BVector<int>, std::vector<int>, bench::linear_sizes);
+
+BENCH_PAIR(BM_Find, BVector<int>, std::vector<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Find, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Find, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Find, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+
+BENCH_PAIR(BM_Iterate, BVector<int>, std::vector<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Iterate, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Iterate, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Iterate, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+
+BENCH_PAIR(BM_EraseMiddle, BVector<int>, std::vector<int>, bench::quadratic_sizes);
+BENCH_PAIR(BM_EraseMiddle, BDeque<int>, std::deque<int>, bench::quadratic_sizes);
+BENCH_PAIR(BM_EraseMiddle, BList<int>, std::list<int>, bench::quadratic_sizes);
+
+BENCH_PAIR(BM_PopFront, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PopFront, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_PopFront, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+
+BENCH_PAIR(BM_Copy, BVector<int>, std::vector<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Copy, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Copy, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Copy, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+
+BENCH_PAIR(BM_Move, BVector<int>, std::vector<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Move, BDeque<int>, std::deque<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Move, BList<int>, std::list<int>, bench::linear_sizes);
+BENCH_PAIR(BM_Move, BForwardList<int>, std::forward_list<int>, bench::linear_sizes);
+// @}  // 注册基准测试
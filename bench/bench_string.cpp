@@ -0,0 +1,952 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// BString 与 std::string 的对比基准测试
+//
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <charconv>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "bench_common.h"
+#include "baby_string.h"
+#include "baby_charconv.h"
+#include "baby_hash.h"
+#include "baby_map.h"
+#include "baby_string_builder.h"
+#include "baby_rope.h"
+#include "baby_shared_string.h"
+#include "baby_vector.h"
+
+
+// @{  // 统计堆内存申请次数
+/*
+ * 替换全局的 operator new / delete，用于统计 BM_KeyCorpus 等基准测试中的
+ * 内存申请次数和申请的字节数
+ *
+ * 替换对整个 cppBabySTL_bench 生效，但只增加一次计数，对其他基准测试的影响
+ * 可以忽略。所有基准测试都是单线程运行的，因此计数器不需要是原子变量。
+ * 普通、数组、nothrow 和对齐版本全部替换，所有内存都由 malloc 系列申请、
+ * 由 std::free 释放
+ * */
+namespace {
+std::size_t g_alloc_count = 0;
+std::size_t g_alloc_bytes = 0;
+
+// 申请 size 字节并计数，align 不超过默认对齐时使用 malloc，失败时返回 nullptr
+void *counted_alloc(std::size_t size, std::size_t align) noexcept {
+    ++g_alloc_count;
+    g_alloc_bytes += size;
+    if (size == 0) size = 1;
+    if (align <= alignof(std::max_align_t)) return std::malloc(size);
+    // aligned_alloc 要求 size 是 align 的整数倍
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+}
+
+void *counted_alloc_or_throw(std::size_t size, std::size_t align) {
+    if (void *p = counted_alloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+}  // namespace
+
+/*
+ * GCC 会把内联后的标准库 operator new 与这里的 std::free 视为不匹配的一对而报告
+ * -Wmismatched-new-delete。这里的所有 new 都由 malloc 实现，与 std::free 配对
+ * 是正确的，因此只在这组定义中关闭该警告
+ * */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size) { return counted_alloc_or_throw(size, 0); }
+
+void *operator new[](std::size_t size) { return counted_alloc_or_throw(size, 0); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size, 0); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size, 0); }
+
+void *operator new(std::size_t size, std::align_val_t al) {
+    return counted_alloc_or_throw(size, static_cast<std::size_t>(al));
+}
+
+void *operator new[](std::size_t size, std::align_val_t al) {
+    return counted_alloc_or_throw(size, static_cast<std::size_t>(al));
+}
+
+void *operator new(std::size_t size, std::align_val_t al, const std::nothrow_t &) noexcept {
+    return counted_alloc(size, static_cast<std::size_t>(al));
+}
+
+void *operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t &) noexcept {
+    return counted_alloc(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+// @}  // 统计堆内存申请次数
+
+
+namespace {
+
+/*
+ * 生成 n 个常见的短键：ISO 8601 时间戳（20 字节）、base64url 编码的
+ * UUID（22 字节）、会话 id（23 字节）和用户 id（17 字节），与业务中
+ * 常见的 map 键的长度分布相近
+ * */
+std::vector<std::string> make_key_corpus(std::size_t n) {
+    static const char kBase64[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::string> keys;
+    keys.reserve(n);
+
+    char buf[64];
+    for (std::size_t i = 0; i < n; i++) {
+        switch (i % 4) {
+            case 0:
+                std::snprintf(buf, sizeof(buf), "2026-%02u-%02uT%02u:%02u:%02uZ",
+                              static_cast<unsigned>(1 + rng() % 12), static_cast<unsigned>(1 + rng() % 28),
+                              static_cast<unsigned>(rng() % 24), static_cast<unsigned>(rng() % 60),
+                              static_cast<unsigned>(rng() % 60));
+                keys.emplace_back(buf);
+                break;
+            case 1:
+                keys.emplace_back(22, ' ');
+                for (char &c : keys.back()) c = kBase64[rng() % 64];
+                break;
+            case 2:
+                std::snprintf(buf, sizeof(buf), "sess_%08x%08x%02x", static_cast<unsigned>(rng()),
+                              static_cast<unsigned>(rng()), static_cast<unsigned>(rng() % 256));
+                keys.emplace_back(buf);
+                break;
+            default:
+                std::snprintf(buf, sizeof(buf), "user:%012u", static_cast<unsigned>(rng()));
+                keys.emplace_back(buf);
+                break;
+        }
+    }
+    return keys;
+}
+
+// 构造一个由 n 个随机小写字母组成的字符串
+template<typename S>
+S make_text(std::int64_t n) {
+    const auto letters = bench::random_letters(n);
+    S s;
+    for (char c : letters) s.push_back(c);
+    return s;
+}
+
+// 返回 s 中从 idx 开始、长度为 n 的子串视图，屏蔽 BString 与 std::string 的差异
+BStringView slice_view(const BString &s, std::size_t idx, std::size_t n) {
+    return s.substr_view(idx, n);
+}
+
+std::string_view slice_view(const std::string &s, std::size_t idx, std::size_t n) {
+    return std::string_view(s).substr(idx, n);
+}
+
+// @{  // 文本处理的各个步骤，std::string 版本使用业务代码中常见的写法
+void to_lower_inplace(BString &s) { s.to_lower(); }
+
+void to_lower_inplace(std::string &s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+}
+
+void trim_inplace(BString &s) { s.trim(); }
+
+void trim_inplace(std::string &s) {
+    const char *kSpaces = " \t\n\v\f\r";
+    s.erase(s.find_last_not_of(kSpaces) + 1);
+    s.erase(0, s.find_first_not_of(kSpaces));
+}
+
+// BString 切分为复用的视图数组，std::string 切分为子串数组
+template<typename S>
+using SplitOut = typename std::conditional<std::is_same<S, BString>::value,
+        BVector<BStringView>, std::vector<std::string>>::type;
+
+std::size_t split_fields(const BString &s, char delim, BVector<BStringView> &out) {
+    return s.split(delim, out);
+}
+
+std::size_t split_fields(const std::string &s, char delim, std::vector<std::string> &out) {
+    out.clear();
+    for (std::size_t r = 0;;) {
+        std::size_t p = s.find(delim, r);
+        out.push_back(s.substr(r, p == std::string::npos ? std::string::npos : p - r));
+        if (p == std::string::npos) break;
+        r = p + 1;
+    }
+    return out.size();
+}
+
+void replace_all_inplace(BString &s, const char *from, const char *to) { s.replace_all(from, to); }
+
+void replace_all_inplace(std::string &s, const std::string &from, const std::string &to) {
+    for (std::size_t p = s.find(from); p != std::string::npos; p = s.find(from, p + to.size())) {
+        s.replace(p, from.size(), to);
+    }
+}
+
+/*
+ * 生成 n 条访问日志记录：首尾带有空白、大小写混合、以','分隔的 8 个字段，
+ * 平均长度约 110 字节
+ * */
+std::vector<std::string> make_records(std::size_t n) {
+    static const char *kMethods[] = {"GET", "POST", "Put", "delete"};
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::string> records;
+    records.reserve(n);
+    char buf[256];
+    for (std::size_t i = 0; i < n; i++) {
+        std::snprintf(buf, sizeof(buf),
+                      "  User-%05u,%s,/Api/V1/Items/%u,%u,%u,Mozilla/5.0 (X11; Linux x86_64),Region-%c%c,%u ms \t\r\n",
+                      static_cast<unsigned>(rng() % 100000), kMethods[rng() % 4],
+                      static_cast<unsigned>(rng() % 1000000), 200 + static_cast<unsigned>(rng() % 5),
+                      static_cast<unsigned>(rng() % 65536), 'A' + static_cast<char>(rng() % 26),
+                      'A' + static_cast<char>(rng() % 26), static_cast<unsigned>(rng() % 2000));
+        records.emplace_back(buf);
+    }
+    return records;
+}
+// @}  // 文本处理的各个步骤
+
+}  // namespace
+
+
+// @{  // 基准测试的实现
+// 通过 push_back 逐个添加 n 个字符
+template<typename S>
+void BM_PushBack(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        S s;
+        for (std::int64_t i = 0; i < n; i++) s.push_back(static_cast<char>('a' + i % 26));
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 每次追加一个 16 字节的片段，直到字符串长度达到 n
+template<typename S>
+void BM_Append(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const char *piece = "0123456789abcdef";
+    for (auto _ : state) {
+        S s;
+        for (std::int64_t len = 0; len < n; len += 16) s.append(piece);
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本中查找一个不存在的 8 字节模式串
+template<typename S>
+void BM_Find(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    const S pattern("abcdefgh");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find(pattern));
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本末尾查找一个存在的 8 字节模式串
+template<typename S>
+void BM_FindHit(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    S text = make_text<S>(n);
+    const S pattern("abcdefgh");
+    text.append(pattern);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find(pattern));
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本中查找一个不存在的 64 字节模式串（长模式串路径）
+template<typename S>
+void BM_FindLong(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    const S pattern(std::string(63, 'a').append("z").c_str());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find(pattern));
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本中反向查找一个不存在的 8 字节模式串
+template<typename S>
+void BM_RFind(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    const S pattern("abcdefgh");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.rfind(pattern));
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本中查找第一个分隔符（文本中不存在）
+template<typename S>
+void BM_FindFirstOf(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    const S delims(" \t,;:|");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find_first_of(delims));
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 用同一个预编译的模式串逐行扫描 n 行 128 字节的文本
+static void BM_StringSearcherLines(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    std::vector<BString> lines;
+    for (std::int64_t i = 0; i < n; i++) lines.push_back(make_text<BString>(128));
+    const BStringSearcher searcher("ERROR: connection reset by peer");
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (const auto &line : lines) hits += line.find(searcher) != BString::npos;
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetBytesProcessed(state.iterations() * n * 128);
+}
+
+// 由短键语料构造 n 个字符串，统计平均每个键触发的内存申请次数（allocs_per_key）
+template<typename S>
+void BM_KeyCorpus(benchmark::State &state) {
+    const auto keys = make_key_corpus(static_cast<std::size_t>(state.range(0)));
+    std::size_t allocs = 0;
+    for (auto _ : state) {
+        std::size_t before = g_alloc_count;
+        for (const auto &k : keys) {
+            S s(k.c_str());
+            benchmark::DoNotOptimize(s);
+        }
+        allocs += g_alloc_count - before;
+    }
+    state.counters["allocs_per_key"] =
+            static_cast<double>(allocs) / static_cast<double>(state.iterations() * keys.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 把 n 字节的文本切分成 16 字节的字段，分别比较 substr（复制）与子串视图（不复制）
+template<typename S>
+void BM_SubstrFields(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i + 16 <= n; i += 16) {
+            auto field = text.substr(i, 16);
+            benchmark::DoNotOptimize(field);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+template<typename S>
+void BM_SliceViewFields(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i + 16 <= n; i += 16) {
+            auto field = slice_view(text, i, 16);
+            benchmark::DoNotOptimize(field);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+/*
+ * 从一段拼接好的缓冲区中切出键，在 BMap<BString, int> 中查找
+ *
+ * Compare 为 std::less<BString> 时每次查找都要先构造一个 BString；
+ * 为 std::less<> 时直接使用 BStringView 进行异构查找。语料中超过 23 字节
+ * 的键会在前一种情况下触发内存申请，见 allocs_per_lookup
+ * */
+template<typename Compare>
+void BM_MapLookupView(benchmark::State &state) {
+    auto keys = make_key_corpus(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < keys.size(); i += 8) keys[i] += "/profile/settings";
+
+    std::string buffer;
+    std::vector<std::pair<std::size_t, std::size_t>> spans;
+    BMap<BString, int, Compare> map;
+    for (const auto &k : keys) {
+        spans.emplace_back(buffer.size(), k.size());
+        buffer += k;
+        map[BString(k)] = 1;
+    }
+
+    std::size_t allocs = 0;
+    for (auto _ : state) {
+        std::size_t before = g_alloc_count;
+        std::size_t hits = 0;
+        for (auto [pos, len] : spans) {
+            BStringView key(buffer.data() + pos, len);
+            if constexpr (std::is_same_v<Compare, std::less<>>) {
+                hits += map.find(key) != map.end();
+            } else {
+                hits += map.find(BString(key)) != map.end();
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+        allocs += g_alloc_count - before;
+    }
+    state.counters["allocs_per_lookup"] =
+            static_cast<double>(allocs) / static_cast<double>(state.iterations() * spans.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 比较两个内容相同、长度为 n 的字符串是否相等（需要比较全部字节）
+template<typename S>
+void BM_Equal(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S a = make_text<S>(n);
+    const S b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        bool eq = a == b;
+        benchmark::DoNotOptimize(eq);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 以带有公共前缀的二进制键（含'\0'）构建 BMap 并逐个查找，比较主要耗费在长公共前缀上
+template<typename S>
+void BM_BlobKeyLookup(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const std::string prefix(48, '\0');
+    std::vector<S> keys;
+    BMap<S, int> map;
+    for (std::int64_t i = 0; i < n; i++) {
+        std::string k = prefix;
+        auto v = static_cast<std::uint32_t>(i) * 2654435761u;  // 奇数乘子保证各个键互不相同
+        k.append(reinterpret_cast<const char *>(&v), sizeof(v));
+        keys.emplace_back(k.data(), k.size());
+        map[keys.back()] = static_cast<int>(i);
+    }
+    for (auto _ : state) {
+        std::int64_t sum = 0;
+        for (const auto &k : keys) sum += (*map.find(k)).second;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 用 out = std::move(out) + piece 拼接 n 个 64 字节的片段，左操作数为右值时不应复制
+template<typename S>
+void BM_ConcatChain(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S piece = make_text<S>(64);
+    for (auto _ : state) {
+        S out;
+        for (std::int64_t i = 0; i < n; i++) out = std::move(out) + piece;
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * n * 64);
+}
+
+// 逐段追加 n 个 64 字节的片段构建响应体，最后得到一个连续的字符串
+template<typename S>
+void BM_BuildBody(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const std::string piece = make_text<std::string>(64);
+    for (auto _ : state) {
+        S out;
+        for (std::int64_t i = 0; i < n; i++) out.append(piece);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * n * 64);
+}
+
+static void BM_BuildBodyBuilder(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const std::string piece = make_text<std::string>(64);
+    for (auto _ : state) {
+        BStringBuilder builder;
+        for (std::int64_t i = 0; i < n; i++) builder.append(piece);
+        BString out = builder.str();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * n * 64);
+}
+
+// 从长度为 n 的文本中截取 1000 个随机位置、长度为 n / 2 的子串
+template<typename S>
+void BM_LargeSubstr(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::size_t> pos(1000);
+    for (auto &p : pos) p = rng() % static_cast<std::size_t>(n / 2);
+    for (auto _ : state) {
+        for (std::size_t p : pos) {
+            auto sub = text.substr(p, n / 2);
+            benchmark::DoNotOptimize(sub);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+static void BM_LargeSubstrRope(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    BRope text;
+    for (std::int64_t i = 0; i < n; i += 4096) text += make_text<BString>(std::min<std::int64_t>(4096, n - i));
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::size_t> pos(1000);
+    for (auto &p : pos) p = rng() % static_cast<std::size_t>(n / 2);
+    for (auto _ : state) {
+        for (std::size_t p : pos) {
+            auto sub = text.substr(p, n / 2);
+            benchmark::DoNotOptimize(sub);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+/*
+ * 从 1024 个不同的 48 字节键中循环取出 n 个放入 BVector，模拟同一批键被
+ * 复制到大量容器元素中的场景。bytes_per_key 为平均每个元素额外申请的
+ * 堆内存（不含 BVector 自身的缓冲区）
+ * */
+template<typename S>
+void BM_DuplicateKeys(benchmark::State &state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<S> pool;
+    for (int i = 0; i < 1024; i++) {
+        std::string k = "config/service-" + std::to_string(i) + "/";
+        k.resize(48, 'x');
+        pool.emplace_back(k.c_str());
+    }
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        BVector<S> keys;
+        keys.reserve(n);
+        std::size_t before = g_alloc_bytes;
+        for (std::size_t i = 0; i < n; i++) keys.push_back(pool[i % pool.size()]);
+        bytes += g_alloc_bytes - before;
+        benchmark::DoNotOptimize(keys);
+    }
+    state.counters["bytes_per_key"] =
+            static_cast<double>(bytes) / static_cast<double>(state.iterations() * n);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 顺序遍历字符串中的所有字符
+template<typename S>
+void BM_Iterate(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (char c : text) sum += c;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 每次都删除字符串正中间的字符，直到字符串为空
+template<typename S>
+void BM_EraseMiddle(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    for (auto _ : state) {
+        state.PauseTiming();
+        S s(text);
+        state.ResumeTiming();
+        for (std::int64_t i = n; i > 0; i--) {
+            s.erase(static_cast<std::size_t>(i / 2), 1);
+        }
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// 拷贝构造一个长度为 n 的字符串
+template<typename S>
+void BM_Copy(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S src = make_text<S>(n);
+    for (auto _ : state) {
+        S dst(src);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 移动构造 + 移动赋值，理想情况下与 n 无关
+template<typename S>
+void BM_Move(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    S s = make_text<S>(n);
+    for (auto _ : state) {
+        S tmp(std::move(s));
+        s = std::move(tmp);
+        benchmark::DoNotOptimize(s);
+    }
+    if (s.size() != static_cast<std::size_t>(n)) {
+        state.SkipWithError("string lost characters after move");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// @{  // 批量变换
+// 把长度为 n 的大小写混合文本原地转换为小写
+template<typename S>
+void BM_ToLower(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    S text = make_text<S>(n);
+    for (std::int64_t i = 0; i < n; i += 3) text[static_cast<std::size_t>(i)] = 'A' + static_cast<char>(i % 26);
+    for (auto _ : state) {
+        to_lower_inplace(text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+// 在长度为 n 的随机文本中把所有的 "ab" 替换为 "<b>"，替换后文本变长
+template<typename S>
+void BM_ReplaceAll(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    const S text = make_text<S>(n);
+    for (auto _ : state) {
+        state.PauseTiming();
+        S s(text);
+        state.ResumeTiming();
+        replace_all_inplace(s, "ab", "<b>");
+        benchmark::DoNotOptimize(s.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+
+/*
+ * 对 n 条日志记录依次执行 trim、to_lower、replace_all 和 split，
+ * 模拟逐条清洗记录的文本处理流水线
+ * */
+template<typename S>
+void BM_RecordPipeline(benchmark::State &state) {
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    SplitOut<S> fields;
+    for (auto _ : state) {
+        std::size_t total = 0;
+        for (const auto &r : records) {
+            S rec(r);
+            trim_inplace(rec);
+            to_lower_inplace(rec);
+            replace_all_inplace(rec, "/api/v1/", "/v1/");
+            total += split_fields(rec, ',', fields);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// @}  // 批量变换
+
+// @{  // 哈希
+/*
+ * 对比的哈希函数：
+ *   HashBHash   BHash::bytes（wyhash），BString::hash() 使用的实现
+ *   HashCrc32c  BHash::crc32c，支持 SSE4.2 时使用硬件指令
+ *   HashFnv1a   逐字节的 FNV-1a，即 BHash 原来的实现
+ *   HashStd     std::hash<std::string_view>（libstdc++ 中为 MurmurHash2）
+ * */
+struct HashBHash {
+    static std::uint64_t hash(const char *p, std::size_t n) { return BHash::bytes(p, n); }
+};
+
+struct HashCrc32c {
+    static std::uint64_t hash(const char *p, std::size_t n) { return BHash::crc32c(p, n); }
+};
+
+struct HashFnv1a {
+    static std::uint64_t hash(const char *p, std::size_t n) {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (std::size_t i = 0; i < n; i++) {
+            h ^= static_cast<unsigned char>(p[i]);
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+struct HashStd {
+    static std::uint64_t hash(const char *p, std::size_t n) {
+        return std::hash<std::string_view>()(std::string_view(p, n));
+    }
+};
+
+// 计算长度为 n 的字符串的哈希值
+template<typename Method>
+void BM_HashBytes(benchmark::State &state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto text = bench::random_letters(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Method::hash(text.data(), n));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// 调用过 cache_hash() 的 BString，长字符串的 hash() 只读取缓存的值
+static void BM_HashCached(benchmark::State &state) {
+    const std::int64_t n = state.range(0);
+    BString s = make_text<BString>(n);
+    s.cache_hash();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s.hash());
+    }
+    state.SetBytesProcessed(state.iterations() * n);
+}
+// @}  // 哈希
+
+// @{  // 数值的格式化与解析
+/*
+ * 把数值追加到 BString 末尾的几种方式：
+ *   NumBString   BString::append_int / append_double，直接写入字符串的空间
+ *   NumToChars   std::to_chars 写入栈上的缓冲区后追加
+ *   NumSnprintf  snprintf（%lld / %.17g）写入栈上的缓冲区后追加
+ *   NumToString  std::to_string 产生临时字符串后追加，即现有代码的写法
+ * %.17g 和 std::to_string(double) 的结果都不是最短表示，这里只比较速度
+ * */
+struct NumBString {
+    static void append(BString &out, long long v) { out.append_int(v); }
+
+    static void append(BString &out, double v) { out.append_double(v); }
+};
+
+struct NumToChars {
+    static void append(BString &out, long long v) {
+        char buf[32];
+        out.append(BStringView(buf, std::to_chars(buf, buf + sizeof(buf), v).ptr - buf));
+    }
+
+    static void append(BString &out, double v) {
+        char buf[32];
+        out.append(BStringView(buf, std::to_chars(buf, buf + sizeof(buf), v).ptr - buf));
+    }
+};
+
+struct NumSnprintf {
+    static void append(BString &out, long long v) {
+        char buf[32];
+        out.append(BStringView(buf, std::snprintf(buf, sizeof(buf), "%lld", v)));
+    }
+
+    static void append(BString &out, double v) {
+        char buf[32];
+        out.append(BStringView(buf, std::snprintf(buf, sizeof(buf), "%.17g", v)));
+    }
+};
+
+struct NumToString {
+    template<typename T>
+    static void append(BString &out, T v) { out.append(std::to_string(v)); }
+};
+
+/*
+ * 从以','分隔的数值中依次解析出每个数：
+ *   NumBCharConv  BCharConv::parse_int / parse_double
+ *   NumFromChars  std::from_chars
+ *   NumStrto      strtoll / strtod，依赖输入以'\0'结尾
+ * */
+struct NumBCharConv {
+    template<typename T>
+    static const char *parse(const char *first, const char *last, T &v) {
+        if constexpr (std::is_integral<T>::value) {
+            return BCharConv::parse_int(first, last, v).ptr;
+        } else {
+            return BCharConv::parse_double(first, last, v).ptr;
+        }
+    }
+};
+
+struct NumFromChars {
+    template<typename T>
+    static const char *parse(const char *first, const char *last, T &v) {
+        return std::from_chars(first, last, v).ptr;
+    }
+};
+
+struct NumStrto {
+    template<typename T>
+    static const char *parse(const char *first, const char *, T &v) {
+        char *end;
+        if constexpr (std::is_integral<T>::value) {
+            v = std::strtoll(first, &end, 10);
+        } else {
+            v = std::strtod(first, &end);
+        }
+        return end;
+    }
+};
+
+// 生成 n 个数值：整数的位数在 1 ~ 19 之间均匀分布，浮点数为常见的测量值
+template<typename T>
+std::vector<T> make_numbers(std::size_t n) {
+    std::mt19937_64 rng(bench::kSeed);
+    std::vector<T> nums(n);
+    for (auto &v : nums) {
+        if constexpr (std::is_integral<T>::value) {
+            auto x = static_cast<long long>(rng() >> (1 + rng() % 63));
+            v = (rng() & 1) ? -x : x;
+        } else {
+            v = static_cast<double>(rng() % 10000000) / 1000.0 * ((rng() & 1) ? 1 : -1);
+        }
+    }
+    return nums;
+}
+
+// 把 n 个数值以','分隔追加到同一个 BString 中
+template<typename T, typename Method>
+void BM_FormatNumbers(benchmark::State &state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<T> nums = make_numbers<T>(n);
+    BString out;
+    for (auto _ : state) {
+        out.clear();
+        for (T v : nums) {
+            Method::append(out, v);
+            out.push_back(',');
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 依次解析 BM_FormatNumbers 生成的 n 个数值
+template<typename T, typename Method>
+void BM_ParseNumbers(benchmark::State &state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    BString text;
+    for (T v : make_numbers<T>(n)) {
+        NumBString::append(text, v);
+        text.push_back(',');
+    }
+    for (auto _ : state) {
+        const char *p = text.begin();
+        const char *last = text.end();
+        T sum{};
+        while (p < last) {
+            T v{};
+            p = Method::parse(p, last, v) + 1;
+            sum += v;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// @}  // 数值的格式化与解析
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，BString 与 std::string 成对出现以便于对比
+// 字符串的长度从短字符串（SSO）一直覆盖到 1MB
+static void string_sizes(benchmark::internal::Benchmark *b) {
+    bench::size_range(b, 8, 1 << 20);
+}
+
+// 拼接的片段数目
+static void piece_counts(benchmark::internal::Benchmark *b) {
+    bench::size_range(b, 1 << 10, 1 << 16);
+}
+
+// 超大文本的长度
+static void large_text_sizes(benchmark::internal::Benchmark *b) {
+    bench::size_range(b, 1 << 16, 1 << 22);
+}
+
+// 哈希的输入长度，短键部分取得更密
+static void hash_sizes(benchmark::internal::Benchmark *b) {
+    for (std::int64_t n : {4, 8, 16, 24, 32, 64, 128, 256, 1024, 4096, 65536}) b->Arg(n);
+}
+
+// BString 没有提供 insert，因此不参与中间位置插入的测试
+BENCH_PAIR(BM_PushBack, BString, std::string, string_sizes);
+BENCH_PAIR(BM_Append, BString, std::string, string_sizes);
+BENCH_PAIR(BM_Find, BString, std::string, string_sizes);
+BENCH_PAIR(BM_FindHit, BString, std::string, string_sizes);
+BENCH_PAIR(BM_FindLong, BString, std::string, string_sizes);
+BENCH_PAIR(BM_RFind, BString, std::string, string_sizes);
+BENCH_PAIR(BM_FindFirstOf, BString, std::string, string_sizes);
+BENCHMARK(BM_StringSearcherLines)->RangeMultiplier(8)->Range(64, 1 << 14);
+BENCH_PAIR(BM_KeyCorpus, BString, std::string, bench::linear_sizes);
+BENCH_PAIR(BM_SubstrFields, BString, std::string, string_sizes);
+BENCH_PAIR(BM_SliceViewFields, BString, std::string, string_sizes);
+BENCHMARK_TEMPLATE(BM_MapLookupView, std::less<BString>)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_MapLookupView, std::less<>)->Apply(bench::linear_sizes);
+BENCH_PAIR(BM_Equal, BString, std::string, string_sizes);
+BENCH_PAIR(BM_BlobKeyLookup, BString, std::string, bench::linear_sizes);
+BENCH_PAIR(BM_ConcatChain, BString, std::string, bench::linear_sizes);
+BENCH_PAIR(BM_BuildBody, BString, std::string, piece_counts);
+BENCHMARK(BM_BuildBodyBuilder)->Apply(piece_counts);
+BENCH_PAIR(BM_LargeSubstr, BString, std::string, large_text_sizes);
+BENCHMARK(BM_LargeSubstrRope)->Apply(large_text_sizes);
+BENCHMARK_TEMPLATE(BM_DuplicateKeys, BString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_DuplicateKeys, BSharedString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_DuplicateKeys, std::string)->Apply(bench::linear_sizes);
+BENCH_PAIR(BM_Iterate, BString, std::string, string_sizes);
+BENCH_PAIR(BM_EraseMiddle, BString, std::string, bench::quadratic_sizes);
+BENCH_PAIR(BM_Copy, BString, std::string, string_sizes);
+BENCH_PAIR(BM_Move, BString, std::string, string_sizes);
+BENCH_PAIR(BM_ToLower, BString, std::string, string_sizes);
+BENCH_PAIR(BM_ReplaceAll, BString, std::string, string_sizes);
+BENCH_PAIR(BM_RecordPipeline, BString, std::string, bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_HashBytes, HashBHash)->Apply(hash_sizes);
+BENCHMARK_TEMPLATE(BM_HashBytes, HashCrc32c)->Apply(hash_sizes);
+BENCHMARK_TEMPLATE(BM_HashBytes, HashFnv1a)->Apply(hash_sizes);
+BENCHMARK_TEMPLATE(BM_HashBytes, HashStd)->Apply(hash_sizes);
+BENCHMARK(BM_HashCached)->Apply(hash_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, long long, NumBString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, long long, NumToChars)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, long long, NumSnprintf)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, long long, NumToString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, double, NumBString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, double, NumToChars)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, double, NumSnprintf)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_FormatNumbers, double, NumToString)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, long long, NumBCharConv)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, long long, NumFromChars)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, long long, NumStrto)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, double, NumBCharConv)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, double, NumFromChars)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_ParseNumbers, double, NumStrto)->Apply(bench::linear_sizes);
+// @}  // 注册基准测试
@@ -0,0 +1,551 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于红黑树的关联容器（BMap、BSet、BMultiMap、BMultiSet）与对应 std:: 容器的对比基准测试
+//
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "bench_common.h"
+#include "baby_allocator.h"
+#include "baby_map.h"
+#include "baby_set.h"
+#include "baby_multimap.h"
+#include "baby_multiset.h"
+#include "baby_interval_map.h"
+#include "baby_bucket_multimap.h"
+#include "baby_string.h"
+#include "baby_string_interner.h"
+
+// 测量内存占用与查找延迟时使用的元素数目，默认 1000 万
+#ifndef CPPBABYSTL_BENCH_TREE_LARGE
+#define CPPBABYSTL_BENCH_TREE_LARGE 10000000
+#endif
+
+// @{  // 屏蔽不同容器之间接口差异的辅助函数
+namespace {
+
+// 判断容器存储的是`键值对`还是`键`
+template<typename C> struct IsMap : std::false_type {};
+template<typename K, typename V, typename Cmp, typename Alloc, typename Augment>
+struct IsMap<BMap<K, V, Cmp, Alloc, Augment>> : std::true_type {};
+template<typename K, typename V, typename Cmp, typename Alloc, typename Augment>
+struct IsMap<BMultiMap<K, V, Cmp, Alloc, Augment>> : std::true_type {};
+template<typename K, typename V, typename Cmp, typename Alloc>
+struct IsMap<BBucketMultiMap<K, V, Cmp, Alloc>> : std::true_type {};
+template<typename K, typename V, typename Cmp, typename Alloc>
+struct IsMap<std::map<K, V, Cmp, Alloc>> : std::true_type {};
+template<typename K, typename V, typename Cmp, typename Alloc>
+struct IsMap<std::multimap<K, V, Cmp, Alloc>> : std::true_type {};
+
+template<typename C>
+void insert_key(C &c, int key) {
+    if constexpr (IsMap<C>::value) {
+        c.insert(std::pair<int, int>(key, key));
+    } else {
+        c.insert(key);
+    }
+}
+
+// 以 hint 为提示插入
+template<typename C, typename Iter>
+void insert_key_hint(C &c, Iter hint, int key) {
+    if constexpr (IsMap<C>::value) {
+        c.insert(hint, std::pair<int, int>(key, key));
+    } else {
+        c.insert(hint, key);
+    }
+}
+
+// 从迭代器解引用的结果中取出`键`
+inline int key_of(int key) { return key; }
+
+template<typename Pair>
+int key_of(const Pair &p) { return p.first; }
+
+template<typename C>
+C make_filled(const std::vector<int> &keys) {
+    C c;
+    for (int k : keys) insert_key(c, k);
+    return c;
+}
+
+// 删除`键`为奇数的元素：B 系列容器使用 erase_if，std:: 容器在 C++17 中只能沿迭代器逐个删除
+template<typename C>
+void erase_odd(C &c) {
+    c.erase_if([](const auto &elem) { return key_of(elem) % 2 != 0; });
+}
+
+template<typename K, typename V, typename Cmp, typename Alloc>
+void erase_odd(std::map<K, V, Cmp, Alloc> &c) {
+    for (auto it = c.begin(); it != c.end();) {
+        if (it->first % 2 != 0) it = c.erase(it);
+        else ++it;
+    }
+}
+
+/*
+ * 标签类的工作负载：512 个带有长公共前缀的标签（约 40 字节，超过 BString 的
+ * 短字符串容量），以及从中随机抽取的 n 次出现
+ * */
+std::vector<std::string> make_tag_vocabulary() {
+    std::vector<std::string> tags;
+    for (int i = 0; i < 512; i++) {
+        tags.push_back("k8s.pod.label.app.kubernetes.io/" + std::to_string(i * 7919 % 100003));
+    }
+    return tags;
+}
+
+std::vector<std::size_t> make_tag_events(std::int64_t n) {
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::size_t> events(static_cast<std::size_t>(n));
+    for (auto &e : events) e = rng() % 512;
+    return events;
+}
+
+// 1M 与 CPPBABYSTL_BENCH_TREE_LARGE 两种规模，建树很慢，因此固定迭代次数
+void large_sizes(benchmark::internal::Benchmark *b) {
+    b->Arg(1 << 20)->Arg(CPPBABYSTL_BENCH_TREE_LARGE);
+    b->Iterations(3)->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+// @}  // 屏蔽不同容器之间接口差异的辅助函数
+
+
+// @{  // 基准测试的实现
+// 以随机顺序插入 n 个互不相同的键
+template<typename C>
+void BM_Insert(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int k : keys) insert_key(c, k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 按升序插入 n 个键：每次都插入到最右侧的路径上，插入后的调整最频繁
+template<typename C>
+void BM_InsertSorted(benchmark::State &state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int k = 0; k < n; k++) insert_key(c, k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 按升序插入 n 个键，每次都以 end() 为提示
+template<typename C>
+void BM_InsertHint(benchmark::State &state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int k = 0; k < n; k++) insert_key_hint(c, c.end(), k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 从有序的区间构造容器，例如加载按`键`排好序的快照
+template<typename C>
+void BM_BuildSorted(benchmark::State &state) {
+    const auto n = static_cast<int>(state.range(0));
+    const C src = make_filled<C>(bench::shuffled_keys(n));
+    using Elem = std::conditional_t<IsMap<C>::value, std::pair<int, int>, int>;
+    std::vector<Elem> snapshot(src.begin(), src.end());
+    for (auto _ : state) {
+        C c(snapshot.begin(), snapshot.end());
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 用 operator[] 对 n / 4 个不同的键计数，键不存在时插入
+template<typename C>
+void BM_Subscript(benchmark::State &state) {
+    std::vector<int> keys = bench::shuffled_keys(state.range(0));
+    for (int &k : keys) k /= 4;
+    for (auto _ : state) {
+        C c;
+        for (int k : keys) ++c[k];
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序查找 n 个存在的键
+template<typename C>
+void BM_Find(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    C c = make_filled<C>(keys);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int k : keys) hits += (c.find(k) != c.end());
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 统计热点`键`的数目：n 个元素只有 16 个不同的`键`，每个`键`重复 n / 16 次
+template<typename C>
+void BM_CountHot(benchmark::State &state) {
+    std::vector<int> keys = bench::shuffled_keys(state.range(0));
+    for (int &k : keys) k %= 16;
+    const C c = make_filled<C>(keys);
+    for (auto _ : state) {
+        std::size_t total = 0;
+        for (int k = 0; k < 16; k++) total += c.count(k);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+}
+
+// 插入 n 个只有 16 个不同`键`的元素
+template<typename C>
+void BM_InsertHot(benchmark::State &state) {
+    std::vector<int> keys = bench::shuffled_keys(state.range(0));
+    for (int &k : keys) k %= 16;
+    for (auto _ : state) {
+        C c = make_filled<C>(keys);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 逐个删除 16 个热点`键`，每个`键`有 n / 16 个元素
+template<typename C>
+void BM_EraseHot(benchmark::State &state) {
+    std::vector<int> keys = bench::shuffled_keys(state.range(0));
+    for (int &k : keys) k %= 16;
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        for (int k = 0; k < 16; k++) c.erase(k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/*
+ * 大规模容器的内存占用与查找延迟。下一次查找的`键`由本次查找的结果计算
+ * 得到，查找之间不能重叠执行，测得的是单次查找的延迟，主要由沿路径的缓存
+ * 未命中决定。rss_per_entry 为建树前后 RSS 的增量除以元素数目，单独运行
+ * 一个容器（--benchmark_filter）时最准确
+ * */
+template<typename C>
+void BM_FindLatency(benchmark::State &state) {
+    constexpr int kLookups = 1 << 20;
+    const auto n = static_cast<int>(state.range(0));
+
+    bench::trim_heap();
+    const auto rss_before = static_cast<double>(bench::current_rss_bytes());
+    C c = make_filled<C>(bench::shuffled_keys(n));
+    bench::trim_heap();
+    const auto rss_after = static_cast<double>(bench::current_rss_bytes());
+
+    // 步长与 n 互素，连续的查找落在树中相距很远的位置上
+    const int stride = 7368787 % n;
+    int key = 0;
+    for (auto _ : state) {
+        for (int i = 0; i < kLookups; i++) {
+            key = key_of(*c.find(key)) + stride;
+            if (key >= n) key -= n;
+        }
+    }
+    benchmark::DoNotOptimize(key);
+    state.counters["rss_per_entry"] = (rss_after - rss_before) / n;
+    state.counters["latency"] = benchmark::Counter(
+            kLookups, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.SetItemsProcessed(state.iterations() * kLookups);
+}
+
+// 按键的顺序遍历容器中的所有元素
+template<typename C>
+void BM_Iterate(benchmark::State &state) {
+    const C c = make_filled<C>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        long long sum = 0;
+        for (auto &&it : c) sum += key_of(it);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 删除中间一半连续的`键`（例如过期的时间窗口），erase(first, last) 只在定位区间时查找
+template<typename C>
+void BM_EraseRange(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        c.erase(c.lower_bound(n / 4), c.lower_bound(n / 4 + n / 2));
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * (n / 2));
+}
+
+// 按条件删除一半的元素
+template<typename C>
+void BM_EraseIf(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        erase_odd(c);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序逐个删除容器中的所有键
+template<typename C>
+void BM_Erase(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        for (int k : keys) c.erase(k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 拷贝构造一个含有 n 个元素的容器
+template<typename C>
+void BM_Copy(benchmark::State &state) {
+    const C src = make_filled<C>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        C dst(src);
+        benchmark::DoNotOptimize(dst);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 移动构造 + 移动赋值，理想情况下与 n 无关
+template<typename C>
+void BM_Move(benchmark::State &state) {
+    C c = make_filled<C>(bench::shuffled_keys(state.range(0)));
+    for (auto _ : state) {
+        C tmp(std::move(c));
+        c = std::move(tmp);
+        benchmark::DoNotOptimize(c);
+    }
+    if (c.size() != static_cast<std::size_t>(state.range(0))) {
+        state.SkipWithError("container lost elements after move");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * 统计每个标签出现的次数：键为 BString 时每次比较都要比较字符串的公共前缀，
+ * 键为 BInternedStr 时每次比较只是一次整数比较。
+ * key_bytes 为容器中每个键占用的内存（键对象本身 + 堆上的字符），
+ * pool_bytes 为驻留池的总内存
+ * */
+static void BM_TagCountString(benchmark::State &state) {
+    const auto vocab = make_tag_vocabulary();
+    std::vector<BString> events;
+    for (std::size_t e : make_tag_events(state.range(0))) events.emplace_back(vocab[e].c_str());
+    for (auto _ : state) {
+        BMap<BString, int> counts;
+        for (const auto &tag : events) ++counts[tag];
+        benchmark::DoNotOptimize(counts);
+    }
+    std::size_t heap = 0;
+    for (const auto &tag : vocab) heap += tag.size() > 23 ? tag.size() + 1 : 0;
+    state.counters["key_bytes"] = static_cast<double>(sizeof(BString) + heap / vocab.size());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_TagCountInterned(benchmark::State &state) {
+    const auto vocab = make_tag_vocabulary();
+    BStringInterner interner;
+    std::vector<BInternedStr> events;
+    for (std::size_t e : make_tag_events(state.range(0))) events.push_back(interner.intern(vocab[e]));
+    for (auto _ : state) {
+        BMap<BInternedStr, int> counts;
+        for (auto tag : events) ++counts[tag];
+        benchmark::DoNotOptimize(counts);
+    }
+    // 驻留池被所有使用这批键的容器共享，只需要计算一次
+    state.counters["key_bytes"] = static_cast<double>(sizeof(BInternedStr));
+    state.counters["pool_bytes"] = static_cast<double>(interner.memory_usage());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 从原始文本中解析出标签再统计：BString 路径需要构造键，驻留路径需要查一次哈希表
+static void BM_TagIngestString(benchmark::State &state) {
+    const auto vocab = make_tag_vocabulary();
+    const auto events = make_tag_events(state.range(0));
+    for (auto _ : state) {
+        BMap<BString, int> counts;
+        for (std::size_t e : events) ++counts[BString(BStringView(vocab[e]))];
+        benchmark::DoNotOptimize(counts);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_TagIngestInterned(benchmark::State &state) {
+    const auto vocab = make_tag_vocabulary();
+    const auto events = make_tag_events(state.range(0));
+    for (auto _ : state) {
+        BStringInterner interner;
+        BMap<BInternedStr, int> counts;
+        for (std::size_t e : events) ++counts[interner.intern(vocab[e])];
+        benchmark::DoNotOptimize(counts);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// 区间和查询：每次查询覆盖 kRangeWidth 个`键`，聚合增强只需沿两条路径向下查找
+constexpr int kRangeWidth = 1024;
+
+static void BM_RangeSumAggregate(benchmark::State &state) {
+    using C = BMap<int, int, std::less<int>, std::allocator<std::pair<const int, int>>,
+                   RBTreeAggregateAugment<RBTreeSumOp<long long>>>;
+    const int n = static_cast<int>(state.range(0));
+    const C c = make_filled<C>(bench::shuffled_keys(n));
+    std::mt19937 rng(bench::kSeed);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < 1024; i++) {
+            const int lo = static_cast<int>(rng() % n);
+            sum += c.aggregate_range(lo, lo + kRangeWidth - 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+static void BM_RangeSumScan(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const auto c = make_filled<std::map<int, int>>(bench::shuffled_keys(n));
+    std::mt19937 rng(bench::kSeed);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int i = 0; i < 1024; i++) {
+            const int lo = static_cast<int>(rng() % n);
+            const auto end = c.upper_bound(lo + kRangeWidth - 1);
+            for (auto it = c.lower_bound(lo); it != end; ++it) sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+// n 个长度不超过 64 的随机区间，左端点位于 [0, n)
+static std::vector<std::pair<int, int>> make_intervals(int n) {
+    std::mt19937 rng(bench::kSeed);
+    std::vector<std::pair<int, int>> intervals(n);
+    for (auto &[lo, hi] : intervals) {
+        lo = static_cast<int>(rng() % n);
+        hi = lo + static_cast<int>(rng() % 64);
+    }
+    return intervals;
+}
+
+// 点查询：统计包含随机点的区间数目，BIntervalMap 跳过右端点最大值小于该点的子树
+constexpr int kStabQueries = 128;
+
+static void BM_IntervalStab(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    BIntervalMap<int, int> intervals;
+    for (const auto &[lo, hi] : make_intervals(n)) intervals.insert(lo, hi, lo);
+    std::mt19937 rng(bench::kSeed + 1);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int i = 0; i < kStabQueries; i++) hits += intervals.count_stabbing(static_cast<int>(rng() % n));
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * kStabQueries);
+}
+
+static void BM_IntervalStabScan(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const auto intervals = make_intervals(n);
+    std::mt19937 rng(bench::kSeed + 1);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int i = 0; i < kStabQueries; i++) {
+            const int point = static_cast<int>(rng() % n);
+            for (const auto &[lo, hi] : intervals) hits += (lo <= point && point <= hi);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * kStabQueries);
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，B 系列容器与 std:: 容器成对出现以便于对比
+// 模板实参中的逗号会被宏拆开，因此先定义别名
+using BMapInt = BMap<int, int>;
+using StdMapInt = std::map<int, int>;
+using BMultiMapInt = BMultiMap<int, int>;
+using BMapPoolInt = BMap<int, int, std::less<int>, BPoolAllocator<std::pair<const int, int>>>;
+using StdMultiMapInt = std::multimap<int, int>;
+using BBucketMultiMapInt = BBucketMultiMap<int, int>;
+using BMapSizeInt = BMap<int, int, std::less<int>, std::allocator<std::pair<const int, int>>, RBTreeSizeAugment>;
+using BMultiMapSizeInt =
+        BMultiMap<int, int, std::less<int>, std::allocator<std::pair<const int, int>>, RBTreeSizeAugment>;
+
+#define TREE_BENCH(func)                                                        \
+    BENCH_PAIR(func, BMapInt, StdMapInt, bench::linear_sizes);                  \
+    BENCH_PAIR(func, BSet<int>, std::set<int>, bench::linear_sizes);            \
+    BENCH_PAIR(func, BMultiMapInt, StdMultiMapInt, bench::linear_sizes);        \
+    BENCH_PAIR(func, BMultiSet<int>, std::multiset<int>, bench::linear_sizes)
+
+TREE_BENCH(BM_Insert);
+TREE_BENCH(BM_InsertSorted);
+TREE_BENCH(BM_InsertHint);
+TREE_BENCH(BM_BuildSorted);
+TREE_BENCH(BM_Find);
+TREE_BENCH(BM_Iterate);
+TREE_BENCH(BM_Erase);
+TREE_BENCH(BM_Copy);
+TREE_BENCH(BM_Move);
+BENCH_PAIR(BM_Subscript, BMapInt, StdMapInt, bench::linear_sizes);
+BENCH_PAIR(BM_EraseRange, BMapInt, StdMapInt, bench::linear_sizes);
+BENCH_PAIR(BM_EraseIf, BMapInt, StdMapInt, bench::linear_sizes);
+
+// 维护子树大小的开销，以及由此带来的 O(log n) count
+BENCHMARK_TEMPLATE(BM_Insert, BMapSizeInt)->Apply(bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_Erase, BMapSizeInt)->Apply(bench::linear_sizes);
+BENCH_PAIR(BM_CountHot, BMultiMapInt, StdMultiMapInt, bench::linear_sizes);
+BENCHMARK_TEMPLATE(BM_CountHot, BMultiMapSizeInt)->Apply(bench::linear_sizes);
+
+// 大量重复`键`：逐元素建立节点与每个不同`键`一个桶的对比
+#define HOT_BENCH(func)                                                         \
+    BENCH_PAIR(func, BMultiMapInt, StdMultiMapInt, bench::linear_sizes);        \
+    BENCHMARK_TEMPLATE(func, BBucketMultiMapInt)->Apply(bench::linear_sizes)
+
+HOT_BENCH(BM_InsertHot);
+HOT_BENCH(BM_EraseHot);
+BENCHMARK_TEMPLATE(BM_CountHot, BBucketMultiMapInt)->Apply(bench::linear_sizes);
+
+// 子树聚合：区间和与区间点查询
+BENCHMARK(BM_RangeSumAggregate)->Apply(bench::linear_sizes);
+BENCHMARK(BM_RangeSumScan)->Apply(bench::linear_sizes);
+BENCHMARK(BM_IntervalStab)->Apply(bench::linear_sizes);
+BENCHMARK(BM_IntervalStabScan)->Apply(bench::linear_sizes);
+
+// 节点从 BNodePool 按大小分级的 chunk 中切分，相邻分配的节点在内存中也相邻
+BENCHMARK_TEMPLATE(BM_FindLatency, BMapInt)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_FindLatency, StdMapInt)->Apply(large_sizes);
+BENCHMARK_TEMPLATE(BM_FindLatency, BMapPoolInt)->Apply(large_sizes);
+
+BENCHMARK(BM_TagCountString)->Apply(bench::linear_sizes);
+BENCHMARK(BM_TagCountInterned)->Apply(bench::linear_sizes);
+BENCHMARK(BM_TagIngestString)->Apply(bench::linear_sizes);
+BENCHMARK(BM_TagIngestInterned)->Apply(bench::linear_sizes);
+// @}  // 注册基准测试
@@ -0,0 +1,136 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 哈希容器 BUnorderedMap 与 BMap、std::unordered_map 的对比基准测试
+//
+
+#include <map>
+#include <unordered_map>
+
+#include "bench_common.h"
+#include "baby_map.h"
+#include "baby_unordered_map.h"
+
+// 元素数目的上限，默认 16M。内存充足的机器上可以通过 -D 放大，例如 1 亿个元素：
+// -DCPPBABYSTL_BENCH_HASH_MAX=134217728
+#ifndef CPPBABYSTL_BENCH_HASH_MAX
+#define CPPBABYSTL_BENCH_HASH_MAX (1 << 24)
+#endif
+
+
+// @{  // 辅助函数
+namespace {
+
+// 从 1K 到 CPPBABYSTL_BENCH_HASH_MAX，规模越大越能体现缓存未命中的代价
+void hash_sizes(benchmark::internal::Benchmark *b) {
+    bench::size_range(b, 1 << 10, CPPBABYSTL_BENCH_HASH_MAX);
+    b->Unit(benchmark::kMillisecond);
+}
+
+/*
+ * 查找使用与插入不同的随机顺序：std::unordered_map 的节点按插入顺序分配，
+ * 按插入顺序查找时节点在内存中是顺序访问的，不能反映真实的随机访问
+ * */
+std::vector<int> lookup_order(std::vector<int> keys) {
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(bench::kSeed + 1));
+    return keys;
+}
+
+template<typename C>
+C make_filled(const std::vector<int> &keys) {
+    C c;
+    for (int k : keys) c.insert(std::pair<int, int>(k, k));
+    return c;
+}
+
+}  // namespace
+// @}  // 辅助函数
+
+
+// @{  // 基准测试的实现
+// 以随机顺序插入 n 个互不相同的键，包含所有扩容的开销
+template<typename C>
+void BM_HashInsert(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        C c;
+        for (int k : keys) c.insert(std::pair<int, int>(k, k));
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序查找 n 个存在的键
+template<typename C>
+void BM_HashFindHit(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const C c = make_filled<C>(keys);
+    const auto order = lookup_order(keys);
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int k : order) hits += (c.find(k) != c.end());
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 查找 n 个不存在的键，哈希表需要探测到含有空槽的组才能确定不存在
+template<typename C>
+void BM_HashFindMiss(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    const C c = make_filled<C>(keys);
+    const auto order = lookup_order(keys);
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::size_t hits = 0;
+        for (int k : order) hits += (c.find(k + n) != c.end());
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 以随机顺序逐个删除容器中的所有键
+template<typename C>
+void BM_HashErase(benchmark::State &state) {
+    const auto keys = bench::shuffled_keys(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        C c = make_filled<C>(keys);
+        state.ResumeTiming();
+        for (int k : keys) c.erase(k);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 词频统计式的更新：operator[] 命中已有的键后自增，键的数目为 n / 8
+template<typename C>
+void BM_HashCounter(benchmark::State &state) {
+    std::vector<int> keys = bench::shuffled_keys(state.range(0));
+    for (int &k : keys) k /= 8;
+    for (auto _ : state) {
+        C c;
+        for (int k : keys) ++c[k];
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// @}  // 基准测试的实现
+
+
+// @{  // 注册基准测试，每个测试依次运行 BUnorderedMap、BMap 和 std::unordered_map
+using BUnorderedMapInt = BUnorderedMap<int, int>;
+using BMapInt = BMap<int, int>;
+using StdUnorderedMapInt = std::unordered_map<int, int>;
+
+#define HASH_BENCH(func)                                                        \
+    BENCHMARK_TEMPLATE(func, BUnorderedMapInt)->Apply(hash_sizes);              \
+    BENCHMARK_TEMPLATE(func, BMapInt)->Apply(hash_sizes);                       \
+    BENCHMARK_TEMPLATE(func, StdUnorderedMapInt)->Apply(hash_sizes)
+
+HASH_BENCH(BM_HashInsert);
+HASH_BENCH(BM_HashFindHit);
+HASH_BENCH(BM_HashFindMiss);
+HASH_BENCH(BM_HashErase);
+HASH_BENCH(BM_HashCounter);
+// @}  // 注册基准测试
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+对比 cppBabySTL_bench 输出的 JSON 结果（Google Benchmark 格式）
+
+两种用法：
+  1. 对比两次构建的结果，发现性能回退：
+       compare.py base.json new.json [--threshold 0.10]
+     当任意基准测试的耗时增长超过阈值时，返回码为 1
+  2. 在一次运行结果中，对比 B 系列容器与对应的 std:: 容器：
+       compare.py --pairs run.json
+
+生成 JSON 的方式：
+  cppBabySTL_bench --benchmark_out=run.json --benchmark_out_format=json
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_runs(path):
+    """读取 JSON 文件，返回每个基准测试的原始记录，多次重复时只保留均值"""
+    with open(path) as f:
+        data = json.load(f)
+
+    runs = []
+    for bm in data.get("benchmarks", []):
+        if bm.get("run_type") == "aggregate" and bm.get("aggregate_name") != "mean":
+            continue
+        if bm.get("error_occurred"):
+            continue
+        runs.append(bm)
+    return runs
+
+
+def cpu_ns(bm):
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    return bm["cpu_time"] * scale[bm.get("time_unit", "ns")]
+
+
+def load(path):
+    """返回 {基准测试名: cpu_time(ns)}"""
+    return {bm.get("run_name", bm["name"]): cpu_ns(bm) for bm in load_runs(path)}
+
+
+def fmt_time(ns):
+    for unit, factor in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= factor:
+            return "%.3f %s" % (ns / factor, unit)
+    return "%.1f ns" % ns
+
+
+def compare_runs(base_path, new_path, threshold):
+    base, new = load(base_path), load(new_path)
+    common = [name for name in base if name in new]
+    if not common:
+        print("no common benchmarks between the two files")
+        return 1
+
+    width = max(len(name) for name in common)
+    print("%-*s %14s %14s %9s" % (width, "Benchmark", "Base", "New", "Change"))
+
+    regressions = []
+    for name in common:
+        change = new[name] / base[name] - 1.0
+        mark = ""
+        if change > threshold:
+            mark = "  <-- regression"
+            regressions.append(name)
+        print("%-*s %14s %14s %+8.1f%%%s" % (
+            width, name, fmt_time(base[name]), fmt_time(new[name]), change * 100, mark))
+
+    print()
+    print("%d benchmarks compared, %d regressed by more than %.0f%%"
+          % (len(common), len(regressions), threshold * 100))
+    return 1 if regressions else 0
+
+
+def compare_pairs(path):
+    # BENCH_PAIR 总是先注册 B 系列容器，紧接着注册对应的 std:: 容器，因此二者的
+    # family_index 相邻，且同一组参数的 per_family_instance_index 相同
+    runs = load_runs(path)
+    index = {(bm["family_index"], bm["per_family_instance_index"]): bm for bm in runs}
+
+    rows = []
+    for bm in runs:
+        key = (bm["family_index"] + 1, bm["per_family_instance_index"])
+        other = index.get(key)
+        if "<B" not in bm["name"] or other is None or "<B" in other["name"]:
+            continue
+        rows.append((bm["name"], cpu_ns(bm), cpu_ns(other)))
+
+    if not rows:
+        print("no B/std pairs found")
+        return 1
+
+    width = max(len(r[0]) for r in rows)
+    print("%-*s %14s %14s %8s" % (width, "Benchmark", "B*", "std::", "B/std"))
+    for name, b_time, std_time in rows:
+        print("%-*s %14s %14s %7.2fx" % (
+            width, name, fmt_time(b_time), fmt_time(std_time), b_time / std_time))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+", help="JSON files produced by cppBabySTL_bench")
+    parser.add_argument("--pairs", action="store_true",
+                        help="compare B containers with std:: containers in one run")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown treated as a regression (default: 0.10)")
+    args = parser.parse_args()
+
+    if args.pairs:
+        if len(args.files) != 1:
+            parser.error("--pairs expects exactly one file")
+        return compare_pairs(args.files[0])
+
+    if len(args.files) != 2:
+        parser.error("expects two files: base.json new.json")
+    return compare_runs(args.files[0], args.files[1], args.threshold)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,959 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// B+ 树，BBTreeMap 与 BBTreeSet 的底层实现
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include "baby_type_traits.h"
+
+#ifndef CPPBABYSTL_B_TREE_H
+#define CPPBABYSTL_B_TREE_H
+
+// 支持 SSE2 时，32 位整数`键`的节点内查找每次比较 8 个`键`，否则使用二分查找
+#if defined(__SSE2__)
+#define CPPBABYSTL_BTREE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/*
+ * 节点中`键`的数目：使一个节点的`键`数组约为 256 字节（4 个缓存行），
+ * 并限制在 16 ~ 64 之间
+ * */
+template<typename K>
+inline constexpr std::size_t b_btree_node_slots_v = sizeof(K) <= 4 ? 64 : sizeof(K) <= 8 ? 32 : 16;
+
+/*
+ * @brief 是否可以用 SIMD 指令在节点内查找
+ *
+ * 只处理`键`为 32 位整数、比较器为 std::less 的情况，此时`键`的大小
+ * 关系就是整数的大小关系，一条比较指令可以同时比较 4 个`键`
+ * */
+template<typename K, typename Compare, typename KeyArg>
+inline constexpr bool b_btree_simd_search_v =
+        std::is_integral_v<K> && !std::is_same_v<K, bool> && sizeof(K) == 4 &&
+        std::is_same_v<KeyArg, K> &&
+        (std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>);
+
+// 叶节点中的`值`数组，BBTreeSet 的叶节点不存放`值`
+template<typename V, std::size_t N>
+struct BTreeValueArray {
+    alignas(V) unsigned char buf[N * sizeof(V)];
+
+    V *data() { return reinterpret_cast<V *>(buf); }
+};
+
+template<std::size_t N>
+struct BTreeValueArray<void, N> {};
+
+// 迭代器解引用的结果：map 为`键值对`的引用，set 为`键`的引用
+template<typename K, typename V>
+struct BTreeReturn {
+    using type = std::pair<const K &, V &>;
+};
+
+template<typename K>
+struct BTreeReturn<K, void> {
+    using type = const K &;
+};
+
+/*
+ * B+ 树
+ *
+ *   1. 节点：每个节点最多存放 kSlots（16 ~ 64）个有序的`键`。所有元素都
+ *      存放在叶节点中，叶节点之间用双向链表相连，范围扫描和遍历只需要顺序
+ *      访问叶节点；内部节点只存放用于导航的分隔键，分隔键 keys[i] 满足：
+ *      children[i] 中的`键` < keys[i] <= children[i + 1] 中的`键`
+ *   2. 查找：从根节点向下，每层在一个节点内查找，树高约为 log_32(n)。
+ *      32 位整数的`键`使用 SIMD 比较统计小于 key 的`键`的数目，其余类型
+ *      使用二分查找
+ *   3. 插入：叶节点满时分裂为两个，分隔键插入父节点，父节点满时继续向上
+ *      分裂。在最后一个叶节点的末尾插入（如按升序插入）时，原节点保持满，
+ *      新节点只放入新元素，顺序插入得到的叶节点几乎都是满的
+ *   4. 删除：节点中的`键`少于约 kSlots / 2 时，先尝试从相邻的兄弟节点借一个，
+ *      兄弟节点也不够时与之合并。删除不更新分隔键，分隔键可能不再是任何
+ *      元素的`键`，但仍然满足上面的大小关系
+ *
+ * 元素存放在节点的数组中，插入和删除会移动同一个节点中的其他元素，因此任何
+ * 插入和删除都会使迭代器以及元素的引用失效。K 和 V 的移动构造不应抛出异常
+ *
+ * @tparam K `键`的类型
+ * @tparam V `值`的类型，为 void 时只存放`键`
+ * @tparam Compare 可调用对象，用于 K 类型之间的比较
+ * @tparam Alloc 分配器，B+ 树会将其 rebind 到节点类型后用于分配节点
+ * */
+template<typename K, typename V,
+        typename Compare = std::less<K>,
+        typename Alloc = std::allocator<K>>
+class BTree {
+public:
+    using SizeType = std::size_t;
+    using ReturnType = typename BTreeReturn<K, V>::type;
+    struct Iterator;
+
+    static constexpr bool kHasValue = !std::is_void_v<V>;
+    static constexpr SizeType kSlots = b_btree_node_slots_v<K>;
+    static constexpr SizeType kMinSlots = kSlots / 2;  // 非根叶节点中元素的最少数目
+    // 非根内部节点中`键`的最少数目：满节点分裂时有一个`键`上移，较少的一半只有 kSlots / 2 - 1 个
+    static constexpr SizeType kMinInnerSlots = kSlots / 2 - 1;
+
+private:
+    struct Inner;
+
+    // 叶节点和内部节点的公共部分，keys() 中只有前 count 个`键`已经构造
+    struct Node {
+        Inner *parent = nullptr;
+        std::uint16_t position = 0;  // 在父节点 children 中的下标
+        std::uint16_t count = 0;     // `键`的数目
+        bool leaf;
+        alignas(K) unsigned char key_buf[kSlots * sizeof(K)];
+
+        explicit Node(bool is_leaf) : leaf(is_leaf) {}
+
+        K *keys() { return reinterpret_cast<K *>(key_buf); }
+        const K *keys() const { return reinterpret_cast<const K *>(key_buf); }
+    };
+
+    struct Leaf : Node {
+        Leaf *prev = nullptr;
+        Leaf *next = nullptr;
+        BTreeValueArray<V, kSlots> vals;
+
+        Leaf() : Node(true) {}
+    };
+
+    struct Inner : Node {
+        Node *children[kSlots + 1];
+
+        Inner() : Node(false) {}
+    };
+
+    using LeafAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<Leaf>;
+    using LeafAllocTraits = std::allocator_traits<LeafAllocType>;
+    using InnerAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<Inner>;
+    using InnerAllocTraits = std::allocator_traits<InnerAllocType>;
+
+    Node *root_{};     // 根节点，空树时为 nullptr
+    Leaf *first_{};    // 第一个叶节点
+    Leaf *last_{};     // 最后一个叶节点
+    SizeType size_{};  // 元素的数目
+    Compare cmp_;
+    LeafAllocType alloc_;  // 分配叶节点所用的分配器，分配内部节点时临时 rebind
+
+    // @{  // 节点的创建与销毁
+    Leaf *new_leaf_() {
+        Leaf *leaf = LeafAllocTraits::allocate(alloc_, 1);
+        LeafAllocTraits::construct(alloc_, leaf);
+        return leaf;
+    }
+
+    Inner *new_inner_() {
+        InnerAllocType inner_alloc(alloc_);
+        Inner *inner = InnerAllocTraits::allocate(inner_alloc, 1);
+        InnerAllocTraits::construct(inner_alloc, inner);
+        return inner;
+    }
+
+    // 析构节点中的所有`键`（和`值`）并释放节点，不处理子节点
+    void free_node_(Node *node) {
+        std::destroy_n(node->keys(), node->count);
+        if (node->leaf) {
+            auto leaf = static_cast<Leaf *>(node);
+            if constexpr (kHasValue) std::destroy_n(leaf->vals.data(), leaf->count);
+            LeafAllocTraits::destroy(alloc_, leaf);
+            LeafAllocTraits::deallocate(alloc_, leaf, 1);
+        } else {
+            auto inner = static_cast<Inner *>(node);
+            InnerAllocType inner_alloc(alloc_);
+            InnerAllocTraits::destroy(inner_alloc, inner);
+            InnerAllocTraits::deallocate(inner_alloc, inner, 1);
+        }
+    }
+
+    // 释放以 node 为根的子树，树高只有 log_32(n)，递归深度很小
+    void free_subtree_(Node *node) {
+        if (!node->leaf) {
+            auto inner = static_cast<Inner *>(node);
+            for (SizeType i = 0; i <= inner->count; i++) free_subtree_(inner->children[i]);
+        }
+        free_node_(node);
+    }
+    // @}  // 节点的创建与销毁
+
+    /*
+     * @brief 把 [src, src + n) 中的对象搬迁到 dst 开始的未构造内存中，两段内存可以重叠
+     *
+     * 搬迁后 src 中不再有存活的对象。可以按字节搬迁的类型直接 memmove，
+     * 否则逐个移动构造并析构原对象，按照不会覆盖尚未搬迁的对象的方向进行
+     * */
+    template<typename T>
+    static void relocate_(T *dst, T *src, SizeType n) {
+        if (n == 0 || dst == src) return;
+        if constexpr (b_is_trivially_relocatable_v<T>) {
+            std::memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+        } else if (dst < src) {
+            for (SizeType i = 0; i < n; i++) {
+                ::new (static_cast<void *>(dst + i)) T(std::move(src[i]));
+                src[i].~T();
+            }
+        } else {
+            for (SizeType i = n; i > 0; i--) {
+                ::new (static_cast<void *>(dst + i - 1)) T(std::move(src[i - 1]));
+                src[i - 1].~T();
+            }
+        }
+    }
+
+    // 把叶节点 src 中从 from 开始的 n 个元素搬迁到叶节点 dst 中从 to 开始的位置
+    static void relocate_elems_(Leaf *dst, SizeType to, Leaf *src, SizeType from, SizeType n) {
+        relocate_(dst->keys() + to, src->keys() + from, n);
+        if constexpr (kHasValue) relocate_(dst->vals.data() + to, src->vals.data() + from, n);
+    }
+
+    // 令 child 成为 parent 的第 i 个孩子
+    static void set_child_(Inner *parent, SizeType i, Node *child) {
+        parent->children[i] = child;
+        child->parent = parent;
+        child->position = static_cast<std::uint16_t>(i);
+    }
+
+    // 把内部节点 src 的 children[from, from + n) 移动到 dst 的 children[to, to + n)
+    static void move_children_(Inner *dst, SizeType to, Inner *src, SizeType from, SizeType n) {
+        if (dst == src && to > from) {
+            for (SizeType i = n; i > 0; i--) set_child_(dst, to + i - 1, src->children[from + i - 1]);
+        } else {
+            for (SizeType i = 0; i < n; i++) set_child_(dst, to + i, src->children[from + i]);
+        }
+    }
+
+    // @{  // 节点内的查找
+#ifdef CPPBABYSTL_BTREE_SSE2
+    /*
+     * 统计有序数组 keys[0, n) 中 < key（or_equal 为 true 时为 <= key）的`键`的数目。
+     * 每次比较 8 个`键`，数组是有序的，某一组中出现不满足条件的`键`后即可停止
+     * */
+    template<bool or_equal>
+    static SizeType simd_count_(const K *keys, SizeType n, K key) {
+        // 无符号整数翻转最高位后按有符号整数比较，大小关系不变
+        constexpr std::uint32_t kBias = std::is_signed_v<K> ? 0u : 0x80000000u;
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(kBias));
+        const __m128i target = _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(key) ^ kBias));
+        auto match = [&](const K *p) {
+            __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)), bias);
+            // keys[i] <= key 等价于 !(keys[i] > key)
+            return or_equal ? _mm_andnot_si128(_mm_cmpgt_epi32(v, target), _mm_set1_epi32(-1))
+                            : _mm_cmplt_epi32(v, target);
+        };
+
+        SizeType i = 0;
+        for (; i + 8 <= n; i += 8) {
+            // 两组 32 位的比较结果压缩为 8 个 16 位的掩码，每个`键`对应 2 位
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi32(match(keys + i), match(keys + i + 4))));
+            if (mask != 0xFFFFu) return i + static_cast<SizeType>(__builtin_popcount(mask)) / 2;
+        }
+        for (; i < n; i++) {
+            if (or_equal ? key < keys[i] : !(keys[i] < key)) break;
+        }
+        return i;
+    }
+#endif
+
+    // 第一个 >= key 的`键`的下标
+    template<typename KeyArg>
+    SizeType lower_index_(const Node *node, const KeyArg &key) const {
+        const K *keys = node->keys();
+#ifdef CPPBABYSTL_BTREE_SSE2
+        if constexpr (b_btree_simd_search_v<K, Compare, KeyArg>) {
+            return simd_count_<false>(keys, node->count, key);
+        }
+#endif
+        SizeType lo = 0, len = node->count;
+        while (len > 0) {
+            SizeType half = len / 2;
+            if (cmp_(keys[lo + half], key)) {
+                lo += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        return lo;
+    }
+
+    // 第一个 > key 的`键`的下标
+    template<typename KeyArg>
+    SizeType upper_index_(const Node *node, const KeyArg &key) const {
+        const K *keys = node->keys();
+#ifdef CPPBABYSTL_BTREE_SSE2
+        if constexpr (b_btree_simd_search_v<K, Compare, KeyArg>) {
+            return simd_count_<true>(keys, node->count, key);
+        }
+#endif
+        SizeType lo = 0, len = node->count;
+        while (len > 0) {
+            SizeType half = len / 2;
+            if (!cmp_(key, keys[lo + half])) {
+                lo += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        return lo;
+    }
+
+    // 从根节点向下找到 key 所在的叶节点：在每个内部节点中进入第一个 > key 的分隔键左侧的孩子
+    template<typename KeyArg>
+    Leaf *find_leaf_(const KeyArg &key) const {
+        Node *node = root_;
+        while (!node->leaf) {
+            auto inner = static_cast<Inner *>(node);
+            node = inner->children[upper_index_(inner, key)];
+        }
+        return static_cast<Leaf *>(node);
+    }
+    // @}  // 节点内的查找
+
+    // 叶节点中下标为 idx 的位置越过了节点末尾时，转到下一个叶节点的开头
+    static Iterator normalize_(Leaf *leaf, SizeType idx) {
+        if (idx == leaf->count && leaf->next != nullptr) return Iterator(leaf->next, 0);
+        return Iterator(leaf, idx);
+    }
+
+    // 在叶节点 leaf 的 idx 处构造新元素，调用前 leaf 必须有空位
+    template<typename KeyArg, typename ...Args>
+    void construct_at_(Leaf *leaf, SizeType idx, KeyArg &&key, Args &&... args);
+
+    // 在叶节点 leaf 的 idx 处插入新元素，叶节点已满时分裂，返回指向新元素的迭代器
+    template<typename KeyArg, typename ...Args>
+    Iterator insert_at_(Leaf *leaf, SizeType idx, KeyArg &&key, Args &&... args);
+
+    // 把叶节点 right 链接到叶节点 leaf 之后
+    void link_after_(Leaf *leaf, Leaf *right) {
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr) {
+            leaf->next->prev = right;
+        } else {
+            last_ = right;
+        }
+        leaf->next = right;
+    }
+
+    // 在未满的内部节点 node 中插入 keys[pos] = sep 和 children[pos + 1] = right
+    void insert_into_inner_(Inner *node, SizeType pos, K &&sep, Node *right) {
+        K *keys = node->keys();
+        SizeType n = node->count;
+        relocate_(keys + pos + 1, keys + pos, n - pos);
+        ::new (static_cast<void *>(keys + pos)) K(std::move(sep));
+        move_children_(node, pos + 2, node, pos + 1, n - pos);
+        set_child_(node, pos + 1, right);
+        node->count++;
+    }
+
+    /*
+     * 节点 left 分裂出了右侧的 right，把分隔键 sep 和 right 插入父节点。
+     * 父节点满时继续向上分裂，递归深度不超过树高
+     * */
+    void insert_into_parent_(Node *left, K &&sep, Node *right);
+
+    // 删除叶节点 leaf 中下标为 idx 的元素
+    void erase_at_(Leaf *leaf, SizeType idx);
+
+    // 删除内部节点 node 中的 keys[i] 和 children[i + 1]
+    void remove_from_inner_(Inner *node, SizeType i);
+
+    // 叶节点 leaf 中的元素过少时，向兄弟节点借一个元素或与之合并
+    void rebalance_leaf_(Leaf *leaf);
+
+    // 内部节点 node 中的`键`过少时，向兄弟节点借一个`键`或与之合并，必要时继续向上调整
+    void rebalance_inner_(Inner *node);
+
+    // 根节点为只有一个孩子的内部节点时，以这个孩子为新的根节点
+    void shrink_root_();
+
+    // 复制 other 中的所有元素，元素按顺序追加到最后一个叶节点中，时间复杂度为 O(n)
+    void copy_from_(const BTree &other);
+
+    // 接管 other 的所有节点，other 变为空树
+    void steal_(BTree &other) noexcept {
+        root_ = other.root_;
+        first_ = other.first_;
+        last_ = other.last_;
+        size_ = other.size_;
+        other.root_ = nullptr;
+        other.first_ = other.last_ = nullptr;
+        other.size_ = 0;
+    }
+
+public:
+    BTree() = default;
+
+    // 创建一个使用分配器 alloc 的空树
+    explicit BTree(const Alloc &alloc) : alloc_(alloc) {}
+
+    // 拷贝构造函数
+    BTree(const BTree &other)
+            : cmp_(other.cmp_),
+              alloc_(LeafAllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        copy_from_(other);
+    }
+
+    // 移动构造函数
+    BTree(BTree &&other) noexcept
+            : cmp_(other.cmp_), alloc_(other.alloc_) {
+        steal_(other);
+    }
+
+    BTree &operator=(const BTree &other);
+
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的所有节点；
+     * 否则只能将元素逐个移动到由当前分配器创建的节点中
+     * */
+    BTree &operator=(BTree &&other) noexcept(
+            LeafAllocTraits::propagate_on_container_move_assignment::value ||
+            LeafAllocTraits::is_always_equal::value);
+
+    ~BTree() { this->clear(); }
+
+    // 返回 B+ 树所使用的分配器
+    Alloc get_allocator() const { return Alloc(alloc_); }
+
+    // 交换两棵 B+ 树的内容，不移动任何元素
+    void swap(BTree &other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(first_, other.first_);
+        std::swap(last_, other.last_);
+        std::swap(size_, other.size_);
+        std::swap(cmp_, other.cmp_);
+        if constexpr (LeafAllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+    }
+
+    SizeType size() const noexcept { return size_; }
+
+    // 返回 B+ 树使用的比较器
+    Compare key_comp() const { return cmp_; }
+
+
+// @{  // 插入与删除
+public:
+
+    /*
+     * @brief 查找`键`为 key 的元素，不存在时用 key 和 args 构造一个新元素
+     * @return 元素的迭代器，以及是否插入了新元素。已经存在时 args 不会被使用
+     *
+     * key 大于所有已有的`键`时直接追加到最后一个叶节点中，不需要从根节点向下查找
+     * */
+    template<typename KeyArg, typename ...Args>
+    std::pair<Iterator, bool> try_emplace(KeyArg &&key, Args &&... args);
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    template<typename KeyArg>
+    SizeType erase(const KeyArg &key) {
+        if (root_ == nullptr) return 0;
+
+        Leaf *leaf = find_leaf_(key);
+        SizeType idx = lower_index_(leaf, key);
+        if (idx == leaf->count || cmp_(key, leaf->keys()[idx])) return 0;
+        erase_at_(leaf, idx);
+        return 1;
+    }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器
+    Iterator erase(Iterator pos) {
+        // 删除可能引起节点的合并，先记下被删除的`键`，删除后重新定位
+        K key(pos.leaf->keys()[pos.idx]);
+        erase_at_(pos.leaf, pos.idx);
+        return this->lower_bound(key);
+    }
+
+    // 删除所有元素并释放所有节点
+    void clear() noexcept {
+        if (root_ != nullptr) free_subtree_(root_);
+        root_ = nullptr;
+        first_ = last_ = nullptr;
+        size_ = 0;
+    }
+// @}  // 插入与删除
+
+
+// @{  // 查找与迭代器
+public:
+
+    template<typename KeyArg>
+    Iterator find(const KeyArg &key) const {
+        if (root_ == nullptr) return this->end();
+
+        Leaf *leaf = find_leaf_(key);
+        SizeType idx = lower_index_(leaf, key);
+        if (idx == leaf->count || cmp_(key, leaf->keys()[idx])) return this->end();
+        return Iterator(leaf, idx);
+    }
+
+    template<typename KeyArg>
+    bool contains(const KeyArg &key) const {
+        return this->find(key) != this->end();
+    }
+
+    // 返回指向第一个 >= key 的元素的迭代器
+    template<typename KeyArg>
+    Iterator lower_bound(const KeyArg &key) const {
+        if (root_ == nullptr) return this->end();
+
+        Leaf *leaf = find_leaf_(key);
+        return normalize_(leaf, lower_index_(leaf, key));
+    }
+
+    // 返回指向第一个 > key 的元素的迭代器
+    template<typename KeyArg>
+    Iterator upper_bound(const KeyArg &key) const {
+        if (root_ == nullptr) return this->end();
+
+        Leaf *leaf = find_leaf_(key);
+        return normalize_(leaf, upper_index_(leaf, key));
+    }
+
+    Iterator begin() const { return Iterator(first_, 0); }
+
+    // 尾后迭代器指向最后一个叶节点的末尾，空树时为 (nullptr, 0)
+    Iterator end() const { return Iterator(last_, last_ == nullptr ? 0 : last_->count); }
+// @}  // 查找与迭代器
+};
+
+/*
+ * B+ 树的迭代器，由叶节点和叶节点中的下标组成，按`键`的升序遍历
+ * */
+template<typename K, typename V, typename Compare, typename Alloc>
+struct BTree<K, V, Compare, Alloc>::Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<ReturnType>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ReturnType;
+
+    Leaf *leaf;
+    SizeType idx;
+
+    explicit Iterator(Leaf *l, SizeType i) : leaf(l), idx(i) {}
+
+    ReturnType operator*() const {
+        if constexpr (kHasValue) {
+            return {leaf->keys()[idx], leaf->vals.data()[idx]};
+        } else {
+            return leaf->keys()[idx];
+        }
+    }
+
+    Iterator &operator++() {
+        // 最后一个叶节点的末尾即为 end()，不再前进
+        if (++idx == leaf->count && leaf->next != nullptr) {
+            leaf = leaf->next;
+            idx = 0;
+        }
+        return *this;
+    }
+
+    Iterator operator++(int) {
+        Iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    Iterator &operator--() {
+        if (idx == 0) {
+            leaf = leaf->prev;
+            idx = leaf->count;
+        }
+        --idx;
+        return *this;
+    }
+
+    Iterator operator--(int) {
+        Iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+        return leaf == other.leaf && idx == other.idx;
+    }
+
+    bool operator!=(const Iterator &other) const {
+        return !(*this == other);
+    }
+};
+
+template<typename K, typename V, typename Compare, typename Alloc>
+template<typename KeyArg, typename ...Args>
+void BTree<K, V, Compare, Alloc>::construct_at_(Leaf *leaf, SizeType idx, KeyArg &&key, Args &&... args) {
+    // 先在末尾的空位上构造，构造失败时节点保持不变，成功后再移动到 idx 处
+    K *keys = leaf->keys();
+    SizeType n = leaf->count;
+    ::new (static_cast<void *>(keys + n)) K(std::forward<KeyArg>(key));
+    if constexpr (kHasValue) {
+        V *vals = leaf->vals.data();
+        try {
+            ::new (static_cast<void *>(vals + n)) V(std::forward<Args>(args)...);
+        } catch (...) {
+            keys[n].~K();
+            throw;
+        }
+        if (idx != n) {
+            alignas(V) unsigned char tmp[sizeof(V)];
+            relocate_(reinterpret_cast<V *>(tmp), vals + n, 1);
+            relocate_(vals + idx + 1, vals + idx, n - idx);
+            relocate_(vals + idx, reinterpret_cast<V *>(tmp), 1);
+        }
+    }
+    if (idx != n) {
+        alignas(K) unsigned char tmp[sizeof(K)];
+        relocate_(reinterpret_cast<K *>(tmp), keys + n, 1);
+        relocate_(keys + idx + 1, keys + idx, n - idx);
+        relocate_(keys + idx, reinterpret_cast<K *>(tmp), 1);
+    }
+    leaf->count++;
+    size_++;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+template<typename KeyArg, typename ...Args>
+typename BTree<K, V, Compare, Alloc>::Iterator
+BTree<K, V, Compare, Alloc>::insert_at_(Leaf *leaf, SizeType idx, KeyArg &&key, Args &&... args) {
+    if (leaf->count < kSlots) {
+        construct_at_(leaf, idx, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+        return Iterator(leaf, idx);
+    }
+
+    Leaf *right = new_leaf_();
+    if (idx == kSlots && leaf == last_) {
+        // 在最后一个叶节点的末尾插入：原节点保持满，新元素单独放入新的叶节点。
+        // 新节点链接到树中之前构造元素，构造失败时树保持不变
+        try {
+            construct_at_(right, 0, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+        } catch (...) {
+            free_node_(right);
+            throw;
+        }
+        link_after_(leaf, right);
+        insert_into_parent_(leaf, K(right->keys()[0]), right);
+        return Iterator(right, 0);
+    }
+
+    // 叶节点已满，两边各分一半后再插入。新元素恰好位于中间时放在左侧，
+    // 以保证它小于作为分隔键的右侧第一个`键`
+    SizeType mid = kSlots / 2;
+    relocate_elems_(right, 0, leaf, mid, kSlots - mid);
+    right->count = static_cast<std::uint16_t>(kSlots - mid);
+    leaf->count = static_cast<std::uint16_t>(mid);
+    link_after_(leaf, right);
+    insert_into_parent_(leaf, K(right->keys()[0]), right);
+
+    Iterator res = idx <= mid ? Iterator(leaf, idx) : Iterator(right, idx - mid);
+    construct_at_(res.leaf, res.idx, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    return res;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::insert_into_parent_(Node *left, K &&sep, Node *right) {
+    Inner *parent = left->parent;
+    if (parent == nullptr) {
+        // left 是根节点，树长高一层
+        Inner *root = new_inner_();
+        ::new (static_cast<void *>(root->keys())) K(std::move(sep));
+        root->count = 1;
+        set_child_(root, 0, left);
+        set_child_(root, 1, right);
+        root_ = root;
+        return;
+    }
+
+    // 分隔键插入到 keys[pos]，right 成为 children[pos + 1]
+    SizeType pos = left->position;
+    if (parent->count < kSlots) {
+        insert_into_inner_(parent, pos, std::move(sep), right);
+        return;
+    }
+
+    // 父节点已满：keys[mid] 上移，右侧的`键`和孩子移动到新节点中，
+    // 分隔键插入到它所在的一半后，再把上移的`键`插入祖父节点
+    SizeType mid = kSlots / 2;
+    Inner *split = new_inner_();
+    K *keys = parent->keys();
+    relocate_(split->keys(), keys + mid + 1, kSlots - mid - 1);
+    move_children_(split, 0, parent, mid + 1, kSlots - mid);
+    split->count = static_cast<std::uint16_t>(kSlots - mid - 1);
+    K up_key(std::move(keys[mid]));
+    keys[mid].~K();
+    parent->count = static_cast<std::uint16_t>(mid);
+
+    if (pos <= mid) {
+        insert_into_inner_(parent, pos, std::move(sep), right);
+    } else {
+        insert_into_inner_(split, pos - mid - 1, std::move(sep), right);
+    }
+    insert_into_parent_(parent, std::move(up_key), split);
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+template<typename KeyArg, typename ...Args>
+std::pair<typename BTree<K, V, Compare, Alloc>::Iterator, bool>
+BTree<K, V, Compare, Alloc>::try_emplace(KeyArg &&key, Args &&... args) {
+    if (root_ == nullptr) {
+        Leaf *leaf = new_leaf_();
+        root_ = first_ = last_ = leaf;
+        try {
+            construct_at_(leaf, 0, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+        } catch (...) {
+            free_node_(leaf);
+            root_ = first_ = last_ = nullptr;
+            throw;
+        }
+        return {Iterator(leaf, 0), true};
+    }
+
+    // 比所有的`键`都大时追加到最后一个叶节点的末尾
+    if (cmp_(last_->keys()[last_->count - 1], key)) {
+        return {insert_at_(last_, last_->count, std::forward<KeyArg>(key), std::forward<Args>(args)...), true};
+    }
+
+    Leaf *leaf = find_leaf_(key);
+    SizeType idx = lower_index_(leaf, key);
+    if (idx < leaf->count && !cmp_(key, leaf->keys()[idx])) return {Iterator(leaf, idx), false};
+    return {insert_at_(leaf, idx, std::forward<KeyArg>(key), std::forward<Args>(args)...), true};
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::erase_at_(Leaf *leaf, SizeType idx) {
+    K *keys = leaf->keys();
+    SizeType n = leaf->count;
+    keys[idx].~K();
+    relocate_(keys + idx, keys + idx + 1, n - idx - 1);
+    if constexpr (kHasValue) {
+        V *vals = leaf->vals.data();
+        vals[idx].~V();
+        relocate_(vals + idx, vals + idx + 1, n - idx - 1);
+    }
+    leaf->count--;
+    size_--;
+
+    if (leaf == root_) {
+        if (leaf->count == 0) this->clear();
+        return;
+    }
+    if (leaf->count < kMinSlots) rebalance_leaf_(leaf);
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::remove_from_inner_(Inner *node, SizeType i) {
+    K *keys = node->keys();
+    SizeType n = node->count;
+    keys[i].~K();
+    relocate_(keys + i, keys + i + 1, n - i - 1);
+    move_children_(node, i + 1, node, i + 2, n - i - 1);
+    node->count--;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::rebalance_leaf_(Leaf *leaf) {
+    Inner *parent = leaf->parent;
+    SizeType pos = leaf->position;
+    Leaf *left = pos > 0 ? static_cast<Leaf *>(parent->children[pos - 1]) : nullptr;
+    Leaf *right = pos < parent->count ? static_cast<Leaf *>(parent->children[pos + 1]) : nullptr;
+
+    if (left != nullptr && left->count > kMinSlots) {
+        // 左兄弟的最后一个元素移到 leaf 的开头，分隔键更新为 leaf 新的第一个`键`
+        relocate_elems_(leaf, 1, leaf, 0, leaf->count);
+        relocate_elems_(leaf, 0, left, left->count - 1, 1);
+        left->count--;
+        leaf->count++;
+        parent->keys()[pos - 1] = leaf->keys()[0];
+        return;
+    }
+    if (right != nullptr && right->count > kMinSlots) {
+        // 右兄弟的第一个元素移到 leaf 的末尾，分隔键更新为右兄弟新的第一个`键`
+        relocate_elems_(leaf, leaf->count, right, 0, 1);
+        relocate_elems_(right, 0, right, 1, right->count - 1);
+        right->count--;
+        leaf->count++;
+        parent->keys()[pos] = right->keys()[0];
+        return;
+    }
+
+    // 兄弟节点的元素也不多，合并后不超过 kSlots 个元素：右侧的节点并入左侧
+    if (left == nullptr) {
+        left = leaf;
+        pos++;
+    } else {
+        right = leaf;
+    }
+    relocate_elems_(left, left->count, right, 0, right->count);
+    left->count = static_cast<std::uint16_t>(left->count + right->count);
+    right->count = 0;
+    left->next = right->next;
+    if (right->next != nullptr) {
+        right->next->prev = left;
+    } else {
+        last_ = left;
+    }
+    free_node_(right);
+    remove_from_inner_(parent, pos - 1);
+
+    if (parent == root_) {
+        shrink_root_();
+    } else if (parent->count < kMinInnerSlots) {
+        rebalance_inner_(parent);
+    }
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::rebalance_inner_(Inner *node) {
+    while (node != root_ && node->count < kMinInnerSlots) {
+        Inner *parent = node->parent;
+        SizeType pos = node->position;
+        Inner *left = pos > 0 ? static_cast<Inner *>(parent->children[pos - 1]) : nullptr;
+        Inner *right = pos < parent->count ? static_cast<Inner *>(parent->children[pos + 1]) : nullptr;
+        K *keys = node->keys();
+        K *seps = parent->keys();
+
+        if (left != nullptr && left->count > kMinInnerSlots) {
+            // 右旋：父节点的分隔键下移到 node 的开头，左兄弟的最后一个`键`上移
+            SizeType ln = left->count;
+            relocate_(keys + 1, keys, node->count);
+            move_children_(node, 1, node, 0, node->count + 1);
+            ::new (static_cast<void *>(keys)) K(std::move(seps[pos - 1]));
+            set_child_(node, 0, left->children[ln]);
+            seps[pos - 1] = std::move(left->keys()[ln - 1]);
+            left->keys()[ln - 1].~K();
+            left->count--;
+            node->count++;
+            return;
+        }
+        if (right != nullptr && right->count > kMinInnerSlots) {
+            // 左旋：父节点的分隔键下移到 node 的末尾，右兄弟的第一个`键`上移
+            SizeType n = node->count, rn = right->count;
+            ::new (static_cast<void *>(keys + n)) K(std::move(seps[pos]));
+            set_child_(node, n + 1, right->children[0]);
+            seps[pos] = std::move(right->keys()[0]);
+            right->keys()[0].~K();
+            relocate_(right->keys(), right->keys() + 1, rn - 1);
+            move_children_(right, 0, right, 1, rn);
+            right->count--;
+            node->count++;
+            return;
+        }
+
+        // 合并：右侧的节点连同父节点中的分隔键一起并入左侧的节点
+        if (left == nullptr) {
+            left = node;
+            pos++;
+        } else {
+            right = node;
+        }
+        SizeType ln = left->count, rn = right->count;
+        ::new (static_cast<void *>(left->keys() + ln)) K(std::move(seps[pos - 1]));
+        relocate_(left->keys() + ln + 1, right->keys(), rn);
+        move_children_(left, ln + 1, right, 0, rn + 1);
+        left->count = static_cast<std::uint16_t>(ln + 1 + rn);
+        right->count = 0;
+        free_node_(right);
+        remove_from_inner_(parent, pos - 1);
+
+        node = parent;
+    }
+    if (node == root_) shrink_root_();
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::shrink_root_() {
+    if (root_->leaf || root_->count > 0) return;
+
+    auto old_root = static_cast<Inner *>(root_);
+    root_ = old_root->children[0];
+    root_->parent = nullptr;
+    root_->position = 0;
+    free_node_(old_root);
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+void BTree<K, V, Compare, Alloc>::copy_from_(const BTree &other) {
+    try {
+        for (Leaf *leaf = other.first_; leaf != nullptr; leaf = leaf->next) {
+            for (SizeType i = 0; i < leaf->count; i++) {
+                if constexpr (kHasValue) {
+                    if (root_ == nullptr) {
+                        this->try_emplace(leaf->keys()[i], leaf->vals.data()[i]);
+                    } else {
+                        insert_at_(last_, last_->count, leaf->keys()[i], leaf->vals.data()[i]);
+                    }
+                } else {
+                    if (root_ == nullptr) {
+                        this->try_emplace(leaf->keys()[i]);
+                    } else {
+                        insert_at_(last_, last_->count, leaf->keys()[i]);
+                    }
+                }
+            }
+        }
+    } catch (...) {
+        this->clear();
+        throw;
+    }
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+BTree<K, V, Compare, Alloc> &BTree<K, V, Compare, Alloc>::operator=(const BTree &other) {
+    if (this == &other) return *this;
+
+    this->clear();
+    cmp_ = other.cmp_;
+    if constexpr (LeafAllocTraits::propagate_on_container_copy_assignment::value) {
+        alloc_ = other.alloc_;
+    }
+    copy_from_(other);
+    return *this;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+BTree<K, V, Compare, Alloc> &BTree<K, V, Compare, Alloc>::operator=(BTree &&other) noexcept(
+        LeafAllocTraits::propagate_on_container_move_assignment::value ||
+        LeafAllocTraits::is_always_equal::value) {
+    if (this == &other) return *this;
+
+    this->clear();
+    cmp_ = other.cmp_;
+    if constexpr (LeafAllocTraits::propagate_on_container_move_assignment::value) {
+        alloc_ = other.alloc_;
+    } else {
+        if (alloc_ != other.alloc_) {
+            // other 的节点只能由 other 的分配器释放，因此逐个移动元素
+            for (Leaf *leaf = other.first_; leaf != nullptr; leaf = leaf->next) {
+                for (SizeType i = 0; i < leaf->count; i++) {
+                    if constexpr (kHasValue) {
+                        this->try_emplace(std::move(leaf->keys()[i]), std::move(leaf->vals.data()[i]));
+                    } else {
+                        this->try_emplace(std::move(leaf->keys()[i]));
+                    }
+                }
+            }
+            other.clear();
+            return *this;
+        }
+    }
+    steal_(other);
+    return *this;
+}
+
+#endif //CPPBABYSTL_B_TREE_H
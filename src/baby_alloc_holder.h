@@ -0,0 +1,53 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 容器保存分配器所用的基类，空分配器不占用空间
+//
+
+#include <type_traits>
+#include <utility>
+
+#ifndef CPPBABYSTL_BABY_ALLOC_HOLDER_H
+#define CPPBABYSTL_BABY_ALLOC_HOLDER_H
+
+/*
+ * @brief 保存分配器的基类，容器通过 alloc_() 访问其中的分配器
+ *
+ * std::allocator 等无状态的分配器是空类，作为普通成员仍要占用至少一个字节，
+ * 再加上对齐后会让容器多出 8 个字节。容器以 BAllocHolder 为私有基类时，
+ * 空的分配器通过空基类优化（EBO）不占用任何空间；有状态的分配器
+ * （如 BArenaAllocator）以及 final 类不能作为基类，仍作为成员保存
+ * */
+template<typename Alloc, bool = std::is_empty_v<Alloc> && !std::is_final_v<Alloc>>
+class BAllocHolder {
+private:
+    Alloc alloc_value_;
+
+public:
+    BAllocHolder() = default;
+
+    explicit BAllocHolder(const Alloc &alloc) : alloc_value_(alloc) {}
+
+    explicit BAllocHolder(Alloc &&alloc) noexcept : alloc_value_(std::move(alloc)) {}
+
+    Alloc &alloc_() noexcept { return alloc_value_; }
+
+    const Alloc &alloc_() const noexcept { return alloc_value_; }
+};
+
+// 空的分配器：以其为基类，不占用空间
+template<typename Alloc>
+class BAllocHolder<Alloc, true> : private Alloc {
+public:
+    BAllocHolder() = default;
+
+    explicit BAllocHolder(const Alloc &alloc) : Alloc(alloc) {}
+
+    explicit BAllocHolder(Alloc &&alloc) noexcept : Alloc(std::move(alloc)) {}
+
+    Alloc &alloc_() noexcept { return *this; }
+
+    const Alloc &alloc_() const noexcept { return *this; }
+};
+
+#endif //CPPBABYSTL_BABY_ALLOC_HOLDER_H
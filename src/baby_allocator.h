@@ -0,0 +1,343 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 两种可以替换 std::allocator 的分配器：
+//   1. BArena + BArenaAllocator：单调（monotonic）分配器，只分配不回收，
+//      在 BArena 析构或调用 release() 时一次性归还所有内存
+//   2. BNodePool + BPoolAllocator：按大小分级的节点池，适用于 BList、
+//      BForwardList、BMap 等每次只申请一个节点的容器
+//
+// 两者都不是线程安全的，适合“一个请求 / 一个线程一份”的使用方式
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+#ifndef CPPBABYSTL_BABY_ALLOCATOR_H
+#define CPPBABYSTL_BABY_ALLOCATOR_H
+
+/*
+ * 单调内存池
+ *
+ * 从上游（::operator new）申请一块块连续的内存（block），分配时只移动
+ * 当前 block 中的指针（bump pointer）；单次释放是空操作，所有内存在
+ * release() 或析构时一起归还。block 的大小按 2 倍增长，超过当前 block
+ * 大小的请求单独申请一个 block
+ * */
+class BArena {
+public:
+    using SizeType = std::size_t;
+
+private:
+    // 每个 block 的头部，所有 block 组成一个单链表
+    struct Block {
+        Block *next;
+        SizeType size;  // 整个 block（含头部）的字节数
+    };
+
+    Block *blocks_{};           // 最近申请的 block
+    char *cur_{};               // 当前 block 中下一次分配的起始位置
+    char *end_{};               // 当前 block 的结束位置
+    SizeType next_block_size_;  // 下一次向上游申请的 block 大小
+    SizeType bytes_used_{};     // 已经分配出去的字节数（不含对齐浪费）
+
+    enum : SizeType {
+        kDefaultBlockSize = 4096,
+        kMaxBlockSize = SizeType(1) << 20
+    };
+
+    // 向上游申请一个至少能容纳 bytes 个字节（按 align 对齐）的 block
+    void new_block_(SizeType bytes, SizeType align) {
+        SizeType need = sizeof(Block) + bytes + align;
+        SizeType size = std::max(next_block_size_, need);
+
+        auto block = static_cast<Block *>(::operator new(size));
+        block->next = blocks_;
+        block->size = size;
+        blocks_ = block;
+
+        cur_ = reinterpret_cast<char *>(block + 1);
+        end_ = reinterpret_cast<char *>(block) + size;
+        next_block_size_ = std::min(next_block_size_ * 2, SizeType(kMaxBlockSize));
+    }
+
+public:
+
+    explicit BArena(SizeType init_block_size = kDefaultBlockSize)
+            : next_block_size_(std::max(init_block_size, SizeType(64))) {}
+
+    BArena(const BArena &) = delete;
+    BArena &operator=(const BArena &) = delete;
+
+    ~BArena() { release(); }
+
+    /*
+     * @brief 分配 bytes 个字节，返回的地址按 align 对齐
+     * @param bytes 需要分配的字节数
+     * @param align 对齐要求，必须是 2 的幂
+     * */
+    void *allocate(SizeType bytes, SizeType align = alignof(std::max_align_t)) {
+        auto addr = reinterpret_cast<std::uintptr_t>(cur_);
+        auto aligned = (addr + align - 1) & ~std::uintptr_t(align - 1);
+        if (cur_ == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+            new_block_(bytes, align);
+            addr = reinterpret_cast<std::uintptr_t>(cur_);
+            aligned = (addr + align - 1) & ~std::uintptr_t(align - 1);
+        }
+
+        cur_ = reinterpret_cast<char *>(aligned + bytes);
+        bytes_used_ += bytes;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // 单次释放是空操作，内存在 release() 时统一归还
+    void deallocate(void *, SizeType) noexcept {}
+
+    /*
+     * @brief 归还所有 block，之前分配出去的内存全部失效
+     *
+     * 调用者需要保证此时已经没有容器在使用这个 BArena 中的内存
+     * */
+    void release() noexcept {
+        while (blocks_ != nullptr) {
+            Block *next = blocks_->next;
+            ::operator delete(blocks_);
+            blocks_ = next;
+        }
+        cur_ = end_ = nullptr;
+        bytes_used_ = 0;
+    }
+
+    // 已经分配出去的字节数
+    SizeType bytes_used() const noexcept { return bytes_used_; }
+
+    // 向上游申请的字节数
+    SizeType bytes_reserved() const noexcept {
+        SizeType total = 0;
+        for (Block *b = blocks_; b != nullptr; b = b->next) total += b->size;
+        return total;
+    }
+};
+
+
+/*
+ * 按大小分级的节点池
+ *
+ * 将 [1, kMaxPooledSize] 字节的请求按 kGranularity 向上取整，分成若干个
+ * 大小等级，每个等级维护一个空闲链表；空闲链表为空时，一次性向上游申请
+ * 一个 chunk 并切分成多个节点。超过 kMaxPooledSize 或对齐要求超过
+ * kGranularity 的请求直接交给 ::operator new
+ * */
+class BNodePool {
+public:
+    using SizeType = std::size_t;
+
+    enum : SizeType {
+        kGranularity = 16,     // 大小等级之间的间隔，同时也是节点的对齐
+        kMaxPooledSize = 256,  // 能够放入节点池的最大节点
+        kChunkSize = 16384     // 每次向上游申请的 chunk 大小
+    };
+
+private:
+    static constexpr SizeType kNumClasses = kMaxPooledSize / kGranularity;
+
+    // 空闲节点，直接复用节点本身的内存
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    // 向上游申请的 chunk，所有 chunk 组成一个单链表
+    struct alignas(kGranularity) Chunk {
+        Chunk *next;
+    };
+
+    FreeNode *free_lists_[kNumClasses]{};
+    Chunk *chunks_{};
+
+    static SizeType class_index_(SizeType bytes) {
+        return (std::max(bytes, SizeType(1)) - 1) / kGranularity;
+    }
+
+    static bool pooled_(SizeType bytes, SizeType align) {
+        return bytes <= kMaxPooledSize && align <= kGranularity;
+    }
+
+    // 为第 idx 个大小等级申请一个新的 chunk，并切分后放入空闲链表
+    void refill_(SizeType idx) {
+        SizeType node_size = (idx + 1) * kGranularity;
+        auto chunk = static_cast<Chunk *>(::operator new(kChunkSize));
+        chunk->next = chunks_;
+        chunks_ = chunk;
+
+        char *beg = reinterpret_cast<char *>(chunk) + sizeof(Chunk);
+        char *end = reinterpret_cast<char *>(chunk) + kChunkSize;
+        for (char *p = beg; p + node_size <= end; p += node_size) {
+            auto node = reinterpret_cast<FreeNode *>(p);
+            node->next = free_lists_[idx];
+            free_lists_[idx] = node;
+        }
+    }
+
+public:
+
+    BNodePool() = default;
+
+    BNodePool(const BNodePool &) = delete;
+    BNodePool &operator=(const BNodePool &) = delete;
+
+    ~BNodePool() { release(); }
+
+    void *allocate(SizeType bytes, SizeType align = alignof(std::max_align_t)) {
+        if (!pooled_(bytes, align)) {
+            return ::operator new(bytes, std::align_val_t(align));
+        }
+
+        SizeType idx = class_index_(bytes);
+        if (free_lists_[idx] == nullptr) refill_(idx);
+
+        FreeNode *node = free_lists_[idx];
+        free_lists_[idx] = node->next;
+        return node;
+    }
+
+    // bytes 和 align 必须与分配时传入的值相同
+    void deallocate(void *ptr, SizeType bytes,
+                    SizeType align = alignof(std::max_align_t)) noexcept {
+        if (ptr == nullptr) return;
+        if (!pooled_(bytes, align)) {
+            ::operator delete(ptr, std::align_val_t(align));
+            return;
+        }
+
+        auto node = static_cast<FreeNode *>(ptr);
+        SizeType idx = class_index_(bytes);
+        node->next = free_lists_[idx];
+        free_lists_[idx] = node;
+    }
+
+    /*
+     * @brief 归还所有 chunk，之前分配出去的节点全部失效
+     *
+     * 超过 kMaxPooledSize 的大块内存不受节点池管理，不会被释放
+     * */
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            Chunk *next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+        std::fill(free_lists_, free_lists_ + kNumClasses, nullptr);
+    }
+
+    // 每个线程默认使用的节点池，避免多线程下争用同一个空闲链表
+    static BNodePool &thread_default() {
+        static thread_local BNodePool pool;
+        return pool;
+    }
+};
+
+
+/*
+ * 从 BArena 中分配内存的分配器
+ *
+ * 分配器本身只保存一个指向 BArena 的指针，复制的代价很低；两个分配器
+ * 当且仅当使用同一个 BArena 时相等
+ * */
+template<typename Tp>
+class BArenaAllocator {
+public:
+    using value_type = Tp;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+private:
+    BArena *arena_;
+
+    template<typename U>
+    friend class BArenaAllocator;
+
+public:
+
+    explicit BArenaAllocator(BArena &arena) noexcept : arena_(&arena) {}
+
+    template<typename U>
+    BArenaAllocator(const BArenaAllocator<U> &other) noexcept
+            : arena_(other.arena_) {}
+
+    Tp *allocate(std::size_t n) {
+        return static_cast<Tp *>(arena_->allocate(n * sizeof(Tp), alignof(Tp)));
+    }
+
+    void deallocate(Tp *ptr, std::size_t n) noexcept {
+        arena_->deallocate(ptr, n * sizeof(Tp));
+    }
+
+    BArena *arena() const noexcept { return arena_; }
+
+    template<typename U>
+    bool operator==(const BArenaAllocator<U> &other) const noexcept {
+        return arena_ == other.arena_;
+    }
+
+    template<typename U>
+    bool operator!=(const BArenaAllocator<U> &other) const noexcept {
+        return arena_ != other.arena_;
+    }
+};
+
+
+/*
+ * 从 BNodePool 中分配内存的分配器
+ *
+ * 默认构造时使用当前线程的节点池 BNodePool::thread_default()，因此
+ * 由默认构造的分配器创建的容器不能跨线程释放元素
+ * */
+template<typename Tp>
+class BPoolAllocator {
+public:
+    using value_type = Tp;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+private:
+    BNodePool *pool_;
+
+    template<typename U>
+    friend class BPoolAllocator;
+
+public:
+
+    BPoolAllocator() noexcept : pool_(&BNodePool::thread_default()) {}
+
+    explicit BPoolAllocator(BNodePool &pool) noexcept : pool_(&pool) {}
+
+    template<typename U>
+    BPoolAllocator(const BPoolAllocator<U> &other) noexcept
+            : pool_(other.pool_) {}
+
+    Tp *allocate(std::size_t n) {
+        return static_cast<Tp *>(pool_->allocate(n * sizeof(Tp), alignof(Tp)));
+    }
+
+    void deallocate(Tp *ptr, std::size_t n) noexcept {
+        pool_->deallocate(ptr, n * sizeof(Tp), alignof(Tp));
+    }
+
+    BNodePool *pool() const noexcept { return pool_; }
+
+    template<typename U>
+    bool operator==(const BPoolAllocator<U> &other) const noexcept {
+        return pool_ == other.pool_;
+    }
+
+    template<typename U>
+    bool operator!=(const BPoolAllocator<U> &other) const noexcept {
+        return pool_ != other.pool_;
+    }
+};
+
+#endif //CPPBABYSTL_BABY_ALLOCATOR_H
@@ -0,0 +1,325 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于 B+ 树的有序关联容器 BBTreeMap
+//
+
+#include <stdexcept>
+#include "b_tree.h"
+
+#ifndef CPPBABYSTL_BABY_BTREE_MAP_H
+#define CPPBABYSTL_BABY_BTREE_MAP_H
+
+/*
+ * 有序的`键值对`容器，接口与 BMap 相同
+ *
+ * 元素按`键`的顺序存放在 B+ 树的叶节点数组中，每个节点存放 16 ~ 64 个元素。
+ * 与每个元素一个节点的红黑树相比，查找时访问的缓存行更少，范围扫描只需要
+ * 顺序读取叶节点，每个元素也不需要额外的指针。代价是插入和删除会移动同一
+ * 节点中的其他元素，因此任何插入和删除都会使迭代器以及元素的引用失效
+ *
+ * 与 std::map 相同，insert / emplace 遇到已经存在的`键`时不会修改原来的
+ * `值`，需要覆盖时使用 insert_or_assign 或 operator[]
+ * */
+template<typename K, typename V,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<std::pair<const K, V>>>
+class BBTreeMap {
+public:
+    using TreeType = BTree<K, V, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TreeType tree_;
+
+    // Compare 声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Compare, KeyArg>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    // 默认构造函数
+    BBTreeMap() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BBTreeMap(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：元素按顺序追加到新的叶节点中，时间复杂度为 O(n)
+    BBTreeMap(const BBTreeMap &other) = default;
+
+    // 移动构造函数
+    BBTreeMap(BBTreeMap &&other) noexcept = default;
+
+    // 通过初始化列表进行构造
+    BBTreeMap(std::initializer_list<std::pair<K, V>> init_list) {
+        this->insert(init_list);
+    }
+
+    template<typename InputIter>
+    BBTreeMap(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BBTreeMap() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{ 与赋值运算相关的操作
+public:
+
+    BBTreeMap &operator=(const BBTreeMap &other) = default;
+
+    BBTreeMap &operator=(BBTreeMap &&other) noexcept = default;
+
+    // 将一个初始化列表赋值给当前容器
+    BBTreeMap &operator=(std::initializer_list<std::pair<K, V>> init_list) {
+        tree_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @} // 与赋值运算相关的操作
+
+
+// @{ // 元素访问相关的操作
+public:
+
+    V &at(const K &key) {
+        auto iter = tree_.find(key);
+        if (iter == tree_.end()) {
+            throw std::out_of_range("BBTreeMap::at");
+        }
+        return (*iter).second;
+    }
+
+    const V &at(const K &key) const {
+        return const_cast<BBTreeMap *>(this)->at(key);
+    }
+
+    // `键`不存在时插入一个`值`被值初始化的元素
+    V &operator[](const K &key) {
+        return (*tree_.try_emplace(key).first).second;
+    }
+
+    V &operator[](K &&key) {
+        return (*tree_.try_emplace(std::move(key)).first).second;
+    }
+// @} // 元素访问相关的操作
+
+
+// @{  // 迭代器，按`键`的升序遍历，同一叶节点中的元素在内存中连续存放
+public:
+
+    Iterator begin() { return tree_.begin(); }
+    Iterator begin() const { return tree_.begin(); }
+    Iterator end() { return tree_.end(); }
+    Iterator end() const { return tree_.end(); }
+// @}  // 迭代器，按`键`的升序遍历，同一叶节点中的元素在内存中连续存放
+
+
+// @{  // 容量相关的操作
+public:
+
+    // 检查容器是否为空
+    bool empty() const noexcept {
+        return tree_.size() == 0;
+    }
+
+    // 返回容器的元素数目
+    SizeType size() const noexcept {
+        return tree_.size();
+    }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+
+    // 返回容器使用的比较器
+    Compare key_comp() const { return tree_.key_comp(); }
+// @}  // 容量相关的操作
+
+
+// @{  // 向容器中添加元素相关的操作
+public:
+
+    std::pair<Iterator, bool>
+    insert(const std::pair<K, V> &value) {
+        return tree_.try_emplace(value.first, value.second);
+    }
+
+    std::pair<Iterator, bool>
+    insert(std::pair<K, V> &&value) {
+        return tree_.try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    // 按升序插入的区间不需要查找，每个元素直接追加到最后一个叶节点中
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        while (beg != end) {
+            auto &[k, v] = *beg;
+            tree_.try_emplace(k, v);
+            ++beg;
+        }
+    }
+
+    void insert(std::initializer_list<std::pair<K, V>> init_list) {
+        for (const auto &[k, v] : init_list) {
+            tree_.try_emplace(k, v);
+        }
+    }
+
+    // `键`不存在时插入，存在时用 val 覆盖原来的`值`
+    template<typename ValArg>
+    std::pair<Iterator, bool>
+    insert_or_assign(const K &key, ValArg &&val) {
+        auto res = tree_.try_emplace(key, std::forward<ValArg>(val));
+        if (!res.second) (*res.first).second = std::forward<ValArg>(val);
+        return res;
+    }
+
+    // args 被转发给`值`的构造函数，`键`已经存在时不构造任何对象
+    template<typename ...Args>
+    std::pair<Iterator, bool>
+    emplace(const K &key, Args &&...args) {
+        return tree_.try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template<typename ...Args>
+    std::pair<Iterator, bool>
+    emplace(K &&key, Args &&...args) {
+        return tree_.try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+// @}  // 向容器中添加元素相关的操作
+
+
+// @{  // 在容器中删除元素相关的操作
+public:
+
+    // 删除所有元素并释放所有节点
+    void clear() noexcept {
+        tree_.clear();
+    }
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    SizeType erase(const K &key) { return tree_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器全部失效
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return tree_.erase(key); }
+
+    void swap(BBTreeMap &other) noexcept {
+        tree_.swap(other.tree_);
+    }
+// @}  // 在容器中删除元素相关的操作
+
+
+// @{  // 与查找相关的操作
+public:
+
+    // 返回键为`key`的元素数，非 0 即 1
+    SizeType count(const K &key) const {
+        return tree_.contains(key);
+    }
+
+    bool contains(const K &key) const {
+        return tree_.contains(key);
+    }
+
+    // 返回指向键为`key`的迭代器，若不存在键为`key`的元素，返回 end()
+    Iterator find(const K &key) {
+        return tree_.find(key);
+    }
+
+    Iterator find(const K &key) const {
+        return tree_.find(key);
+    }
+
+    // 返回指向首个不小于（>=）`key`的元素的迭代器
+    Iterator lower_bound(const K &key) {
+        return tree_.lower_bound(key);
+    }
+
+    Iterator lower_bound(const K &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    // 返回指向首个大于`key`的元素的迭代器
+    Iterator upper_bound(const K &key) {
+        return tree_.upper_bound(key);
+    }
+
+    Iterator upper_bound(const K &key) const {
+        return tree_.upper_bound(key);
+    }
+
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找，而不必先构造一个临时的 K
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return tree_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    bool contains(const KeyArg &key) const {
+        return tree_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator lower_bound(const KeyArg &key) {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator upper_bound(const KeyArg &key) {
+        return tree_.upper_bound(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const {
+        return tree_.upper_bound(key);
+    }
+// @}  // 与查找相关的操作
+};
+
+// 判断两个 BBTreeMap 容器是否相等：两者按顺序逐个比较`键值对`
+template<typename K, typename V, typename Compare, typename Alloc>
+bool operator==(const BBTreeMap<K, V, Compare, Alloc> &x,
+                const BBTreeMap<K, V, Compare, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    auto beg1 = x.begin();
+    auto beg2 = y.begin();
+    while (beg1 != x.end()) {
+        if (!((*beg1).first == (*beg2).first) || !((*beg1).second == (*beg2).second)) return false;
+        ++beg1;
+        ++beg2;
+    }
+    return true;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+bool operator!=(const BBTreeMap<K, V, Compare, Alloc> &x,
+                const BBTreeMap<K, V, Compare, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_BTREE_MAP_H
@@ -0,0 +1,244 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于 B+ 树的有序集合 BBTreeSet
+//
+
+#include "b_tree.h"
+
+#ifndef CPPBABYSTL_BABY_BTREE_SET_H
+#define CPPBABYSTL_BABY_BTREE_SET_H
+
+/*
+ * 有序集合，接口与 BSet 相同
+ *
+ * `键`按顺序存放在 B+ 树的叶节点数组中，叶节点不存放`值`。任何插入和删除
+ * 都可能使迭代器以及元素的引用失效
+ * */
+template<typename K,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<K>>
+class BBTreeSet {
+public:
+    using TreeType = BTree<K, void, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TreeType tree_;
+
+    // Compare 声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Compare, KeyArg>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    // 默认构造函数
+    BBTreeSet() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BBTreeSet(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：`键`按顺序追加到新的叶节点中，时间复杂度为 O(n)
+    BBTreeSet(const BBTreeSet &other) = default;
+
+    // 移动构造函数
+    BBTreeSet(BBTreeSet &&other) noexcept = default;
+
+    // 通过初始化列表构造对象
+    BBTreeSet(std::initializer_list<K> init_list) {
+        this->insert(init_list);
+    }
+
+    template<typename InputIter>
+    BBTreeSet(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BBTreeSet() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{  // 赋值运算符相关操作
+public:
+
+    BBTreeSet &operator=(const BBTreeSet &other) = default;
+
+    BBTreeSet &operator=(BBTreeSet &&other) noexcept = default;
+
+    // 通过初始化列表赋值
+    BBTreeSet &operator=(std::initializer_list<K> init_list) {
+        tree_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @}  // 赋值运算符相关操作
+
+
+// @{  // 迭代器相关，按`键`的升序遍历
+public:
+
+    Iterator begin() { return tree_.begin(); }
+    Iterator begin() const { return tree_.begin(); }
+    Iterator end() { return tree_.end(); }
+    Iterator end() const { return tree_.end(); }
+// @}  // 迭代器相关，按`键`的升序遍历
+
+
+// @{  // 与容量相关的操作
+public:
+
+    // 检查容器是否为空
+    bool empty() const noexcept {
+        return tree_.size() == 0;
+    }
+
+    // 返回容器中的元素数
+    SizeType size() const noexcept {
+        return tree_.size();
+    }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+
+    // 返回容器使用的比较器
+    Compare key_comp() const { return tree_.key_comp(); }
+// @}  // 与容量相关的操作
+
+
+// @{  // 向容器中增加元素相关的操作
+public:
+
+    std::pair<Iterator, bool> insert(const K &key) {
+        return tree_.try_emplace(key);
+    }
+
+    std::pair<Iterator, bool> insert(K &&key) {
+        return tree_.try_emplace(std::move(key));
+    }
+
+    // 按升序插入的区间不需要查找，每个`键`直接追加到最后一个叶节点中
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        while (beg != end) {
+            tree_.try_emplace(*beg);
+            ++beg;
+        }
+    }
+
+    void insert(std::initializer_list<K> init_list) {
+        for (const auto &it : init_list) tree_.try_emplace(it);
+    }
+// @}  // 向容器中增加元素相关的操作
+
+
+// @{  // 向容器中删除元素的相关操作
+public:
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    SizeType erase(const K &key) { return tree_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器全部失效
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return tree_.erase(key); }
+
+    // 删除所有元素并释放所有节点
+    void clear() noexcept { tree_.clear(); }
+// @}  // 向容器中删除元素的相关操作
+
+
+public:
+    // 交换两个容器中的内容
+    void swap(BBTreeSet &other) noexcept {
+        tree_.swap(other.tree_);
+    }
+
+
+// @{  // 与元素查找相关的操作
+public:
+
+    // 返回键为`key`的元素数，非 0 即 1
+    SizeType count(const K &key) const {
+        return tree_.contains(key);
+    }
+
+    bool contains(const K &key) const {
+        return tree_.contains(key);
+    }
+
+    // 寻找键为`key`的元素
+    Iterator find(const K &key) {
+        return tree_.find(key);
+    }
+
+    Iterator find(const K &key) const {
+        return tree_.find(key);
+    }
+
+    // 返回指向首个不小于（>=）`key`的元素的迭代器
+    Iterator lower_bound(const K &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    // 返回指向首个大于`key`的元素的迭代器
+    Iterator upper_bound(const K &key) const {
+        return tree_.upper_bound(key);
+    }
+
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return tree_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    bool contains(const KeyArg &key) const {
+        return tree_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const {
+        return tree_.upper_bound(key);
+    }
+// @}  // 与元素查找相关的操作
+};
+
+// 判断两个 BBTreeSet 容器是否相等：两者按顺序逐个比较`键`
+template<typename K, typename Compare, typename Alloc>
+bool operator==(const BBTreeSet<K, Compare, Alloc> &x,
+                const BBTreeSet<K, Compare, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    auto beg1 = x.begin();
+    auto beg2 = y.begin();
+    while (beg1 != x.end()) {
+        if (!(*beg1 == *beg2)) return false;
+        ++beg1;
+        ++beg2;
+    }
+    return true;
+}
+
+template<typename K, typename Compare, typename Alloc>
+bool operator!=(const BBTreeSet<K, Compare, Alloc> &x,
+                const BBTreeSet<K, Compare, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_BTREE_SET_H
@@ -0,0 +1,233 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 重复`键`共用一个节点的多重映射 BBucketMultiMap
+//
+
+#include "rb_bucket_tree.h"
+
+#ifndef CPPBABYSTL_BABY_BUCKET_MULTIMAP_H
+#define CPPBABYSTL_BABY_BUCKET_MULTIMAP_H
+
+/*
+ * 多重映射，接口与 BMultiMap 相同，适用于每个`键`对应大量`值`的场景
+ *
+ * BMultiMap 为每个元素建立一个红黑树节点，同一`键`的 m 个元素占用 m 个节点，
+ * erase(key) 每删除一个元素都要从根节点重新查找一次。BBucketMultiMap 为每个
+ * 不同的`键`只建立一个节点，该`键`的所有`值`按插入顺序连续存放在节点的桶中：
+ *   count / find / equal_range 为 O(log n)，n 为不同`键`的数目
+ *   erase(key) 为 O(log n) 加上析构 m 个`值`的代价
+ *   每个重复元素只占用一个`值`的空间
+ * 代价是每个不同的`键`多一个桶对象和一次堆分配，`键`几乎不重复时应使用 BMultiMap。
+ *
+ * 迭代器解引用的结果与 BMultiMap 相同，为 std::pair<const K &, V &>；向某个`键`
+ * 插入元素或删除其中的元素会使该`键`的其他迭代器失效
+ * */
+template<typename K, typename V,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<std::pair<const K, V>>>
+class BBucketMultiMap {
+public:
+    using TreeType = RBBucketTree<K, V, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TreeType tree_;
+
+    // Compare 声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Compare, KeyArg>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    BBucketMultiMap() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BBucketMultiMap(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：节点已经有序，直接建立一棵平衡的树，时间复杂度为 O(n)
+    BBucketMultiMap(const BBucketMultiMap &other) = default;
+
+    BBucketMultiMap(BBucketMultiMap &&other) noexcept = default;
+
+    BBucketMultiMap(std::initializer_list<std::pair<K, V>> init_list) {
+        this->insert(init_list);
+    }
+
+    // [beg, end) 按`键`非递减时，时间复杂度为 O(n)
+    template<typename InputIter>
+    BBucketMultiMap(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BBucketMultiMap() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{  // 赋值运算相关操作
+public:
+
+    BBucketMultiMap &operator=(const BBucketMultiMap &other) = default;
+
+    BBucketMultiMap &operator=(BBucketMultiMap &&other) noexcept = default;
+
+    BBucketMultiMap &operator=(std::initializer_list<std::pair<K, V>> init_list) {
+        tree_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @}  // 赋值运算相关操作
+
+
+// @{  // 迭代器相关操作，按`键`的升序遍历，同一`键`的`值`按插入顺序遍历
+public:
+
+    Iterator begin() const { return tree_.begin(); }
+    Iterator end() const { return tree_.end(); }
+// @}  // 迭代器相关操作，按`键`的升序遍历，同一`键`的`值`按插入顺序遍历
+
+
+// @{  // 与容器容量相关的操作
+public:
+
+    bool empty() const { return tree_.size() == 0; }
+
+    // 返回容器中的元素总数
+    SizeType size() const { return tree_.size(); }
+
+    // 返回不同`键`的数目
+    SizeType key_count() const { return tree_.key_count(); }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+// @}  // 与容器容量相关的操作
+
+
+// @{  // 向容器中增加元素的相关操作
+public:
+
+    // 追加到`键`相同的所有元素之后，与 BMultiMap 的顺序一致
+    Iterator insert(const std::pair<K, V> &val) {
+        return tree_.insert(val.first, val.second);
+    }
+
+    Iterator insert(std::pair<K, V> &&val) {
+        return tree_.insert(val.first, std::move(val.second));
+    }
+
+    // 以 hint 为提示插入，新元素尽可能放在 hint 之前，提示正确时均摊 O(1)
+    Iterator insert(Iterator hint, const std::pair<K, V> &val) {
+        return tree_.insert_hint(hint, val.first, val.second);
+    }
+
+    // 以 end() 为提示逐个插入，按`键`非递减的区间每个元素都是 O(1) 的
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        for (; beg != end; ++beg) {
+            const auto &[k, v] = *beg;
+            tree_.insert_hint(tree_.end(), k, v);
+        }
+    }
+
+    void insert(std::initializer_list<std::pair<K, V>> init_list) {
+        this->insert(init_list.begin(), init_list.end());
+    }
+
+    // 向容器中原位构造元素
+    template<typename ...Args>
+    Iterator emplace(const K &key, Args &&...args) {
+        return tree_.insert(key, std::forward<Args>(args)...);
+    }
+// @}  // 向容器中增加元素的相关操作
+
+
+// @{  // 在容器中删除元素的操作
+public:
+
+    // 删除所有键为`key`的元素，返回删除的元素数目，只需查找一次
+    SizeType erase(const K &key) { return tree_.erase(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return tree_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    void clear() { tree_.clear(); }
+// @}  // 在容器中删除元素的操作
+
+
+public:
+    void swap(BBucketMultiMap &other) noexcept {
+        tree_.swap(other.tree_);
+    }
+
+
+// @{  // 与元素查找相关的操作，都只需要一次 O(log n) 的查找
+public:
+
+    // 返回键为`key`的元素数目，即对应桶的大小
+    SizeType count(const K &key) const { return tree_.count(key); }
+
+    // 返回指向键为`key`的首个元素的迭代器，不存在时返回 end()
+    Iterator find(const K &key) const { return tree_.find(key); }
+
+    // 返回首个不小于（>=）`key`的元素的迭代器
+    Iterator lower_bound(const K &key) const { return tree_.lower_bound(key); }
+
+    // 返回首个大于`key`的元素的迭代器
+    Iterator upper_bound(const K &key) const { return tree_.upper_bound(key); }
+
+    // 返回键为`key`的所有元素构成的区间
+    std::pair<Iterator, Iterator> equal_range(const K &key) const {
+        return tree_.equal_range(key);
+    }
+
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const { return tree_.count(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const { return tree_.find(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const { return tree_.lower_bound(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const { return tree_.upper_bound(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        return tree_.equal_range(key);
+    }
+// @}  // 与元素查找相关的操作，都只需要一次 O(log n) 的查找
+};
+
+// 判断两个 BBucketMultiMap 容器是否相等：两者按顺序逐个比较`键值对`
+template<typename K, typename V, typename Compare, typename Alloc>
+bool operator==(const BBucketMultiMap<K, V, Compare, Alloc> &x,
+                const BBucketMultiMap<K, V, Compare, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    auto beg1 = x.begin();
+    auto beg2 = y.begin();
+    while (beg1 != x.end()) {
+        if (*beg1 != *beg2) return false;
+        ++beg1;
+        ++beg2;
+    }
+    return true;
+}
+
+template<typename K, typename V, typename Compare, typename Alloc>
+bool operator!=(const BBucketMultiMap<K, V, Compare, Alloc> &x,
+                const BBucketMultiMap<K, V, Compare, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_BUCKET_MULTIMAP_H
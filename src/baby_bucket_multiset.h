@@ -0,0 +1,221 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 等价`键`共用一个节点的多重集合 BBucketMultiSet
+//
+
+#include "rb_bucket_tree.h"
+
+#ifndef CPPBABYSTL_BABY_BUCKET_MULTISET_H
+#define CPPBABYSTL_BABY_BUCKET_MULTISET_H
+
+/*
+ * 多重集合，接口与 BMultiSet 相同，适用于同一`键`大量重复的场景
+ *
+ * 每个不同的`键`只建立一个红黑树节点，所有与之等价的`键`按插入顺序存放在节点
+ * 的桶中（等价的`键`不一定完全相同，因此每一个都会保留下来）。count / find /
+ * equal_range 为 O(log n)，erase(key) 只需查找一次，n 为不同`键`的数目
+ *
+ * 向某个`键`插入元素或删除其中的元素会使与之等价的其他元素的迭代器失效
+ * */
+template<typename K,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<K>>
+class BBucketMultiSet {
+public:
+    using TreeType = RBBucketTree<K, void, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TreeType tree_;
+
+    // Compare 声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Compare, KeyArg>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    BBucketMultiSet() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BBucketMultiSet(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：节点已经有序，直接建立一棵平衡的树，时间复杂度为 O(n)
+    BBucketMultiSet(const BBucketMultiSet &other) = default;
+
+    BBucketMultiSet(BBucketMultiSet &&other) noexcept = default;
+
+    BBucketMultiSet(std::initializer_list<K> init_list) {
+        this->insert(init_list);
+    }
+
+    // [beg, end) 非递减时，时间复杂度为 O(n)
+    template<typename InputIter>
+    BBucketMultiSet(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BBucketMultiSet() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{  // 赋值运算符相关操作
+public:
+
+    BBucketMultiSet &operator=(const BBucketMultiSet &other) = default;
+
+    BBucketMultiSet &operator=(BBucketMultiSet &&other) noexcept = default;
+
+    BBucketMultiSet &operator=(std::initializer_list<K> init_list) {
+        tree_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @}  // 赋值运算符相关操作
+
+
+// @{  // 迭代器相关，按`键`的升序遍历，等价的`键`按插入顺序遍历
+public:
+
+    Iterator begin() const { return tree_.begin(); }
+    Iterator end() const { return tree_.end(); }
+// @}  // 迭代器相关，按`键`的升序遍历，等价的`键`按插入顺序遍历
+
+
+// @{  // 与容量相关的操作
+public:
+
+    bool empty() const { return tree_.size() == 0; }
+
+    // 返回容器中的元素总数
+    SizeType size() const { return tree_.size(); }
+
+    // 返回互不等价的`键`的数目
+    SizeType key_count() const { return tree_.key_count(); }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+// @}  // 与容量相关的操作
+
+
+// @{  // 向容器中增加元素相关的操作
+public:
+
+    Iterator insert(const K &key) {
+        return tree_.insert(key, key);
+    }
+
+    Iterator insert(K &&key) {
+        return tree_.insert(key, std::move(key));
+    }
+
+    // 以 hint 为提示插入，新元素尽可能放在 hint 之前，提示正确时均摊 O(1)
+    Iterator insert(Iterator hint, const K &key) {
+        return tree_.insert_hint(hint, key, key);
+    }
+
+    // 以 end() 为提示逐个插入，非递减的区间每个元素都是 O(1) 的
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        for (; beg != end; ++beg) {
+            const K &key = *beg;
+            tree_.insert_hint(tree_.end(), key, key);
+        }
+    }
+
+    void insert(std::initializer_list<K> init_list) {
+        this->insert(init_list.begin(), init_list.end());
+    }
+// @}  // 向容器中增加元素相关的操作
+
+
+// @{  // 向容器中删除元素的相关操作
+public:
+
+    // 删除所有与`key`等价的元素，返回删除的元素数目，只需查找一次
+    SizeType erase(const K &key) { return tree_.erase(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return tree_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    void clear() { tree_.clear(); }
+// @}  // 向容器中删除元素的相关操作
+
+
+public:
+    void swap(BBucketMultiSet &other) noexcept {
+        tree_.swap(other.tree_);
+    }
+
+
+// @{  // 与元素查找相关的操作，都只需要一次 O(log n) 的查找
+public:
+
+    // 返回与`key`等价的元素数目，即对应桶的大小
+    SizeType count(const K &key) const { return tree_.count(key); }
+
+    // 返回指向与`key`等价的首个元素的迭代器，不存在时返回 end()
+    Iterator find(const K &key) const { return tree_.find(key); }
+
+    // 返回首个不小于（>=）`key`的元素的迭代器
+    Iterator lower_bound(const K &key) const { return tree_.lower_bound(key); }
+
+    // 返回首个大于`key`的元素的迭代器
+    Iterator upper_bound(const K &key) const { return tree_.upper_bound(key); }
+
+    // 返回与`key`等价的所有元素构成的区间
+    std::pair<Iterator, Iterator> equal_range(const K &key) const {
+        return tree_.equal_range(key);
+    }
+
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const { return tree_.count(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const { return tree_.find(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const { return tree_.lower_bound(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const { return tree_.upper_bound(key); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        return tree_.equal_range(key);
+    }
+// @}  // 与元素查找相关的操作，都只需要一次 O(log n) 的查找
+};
+
+// 判断两个 BBucketMultiSet 容器是否相等：两者按顺序逐个比较`键`
+template<typename K, typename Compare, typename Alloc>
+bool operator==(const BBucketMultiSet<K, Compare, Alloc> &x,
+                const BBucketMultiSet<K, Compare, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    auto beg1 = x.begin();
+    auto beg2 = y.begin();
+    while (beg1 != x.end()) {
+        if (!(*beg1 == *beg2)) return false;
+        ++beg1;
+        ++beg2;
+    }
+    return true;
+}
+
+template<typename K, typename Compare, typename Alloc>
+bool operator!=(const BBucketMultiSet<K, Compare, Alloc> &x,
+                const BBucketMultiSet<K, Compare, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_BUCKET_MULTISET_H
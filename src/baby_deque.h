@@ -4,7 +4,12 @@
 
 #include <cstddef>
 #include <cstring>
+#include <memory>
 #include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <initializer_list>
+#include "baby_alloc_holder.h"
 
 #ifndef CPPBABYSTL_BABY_DEQUE_H
 #define CPPBABYSTL_BABY_DEQUE_H
@@ -20,13 +25,20 @@ deque_buf_size(std::size_t size) {
            : std::size_t(1);
 }
 
-template<typename Tp>
-class BDeque {
+template<typename Tp, typename Alloc = std::allocator<Tp>>
+class BDeque : private BAllocHolder<typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>> {
 public:
     using SizeType = std::size_t;
+    using AllocatorType = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
     struct Iterator;
 
 private:
+    using AllocTraits = std::allocator_traits<AllocatorType>;
+    using MapAllocType = typename AllocTraits::template rebind_alloc<Tp *>;
+    using MapAllocTraits = std::allocator_traits<MapAllocType>;
+    using AllocHolder = BAllocHolder<AllocatorType>;
+    using AllocHolder::alloc_;   // 分配缓冲区所用的分配器，中控器数组使用其 rebind 后的副本
+
     Tp **map_;             // 中控器数组
     SizeType map_size_{};  // 中控器数组的大小
     Iterator start_;       // 迭代器，指向容器的第一个元素
@@ -44,12 +56,26 @@ private:
      * @param map_size map数组的大小
      * */
     Tp ** create_map_(SizeType map_size) {
-        return new Tp *[map_size]{};
+        MapAllocType map_alloc(alloc_());
+        Tp **map = MapAllocTraits::allocate(map_alloc, map_size);
+        std::fill(map, map + map_size, nullptr);
+        return map;
+    }
+
+    // 释放一个map（中控器）数组，不会释放其中的缓冲区
+    void free_map_(Tp **map, SizeType map_size) {
+        MapAllocType map_alloc(alloc_());
+        MapAllocTraits::deallocate(map_alloc, map, map_size);
     }
 
-    // 创建一个缓冲区
+    // 创建一个缓冲区，缓冲区中的元素均未构造
     Tp * create_buff_() {
-        return new Tp[deque_buf_size(sizeof(Tp))]{};
+        return AllocTraits::allocate(alloc_(), deque_buf_size(sizeof(Tp)));
+    }
+
+    // 释放一个缓冲区，调用前需要保证其中的元素已经析构
+    void free_buff_(Tp *buff) {
+        AllocTraits::deallocate(alloc_(), buff, deque_buf_size(sizeof(Tp)));
     }
 
     /*
@@ -69,15 +95,33 @@ private:
     template<typename InputIter>
     void construct_range_(InputIter beg, InputIter end);
 
-    // 销毁当前容器
+    // 销毁当前容器：析构[start_, finish_)内的元素，并释放所有缓冲区和map
     void destroy_() {
+        if (map_ == nullptr) return;
+        if constexpr (!std::is_trivially_destructible_v<Tp>) {
+            for (Iterator it = start_; it != this->end(); ++it) {
+                AllocTraits::destroy(alloc_(), it.cur);
+            }
+        }
         for (SizeType i = 0; i < map_size_; i++) {
             if (map_[i] == nullptr) continue;
-            delete[] map_[i];
+            free_buff_(map_[i]);
             map_[i] = nullptr;
         }
-        delete[] map_;
-        std::memset(this, 0, sizeof(*this));
+        free_map_(map_, map_size_);
+
+        map_ = nullptr;
+        map_size_ = 0;
+        start_ = finish_ = Iterator();
+    }
+
+    // 接管 other 的 map 及缓冲区，other 变为一个空容器
+    void steal_(BDeque &other) {
+        map_ = other.map_;
+        map_size_ = other.map_size_;
+        start_ = other.start_;
+        finish_ = other.finish_;
+        other.initialize_map_(0);
     }
 
 public:
@@ -87,15 +131,24 @@ public:
         initialize_map_(0);
     }
 
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BDeque(const Alloc &alloc)
+            : AllocHolder(AllocatorType(alloc)), map_(nullptr), map_size_(0) {
+        initialize_map_(0);
+    }
+
     // 拷贝构造函数
-    BDeque(const BDeque &other) : map_(nullptr), map_size_(0) {
+    BDeque(const BDeque &other)
+            : AllocHolder(AllocTraits::select_on_container_copy_construction(other.alloc_())),
+              map_(nullptr), map_size_(0) {
         initialize_map_(other.size());
         construct_range_(other.begin(), other.end());
     }
 
     // 移动构造函数
     BDeque(BDeque &&other) noexcept
-            : map_(other.map_),
+            : AllocHolder(other.alloc_()),
+              map_(other.map_),
               map_size_(other.map_size_),
               start_(other.start_),
               finish_(other.finish_) {
@@ -105,6 +158,9 @@ public:
     // 创建一个大小为 cnt 的 BDeque 容器，值全为 Tp 类型默认值
     explicit BDeque(SizeType cnt) : map_(nullptr), map_size_(0) {
         initialize_map_(cnt);
+        for (Iterator it = start_; it != this->end(); ++it) {
+            AllocTraits::construct(alloc_(), it.cur);  // 值初始化
+        }
     }
 
     // 创建一个大小为 cnt 的 BDeque 容器，其值全为val
@@ -116,7 +172,7 @@ public:
     }
 
     // 通过初始化列表构造容器
-    BDeque(std::initializer_list<Tp> ilist) {
+    BDeque(std::initializer_list<Tp> ilist) : map_(nullptr), map_size_(0) {
         initialize_map_(ilist.size());
         construct_range_(ilist.begin(), ilist.end());
     }
@@ -153,11 +209,30 @@ public:
         return *this;
     }
 
-    // 移动赋值函数
-    BDeque & operator=(BDeque &&other) noexcept {
-        this->destroy_();  // 销毁当前对象
-        std::memcpy(this, &other, sizeof(other));
-        std::memset(&other, 0, sizeof(other));
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的 map 和
+     * 缓冲区；否则只能逐个移动元素
+     * */
+    BDeque & operator=(BDeque &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value ||
+            AllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            this->destroy_();  // 销毁当前对象
+            alloc_() = other.alloc_();
+            steal_(other);
+        } else {
+            if (alloc_() == other.alloc_()) {
+                this->destroy_();
+                steal_(other);
+            } else {
+                this->clear();
+                for (auto &it : other) this->emplace_back(std::move(it));
+                other.clear();
+            }
+        }
         return *this;
     }
 
@@ -248,6 +323,9 @@ public:
     bool empty() const {
         return start_ == finish_;
     }
+
+    // 返回容器所使用的分配器
+    AllocatorType get_allocator() const { return alloc_(); }
 // @}  // 与容器容量相关的函数
 
 
@@ -308,10 +386,11 @@ private:
      * 注意：调用该函数前需要保证容器后面预留了足够的位置
      * */
     void move_back_(Iterator beg, Iterator end, SizeType step) {
-        Iterator ptr = end - 1;
-        while (ptr >= beg) {
-            std::memcpy((ptr + step).cur, ptr.cur, sizeof(Tp));
+        // 从后往前移动；先判断再自减，避免迭代器越过 beg 指向不存在的缓冲区
+        Iterator ptr = end;
+        while (ptr != beg) {
             --ptr;
+            std::memcpy((ptr + step).cur, ptr.cur, sizeof(Tp));
         }
     }
 public:
@@ -423,6 +502,7 @@ public:
 
     // 清除容器中所有的元素
     void clear() {
+        if (this->empty()) return;
         this->erase(0, this->size());
     }
 // @}  // 在容器中删除元素的相关操作
@@ -453,6 +533,9 @@ public:
         std::swap(map_size_, other.map_size_);
         std::swap(start_, other.start_);
         std::swap(finish_, other.finish_);
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_(), other.alloc_());
+        }
     }
 // @}  // 修改容器的相关操作
 
@@ -462,16 +545,26 @@ public:
 
     Iterator begin() const { return Iterator(start_); }
     Iterator begin() { return Iterator(start_); }
-    Iterator end() const { return Iterator(finish_); }
-    Iterator end() { return Iterator(finish_); }
+
+    // finish_.cur 可能恰好停在缓冲区的末尾（cur == last），此时需要将其
+    // 规范化为下一个缓冲区的起始位置，与迭代器 operator++ 的行为保持一致，
+    // 否则遍历到缓冲区末尾时将永远无法与 end() 相等
+    Iterator end() const {
+        Iterator tmp(finish_);
+        if (tmp.cur != nullptr && tmp.cur == tmp.last) {
+            tmp.set_node(tmp.node + 1);
+            tmp.cur = tmp.first;
+        }
+        return tmp;
+    }
 // @}  // 与迭代器相关的操作
 };
 
 
 // @{  // 与类 BDeque 相关的非成员函数
 // 重载 == 运算符
-template<typename Tp>
-bool operator==(const BDeque<Tp> &dq1, const BDeque<Tp> &dq2) {
+template<typename Tp, typename Alloc>
+bool operator==(const BDeque<Tp, Alloc> &dq1, const BDeque<Tp, Alloc> &dq2) {
     if (dq1.size() != dq2.size()) return false;
     auto iter1 = dq1.begin();
     auto iter2 = dq2.begin();
@@ -486,8 +579,8 @@ bool operator==(const BDeque<Tp> &dq1, const BDeque<Tp> &dq2) {
 
 
 // @{  // 类 BDeque 迭代器的实现
-template<typename Tp>
-struct BDeque<Tp>::Iterator {
+template<typename Tp, typename Alloc>
+struct BDeque<Tp, Alloc>::Iterator {
     Tp *cur, *first, *last, **node;
 
     Iterator()
@@ -508,6 +601,8 @@ struct BDeque<Tp>::Iterator {
               last(iter.last),
               node(iter.node) {}
 
+    Iterator & operator=(const BDeque::Iterator &iter) noexcept = default;
+
     Tp & operator*() const noexcept {
         return *cur;
     }
@@ -625,8 +720,8 @@ struct BDeque<Tp>::Iterator {
 
 
 // @{  // 在类 BDeque 中声明的部分成员函数的实现
-template<typename Tp>
-void BDeque<Tp>::resize(BDeque::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::resize(BDeque::SizeType cnt, const Tp &val) {
     SizeType len = this->size();
     if (cnt > len) {
         for (SizeType i = 0; i < cnt - len; i++) {
@@ -637,8 +732,8 @@ void BDeque<Tp>::resize(BDeque::SizeType cnt, const Tp &val) {
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::resize(BDeque::SizeType cnt) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::resize(BDeque::SizeType cnt) {
     SizeType len = this->size();
     if (cnt > len) {
         for (SizeType i = 0; i < cnt - len; i++) {
@@ -649,8 +744,8 @@ void BDeque<Tp>::resize(BDeque::SizeType cnt) {
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::erase(BDeque::SizeType beg_idx, BDeque::SizeType end_idx) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::erase(BDeque::SizeType beg_idx, BDeque::SizeType end_idx) {
     if (beg_idx >= size())
         throw std::out_of_range("beg_idx must less than size()");
     if (beg_idx >= end_idx) return;
@@ -676,7 +771,7 @@ void BDeque<Tp>::erase(BDeque::SizeType beg_idx, BDeque::SizeType end_idx) {
 
         // 释放掉因删除元素导致的空缓冲区节点
         for (Tp **node = empty_node; node > finish_.node; --node) {
-            delete[] *node;
+            free_buff_(*node);
             *node = nullptr;
         }
     } else {
@@ -689,32 +784,32 @@ void BDeque<Tp>::erase(BDeque::SizeType beg_idx, BDeque::SizeType end_idx) {
 
         // 释放掉因删除元素导致的空缓冲区节点
         for (Tp **node = empty_node; node < start_.node; ++node) {
-            delete[] *node;
+            free_buff_(*node);
             *node = nullptr;
         }
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::pop_front() {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::pop_front() {
     start_.cur->~Tp();
     if (start_.cur == start_.last - 1) {
         Tp **tmp = start_.node;
         ++start_;
 
-        delete[] *tmp;
+        free_buff_(*tmp);
         *tmp = nullptr;
     } else ++start_;
 }
 
-template<typename Tp>
-void BDeque<Tp>::pop_back() {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::pop_back() {
     if (finish_.cur == finish_.first) {
         Tp **tmp = finish_.node;
         finish_.set_node(finish_.node - 1);
         finish_.cur = finish_.last - 1;
 
-        delete[] *tmp;
+        free_buff_(*tmp);
         *tmp = nullptr;
     } else {
         --finish_;
@@ -722,8 +817,8 @@ void BDeque<Tp>::pop_back() {
     finish_.cur->~Tp();  // 调用该元素的析构函数
 }
 
-template<typename Tp>
-void BDeque<Tp>::insert(BDeque::SizeType idx, initializer_list<Tp> init_list) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::insert(BDeque::SizeType idx, std::initializer_list<Tp> init_list) {
     if (idx >= this->size() / 2) {
         // [idx, size())内所有元素后移init_list.size()个单位，并将
         // init_list内所有元素依序插入到容器的索引idx处
@@ -764,8 +859,8 @@ void BDeque<Tp>::insert(BDeque::SizeType idx, initializer_list<Tp> init_list) {
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::insert(BDeque::SizeType idx, BDeque::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::insert(BDeque::SizeType idx, BDeque::SizeType cnt, const Tp &val) {
     if (idx >= this->size() / 2) {
         // [idx, size())内所有元素向后移动cnt位，并将val插入在idx处
         reserve_elements_at_back_(cnt);
@@ -804,8 +899,8 @@ void BDeque<Tp>::insert(BDeque::SizeType idx, BDeque::SizeType cnt, const Tp &va
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::insert(BDeque::SizeType idx, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::insert(BDeque::SizeType idx, const Tp &val) {
     if (idx >= this->size() / 2) {
         // [idx, size())内的所有元素后移一个单位，将val插入到idx处
         reserve_elements_at_back_(1);
@@ -834,8 +929,8 @@ void BDeque<Tp>::insert(BDeque::SizeType idx, const Tp &val) {
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::assign(BDeque::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::assign(BDeque::SizeType cnt, const Tp &val) {
     if (this->size() < cnt) {
         reserve_elements_at_back_(cnt - this->size());
     }
@@ -860,9 +955,9 @@ void BDeque<Tp>::assign(BDeque::SizeType cnt, const Tp &val) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<typename InputIter>
-void BDeque<Tp>::assign_range_(InputIter beg, InputIter end) {
+void BDeque<Tp, Alloc>::assign_range_(InputIter beg, InputIter end) {
     Iterator ptr = start_;
     while (beg != end) {
         if (ptr < finish_) {
@@ -882,8 +977,8 @@ void BDeque<Tp>::assign_range_(InputIter beg, InputIter end) {
     finish_ = tmp;
 }
 
-template<typename Tp>
-void BDeque<Tp>::recreate_map_(BDeque::SizeType new_map_size) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::recreate_map_(BDeque::SizeType new_map_size) {
     Tp **tmp = create_map_(new_map_size);
     // 将原来map中的内容复制到新map中
     std::memcpy(tmp, map_, map_size_ * sizeof(Tp *));
@@ -893,8 +988,7 @@ void BDeque<Tp>::recreate_map_(BDeque::SizeType new_map_size) {
     SizeType end_idx = finish_.node - map_;
 
     // 释放掉老map_的内存空间
-    std::memset(map_, 0, map_size_ * sizeof(Tp *));
-    delete[] map_;
+    free_map_(map_, map_size_);
 
     // 更新内容
     map_ = tmp;
@@ -905,8 +999,8 @@ void BDeque<Tp>::recreate_map_(BDeque::SizeType new_map_size) {
     finish_.set_node(map_ + end_idx);
 }
 
-template<typename Tp>
-void BDeque<Tp>::reallocate_map_(BDeque::SizeType n_nodes, bool at_front) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::reallocate_map_(BDeque::SizeType n_nodes, bool at_front) {
     SizeType full_nodes = finish_.node - start_.node + 1;
     if (n_nodes + full_nodes + 2 > map_size_) {
         // 需要重新创建一个 map
@@ -934,10 +1028,10 @@ void BDeque<Tp>::reallocate_map_(BDeque::SizeType n_nodes, bool at_front) {
     finish_.set_node(end);
 }
 
-template<typename Tp>
-void BDeque<Tp>::reserve_elements_at_front_(BDeque::SizeType n_elems) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::reserve_elements_at_front_(BDeque::SizeType n_elems) {
     // start_所指向的节点足够容纳n_elems个元素 ==> 无需任何操作
-    if (n_elems <= start_.cur - start_.first) return;
+    if (n_elems <= static_cast<SizeType>(start_.cur - start_.first)) return;
 
     SizeType buff_size = deque_buf_size(sizeof(Tp));
     // 容纳n_elems个元素需要至少重新开辟n_nodes个节点
@@ -958,10 +1052,10 @@ void BDeque<Tp>::reserve_elements_at_front_(BDeque::SizeType n_elems) {
     }
 }
 
-template<typename Tp>
-void BDeque<Tp>::reserve_elements_at_back_(BDeque::SizeType n_elems) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::reserve_elements_at_back_(BDeque::SizeType n_elems) {
     // finish_所指向的节点足够容纳n_elems个元素 ==> 无需任何操作
-    if (n_elems <= finish_.last - finish_.cur) return;
+    if (n_elems <= static_cast<SizeType>(finish_.last - finish_.cur)) return;
 
     SizeType buff_size = deque_buf_size(sizeof(Tp));
     // 容纳n_elems个元素需要至少重新开辟n_nodes个节点
@@ -983,9 +1077,9 @@ void BDeque<Tp>::reserve_elements_at_back_(BDeque::SizeType n_elems) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<typename InputIter>
-void BDeque<Tp>::construct_range_(InputIter beg, InputIter end) {
+void BDeque<Tp, Alloc>::construct_range_(InputIter beg, InputIter end) {
     Iterator iter = start_;
     while (beg != end) {
         new(iter.cur) Tp(*beg);  // 原位构造
@@ -995,8 +1089,8 @@ void BDeque<Tp>::construct_range_(InputIter beg, InputIter end) {
     finish_ = iter;
 }
 
-template<typename Tp>
-void BDeque<Tp>::initialize_map_(BDeque::SizeType n_elems) {
+template<typename Tp, typename Alloc>
+void BDeque<Tp, Alloc>::initialize_map_(BDeque::SizeType n_elems) {
     SizeType n_nodes = n_elems / deque_buf_size(sizeof(Tp)) + 1;
     map_size_ = std::max(n_nodes + 2, SizeType(kInitMapSize));
 
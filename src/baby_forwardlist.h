@@ -3,26 +3,41 @@
 //
 
 #include <cstddef>
+#include <memory>
+#include <utility>
+#include "baby_alloc_holder.h"
 
 #ifndef CPPBABYSTL_BABY_FORWARDLIST_H
 #define CPPBABYSTL_BABY_FORWARDLIST_H
 
+// BForwardList 的两个辅助结构，定义在类外以便 BForwardList 以节点分配器为基类
+struct BForwardListNodeBase {
+    BForwardListNodeBase* next;
+    BForwardListNodeBase(): next(nullptr) {}
+};
+
 template<typename Tp>
-class BForwardList {
+struct BForwardListNode: public BForwardListNodeBase {
+    Tp storage;
+
+    template<typename... Args>
+    explicit BForwardListNode(Args&&... args): BForwardListNodeBase(), storage(std::forward<Args>(args)...) {}
+};
+
+template<typename Tp, typename Alloc = std::allocator<Tp>>
+class BForwardList
+        : private BAllocHolder<typename std::allocator_traits<Alloc>::template rebind_alloc<BForwardListNode<Tp>>> {
 public:
     using SizeType = std::size_t;
+    using AllocatorType = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
 
 private:
-    // 定义两个辅助结构
-    struct NodeBase {
-        NodeBase* next;
-        NodeBase(): next(nullptr) {}
-    };
-
-    struct Node: public NodeBase {
-        Tp storage;
-        Node(): NodeBase() {}
-    };
+    using NodeBase = BForwardListNodeBase;
+    using Node = BForwardListNode<Tp>;
+    using NodeAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeAllocTraits = std::allocator_traits<NodeAllocType>;
+    using AllocHolder = BAllocHolder<NodeAllocType>;
+    using AllocHolder::alloc_;   // 分配节点所用的分配器
 
     NodeBase head_;
     SizeType len_;
@@ -33,14 +48,23 @@ private:
 
     // 创建一个存储元素的节点
     template<typename... Args>
-    static Node* create_node_(Args&&... args) {
-        auto node = new Node;
-
-        // placement new创建对象
-        new (&(node->storage)) Tp(std::forward<Args>(args)...);
+    Node* create_node_(Args&&... args) {
+        Node* node = NodeAllocTraits::allocate(alloc_(), 1);
+        try {
+            NodeAllocTraits::construct(alloc_(), node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeAllocTraits::deallocate(alloc_(), node, 1);
+            throw;
+        }
         return node;
     }
 
+    // 析构节点中的元素并释放节点的内存
+    void destroy_node_(Node* node) {
+        NodeAllocTraits::destroy(alloc_(), node);
+        NodeAllocTraits::deallocate(alloc_(), node, 1);
+    }
+
     /*
      * @brief 销毁容器在(beg, end)之间的所有元素
      * @param beg 销毁操作的起始点，即要销毁的第一个元素的前一个元素的指针
@@ -51,7 +75,7 @@ private:
         while (cur != end) {
             auto tmp = static_cast<Node*>(cur);
             cur = cur->next;
-            delete tmp;
+            destroy_node_(tmp);
             len_--;  // 删除一个节点，长度减少1
         }
         beg->next = end;
@@ -61,8 +85,13 @@ public:
     // 默认构造函数
     BForwardList(): len_(0) {}
 
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BForwardList(const Alloc& alloc): AllocHolder(NodeAllocType(alloc)), len_(0) {}
+
     // 拷贝构造函数
-    BForwardList(const BForwardList& other): len_(other.size()) {
+    BForwardList(const BForwardList& other)
+            : AllocHolder(NodeAllocTraits::select_on_container_copy_construction(other.alloc_())),
+              len_(other.size()) {
         NodeBase* p = &head_;
         for (const auto& it : other) {
             p->next = this->create_node_(it);
@@ -71,7 +100,7 @@ public:
     }
 
     // 移动构造函数
-    BForwardList(BForwardList&& other) noexcept {
+    BForwardList(BForwardList&& other) noexcept: AllocHolder(other.alloc_()) {
         len_ = other.size();
         head_.next = other.head_.next;
 
@@ -132,18 +161,49 @@ public:
     // 拷贝赋值函数
     BForwardList& operator=(const BForwardList& other) {
         if (this == &other) return *this;  // 防止自赋值
+        if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+            // 旧节点只能由旧分配器释放
+            if (alloc_() != other.alloc_()) destroy_range_(&head_, nullptr);
+            alloc_() = other.alloc_();
+        }
 
         assign_(other.begin(), other.end());
         return *this;
     }
 
-    // 移动赋值函数
-    BForwardList& operator=(BForwardList&& other) noexcept {
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的所有节点；
+     * 否则只能逐个移动元素
+     * */
+    BForwardList& operator=(BForwardList&& other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value ||
+            NodeAllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        destroy_range_(&head_, nullptr);  // 释放当前容器中的元素
+
+        if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+            alloc_() = other.alloc_();
+        } else {
+            if (alloc_() != other.alloc_()) {
+                NodeBase* pre = &head_;
+                for (auto& it : other) {
+                    pre->next = create_node_(std::move(it));
+                    pre = pre->next;
+                    len_++;
+                }
+                other.clear();
+                return *this;
+            }
+        }
+
         len_ = other.len_;
         head_.next = other.head_.next;
 
         other.len_ = 0;
         other.head_.next = nullptr;
+        return *this;
     }
 
     // 将一个初始化列表中的内容赋值给容器
@@ -181,6 +241,9 @@ public:
 
     // 判断容器是否为空
     bool empty() { return this->len_ == 0; }
+
+    // 返回容器所使用的分配器
+    AllocatorType get_allocator() const { return AllocatorType(alloc_()); }
 // @}  // 与容量相关的成员函数
 
 
@@ -218,7 +281,7 @@ public:
 
         auto node = static_cast<Node*>(head_.next);
         head_.next = node->next;
-        delete node;
+        destroy_node_(node);
         len_--;
     }
 
@@ -286,6 +349,9 @@ public:
     void swap(BForwardList& other) noexcept {
         std::swap(head_.next, other.head_.next);
         std::swap(len_, other.len_);
+        if constexpr (NodeAllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_(), other.alloc_());
+        }
     }
 // @}  // 在容器中删除元素的相关操作
 
@@ -387,8 +453,8 @@ public:
 
 
 // @{  // 迭代器类的实现
-template<typename Tp>
-class BForwardList<Tp>::Iterator {
+template<typename Tp, typename Alloc>
+class BForwardList<Tp, Alloc>::Iterator {
 private:
     NodeBase *cur;
 
@@ -435,8 +501,8 @@ public:
 
 // @{  // BForwardList类的非成员函数
 // 比较两个容器是否相等
-template<typename Tp>
-bool operator==(const BForwardList<Tp>& x, const BForwardList<Tp>& y) {
+template<typename Tp, typename Alloc>
+bool operator==(const BForwardList<Tp, Alloc>& x, const BForwardList<Tp, Alloc>& y) {
     if (x.size() != y.size()) return false;
 
     auto beg1 = x.begin();
@@ -452,9 +518,9 @@ bool operator==(const BForwardList<Tp>& x, const BForwardList<Tp>& y) {
 
 
 // @{  // 类 BForwardList 内声明但未实现的成员函数
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<typename InputIter>
-void BForwardList<Tp>::assign_(InputIter beg, InputIter end) {
+void BForwardList<Tp, Alloc>::assign_(InputIter beg, InputIter end) {
     len_ = 0;
     NodeBase* pre = &head_;
     while (beg != end) {
@@ -474,8 +540,8 @@ void BForwardList<Tp>::assign_(InputIter beg, InputIter end) {
     destroy_range_(pre, nullptr);
 }
 
-template<typename Tp>
-void BForwardList<Tp>::assign(BForwardList::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BForwardList<Tp, Alloc>::assign(BForwardList::SizeType cnt, const Tp &val) {
     NodeBase* pre = &head_;
     for (SizeType i = 0; i < cnt; i++) {
         if (pre->next == nullptr) {
@@ -493,9 +559,9 @@ void BForwardList<Tp>::assign(BForwardList::SizeType cnt, const Tp &val) {
     len_ = cnt;
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Compare>
-void BForwardList<Tp>::merge(BForwardList &other, Compare cmp) {
+void BForwardList<Tp, Alloc>::merge(BForwardList &other, Compare cmp) {
     if (this == &other) return;
 
     auto l1 = static_cast<Node*>(head_.next);
@@ -532,8 +598,8 @@ void BForwardList<Tp>::merge(BForwardList &other, Compare cmp) {
     other.len_ = 0;
 }
 
-template<typename Tp>
-void BForwardList<Tp>::remove(const Tp &val) {
+template<typename Tp, typename Alloc>
+void BForwardList<Tp, Alloc>::remove(const Tp &val) {
     NodeBase* pre = &head_;
     NodeBase* extra = nullptr;  // 需要特殊考虑的情况
 
@@ -556,9 +622,9 @@ void BForwardList<Tp>::remove(const Tp &val) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Predicate>
-void BForwardList<Tp>::remove_if(Predicate p) {
+void BForwardList<Tp, Alloc>::remove_if(Predicate p) {
     NodeBase* pre = &head_;
     while (pre->next != nullptr) {
         auto cur = static_cast<Node*>(pre->next);
@@ -570,8 +636,8 @@ void BForwardList<Tp>::remove_if(Predicate p) {
     }
 }
 
-template<typename Tp>
-void BForwardList<Tp>::reverse() noexcept {
+template<typename Tp, typename Alloc>
+void BForwardList<Tp, Alloc>::reverse() noexcept {
     NodeBase *cur = head_.next;
     head_.next = nullptr;
 
@@ -585,9 +651,9 @@ void BForwardList<Tp>::reverse() noexcept {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Predicate>
-void BForwardList<Tp>::unique(Predicate p) {
+void BForwardList<Tp, Alloc>::unique(Predicate p) {
     NodeBase* pre = &head_;
     Node* preVal = nullptr;
 
@@ -604,9 +670,9 @@ void BForwardList<Tp>::unique(Predicate p) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Compare>
-void BForwardList<Tp>::sort(Compare cmp) {
+void BForwardList<Tp, Alloc>::sort(Compare cmp) {
     SizeType len = this->size();
     SizeType merge_size = 1;  // 每一趟归并排序的长度
 
@@ -0,0 +1,192 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 容器和字符串共用的哈希函数
+//   1. bytes：wyhash 风格的 64 位哈希，作为 BString 等类型的默认哈希
+//   2. crc32c：CRC-32C 校验和，支持 SSE4.2 的 CPU 上使用硬件指令
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "baby_uint128.h"
+
+#ifndef CPPBABYSTL_BABY_HASH_H
+#define CPPBABYSTL_BABY_HASH_H
+
+// 只在 GCC / Clang 的 x86-64 平台上启用 crc32 指令，其他平台使用查表实现
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CPPBABYSTL_HASH_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * 哈希函数的集合，所有函数都是无状态的静态函数
+ *
+ * 同一个输入在同一个进程内总是得到相同的结果，但不保证跨版本稳定，
+ * 不要把哈希值持久化
+ * */
+class BHash {
+public:
+    using SizeType = std::size_t;
+
+    static constexpr std::uint64_t kSeed = 0xa0761d6478bd642fULL;
+
+private:
+    // wyhash 使用的 4 个奇数常量
+    static constexpr std::uint64_t kSecret[4] = {
+            0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+    };
+
+    static std::uint64_t read8_(const unsigned char *p) {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static std::uint64_t read4_(const unsigned char *p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // 1 ~ 3 个字节：读取首、中、尾三个字节
+    static std::uint64_t read3_(const unsigned char *p, SizeType n) {
+        return (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[n >> 1]) << 8) | p[n - 1];
+    }
+
+    // 64 x 64 -> 128 位乘法，a、b 分别替换为乘积的低 64 位和高 64 位
+    static void mum_(std::uint64_t &a, std::uint64_t &b) {
+        std::uint64_t hi;
+        a = b_mul_128(a, b, hi);
+        b = hi;
+    }
+
+    // 128 位乘积的低 64 位与高 64 位异或
+    static std::uint64_t mix_(std::uint64_t a, std::uint64_t b) {
+        mum_(a, b);
+        return a ^ b;
+    }
+
+    // CRC-32C（Castagnoli，反射多项式 0x82F63B78）的查表法，每次处理一个字节
+    struct Crc32cTable {
+        std::uint32_t t[256]{};
+
+        constexpr Crc32cTable() {
+            for (std::uint32_t i = 0; i < 256; i++) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0x82F63B78u & (0u - (c & 1)));
+                t[i] = c;
+            }
+        }
+    };
+
+    static std::uint32_t crc32c_table_(std::uint32_t crc, const unsigned char *p, SizeType n) {
+        static constexpr Crc32cTable kTable{};
+        for (SizeType i = 0; i < n; i++) crc = kTable.t[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        return crc;
+    }
+
+#ifdef CPPBABYSTL_HASH_X86
+    // 使用 SSE4.2 的 crc32 指令，每条指令处理 8 个字节
+    __attribute__((target("sse4.2")))
+    static std::uint32_t crc32c_hw_(std::uint32_t crc, const unsigned char *p, SizeType n) {
+        std::uint64_t c = crc;
+        for (; n >= 8; n -= 8, p += 8) c = _mm_crc32_u64(c, read8_(p));
+        auto c32 = static_cast<std::uint32_t>(c);
+        for (; n > 0; n--, p++) c32 = _mm_crc32_u8(c32, *p);
+        return c32;
+    }
+#endif
+
+    using Crc32cFunc = std::uint32_t (*)(std::uint32_t, const unsigned char *, SizeType);
+
+    // 根据当前 CPU 是否支持 SSE4.2 选择 crc32c 的实现，只在第一次调用时检测
+    static Crc32cFunc crc32c_impl_() {
+#ifdef CPPBABYSTL_HASH_X86
+        static const Crc32cFunc func = __builtin_cpu_supports("sse4.2") ? &crc32c_hw_ : &crc32c_table_;
+        return func;
+#else
+        return &crc32c_table_;
+#endif
+    }
+
+public:
+
+    /*
+     * @brief 计算 data 起始的 n 个字节的 64 位哈希值
+     * @param seed 初始值，不同的 seed 得到相互独立的哈希函数
+     *
+     * 算法与 wyhash 相同：每 16 个字节做一次 64 x 64 -> 128 位乘法并把高低两半
+     * 异或，超过 48 个字节时用三条相互独立的链并行处理。不超过 16 个字节的输入
+     * 只需要 2 ~ 4 次重叠读取和 2 次乘法，没有循环和分支预测失败
+     * */
+    static std::uint64_t bytes(const void *data, SizeType n, std::uint64_t seed = kSeed) {
+        auto p = static_cast<const unsigned char *>(data);
+        seed ^= mix_(seed ^ kSecret[0], kSecret[1]);
+
+        std::uint64_t a, b;
+        if (n <= 16) {
+            if (n >= 4) {
+                // 两组相互重叠的 4 字节读取覆盖全部字节
+                SizeType mid = (n >> 3) << 2;
+                a = (read4_(p) << 32) | read4_(p + mid);
+                b = (read4_(p + n - 4) << 32) | read4_(p + n - 4 - mid);
+            } else if (n > 0) {
+                a = read3_(p, n);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            SizeType i = n;
+            if (i > 48) {
+                std::uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = mix_(read8_(p) ^ kSecret[1], read8_(p + 8) ^ seed);
+                    see1 = mix_(read8_(p + 16) ^ kSecret[2], read8_(p + 24) ^ see1);
+                    see2 = mix_(read8_(p + 32) ^ kSecret[3], read8_(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mix_(read8_(p) ^ kSecret[1], read8_(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            // 最后 16 个字节可能与前面已经处理过的字节重叠
+            a = read8_(p + i - 16);
+            b = read8_(p + i - 8);
+        }
+
+        a ^= kSecret[1];
+        b ^= seed;
+        mum_(a, b);
+        return mix_(a ^ kSecret[0] ^ n, b ^ kSecret[1]);
+    }
+
+    /*
+     * @brief 把一个 64 位整数混合为各位都均匀分布的哈希值
+     *
+     * 只需要一次 64 x 64 -> 128 位乘法。用于对恒等映射之类的弱哈希值
+     * （如整数的 std::hash）做二次混合，输出的每一位都依赖于输入的全部位
+     * */
+    static std::uint64_t mix(std::uint64_t v) {
+        return mix_(v ^ kSecret[0], kSecret[1]);
+    }
+
+    /*
+     * @brief 计算 data 起始的 n 个字节的 CRC-32C 校验和
+     * @param crc 之前的数据的校验和，用于分段计算
+     *
+     * 支持 SSE4.2 的 x86-64 CPU 上使用 crc32 指令，否则查表计算，两者结果相同。
+     * CRC 是线性的、只有 32 位，适合做校验和而不适合直接作为哈希表的哈希函数
+     * */
+    static std::uint32_t crc32c(const void *data, SizeType n, std::uint32_t crc = 0) {
+        return ~crc32c_impl_()(~crc, static_cast<const unsigned char *>(data), n);
+    }
+};
+
+#endif //CPPBABYSTL_BABY_HASH_H
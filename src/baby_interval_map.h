@@ -0,0 +1,253 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于增强红黑树的区间映射 BIntervalMap
+//
+
+#include <stdexcept>
+#include "rb_tree.h"
+
+#ifndef CPPBABYSTL_BABY_INTERVAL_MAP_H
+#define CPPBABYSTL_BABY_INTERVAL_MAP_H
+
+// BIntervalMap 中每个节点的`值`：区间的右端点以及用户的`值`
+template<typename K, typename V>
+struct BIntervalEntry {
+    K hi;       // 区间的右端点，左端点是节点的`键`
+    V value;    // 用户的`值`
+};
+
+// 聚合运算：子树中区间右端点的最大值
+template<typename K, typename Compare>
+struct BIntervalMaxEndOp {
+    using ValueType = K;
+
+    template<typename Node>
+    static ValueType of(const Node &node) { return node.val.hi; }
+
+    static ValueType combine(const ValueType &a, const ValueType &b) {
+        return Compare()(a, b) ? b : a;
+    }
+};
+
+/*
+ * 区间映射：存放闭区间 [lo, hi] 到`值`的映射，允许相同或相互重叠的区间
+ *
+ * 以左端点为`键`组织成红黑树，每个节点额外记录子树中右端点的最大值
+ * （RBTreeAggregateAugment），由红黑树在旋转、插入和删除时维护。查找与
+ * [lo, hi] 重叠的区间时，右端点的最大值小于 lo 的子树和左端点大于 hi 的
+ * 右侧部分都被整体跳过，因此是否存在重叠区间只需 O(log n)，列出所有 k 个
+ * 重叠区间最坏为 O(min(n, k log n))
+ *
+ * 迭代器按左端点的升序遍历，解引用得到 (lo, BIntervalEntry) 的`键值对`，其中的
+ * BIntervalEntry 是只读的，避免修改 hi 使节点中记录的最大值过期；修改 value
+ * 使用 modify
+ * */
+template<typename K, typename V,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<std::pair<const K, V>>>
+class BIntervalMap {
+public:
+    using EntryType = BIntervalEntry<K, V>;
+    using AugmentType = RBTreeAggregateAugment<BIntervalMaxEndOp<K, Compare>>;
+    using NodeType = RBTreeMapNode<K, EntryType, AugmentType>;
+    using TreeType = RBTree<K, EntryType, NodeType, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TreeType tree_;
+
+    // 两个端点是否相等
+    bool equal_(const K &a, const K &b) const {
+        Compare cmp = tree_.key_comp();
+        return !cmp(a, b) && !cmp(b, a);
+    }
+
+    // 按左端点的升序访问以 node 为根的子树中所有与 [lo, hi] 重叠的区间
+    template<typename Func>
+    void for_each_overlapping_(NodeBase *node, const K &lo, const K &hi, Func &func) const {
+        Compare cmp = tree_.key_comp();
+        while (node != nullptr) {
+            auto tmp = static_cast<NodeType *>(node);
+            // 子树中所有区间的右端点都小于 lo
+            if (cmp(tmp->aggregate, lo)) return;
+
+            for_each_overlapping_(node->left, lo, hi, func);
+
+            // 当前节点及右子树中所有区间的左端点都大于 hi
+            if (cmp(hi, tmp->key)) return;
+            if (!cmp(tmp->val.hi, lo)) func(tmp->key, tmp->val.hi, tmp->val.value);
+            node = node->right;
+        }
+    }
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    // 默认构造函数
+    BIntervalMap() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BIntervalMap(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：other 中的区间已经有序，直接建立一棵平衡的树，时间复杂度为 O(n)
+    BIntervalMap(const BIntervalMap &other)
+            : tree_(std::allocator_traits<Alloc>::select_on_container_copy_construction(
+                    other.tree_.get_allocator())) {
+        tree_.assign_sorted(other.begin(), other.size());
+    }
+
+    // 移动构造函数
+    BIntervalMap(BIntervalMap &&other) noexcept
+            : tree_(std::move(other.tree_)) {}
+
+    ~BIntervalMap() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{  // 赋值运算相关操作
+public:
+
+    BIntervalMap &operator=(const BIntervalMap &other) {
+        if (this == &other) return *this;
+
+        tree_.assign_sorted(other.begin(), other.size());
+        return *this;
+    }
+
+    BIntervalMap &operator=(BIntervalMap &&other) noexcept {
+        tree_ = std::move(other.tree_);
+        return *this;
+    }
+// @}  // 赋值运算相关操作
+
+
+// @{  // 迭代器相关，按区间左端点的升序遍历
+public:
+
+    Iterator begin() { return tree_.begin(); }
+    Iterator begin() const { return tree_.begin(); }
+    Iterator end() { return tree_.end(); }
+    Iterator end() const { return tree_.end(); }
+// @}  // 迭代器相关，按区间左端点的升序遍历
+
+
+// @{  // 与容量相关的操作
+public:
+
+    bool empty() const { return tree_.size() == 0; }
+
+    // 返回容器中的区间数目
+    SizeType size() const { return tree_.size(); }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+// @}  // 与容量相关的操作
+
+
+// @{  // 增加和删除区间的相关操作
+public:
+
+    // 插入闭区间 [lo, hi]，hi < lo 时抛出 std::invalid_argument
+    Iterator insert(const K &lo, const K &hi, const V &value) {
+        if (tree_.key_comp()(hi, lo)) {
+            throw std::invalid_argument("BIntervalMap::insert: hi < lo");
+        }
+        return tree_.insert(false, lo, EntryType{hi, value});
+    }
+
+    Iterator insert(const K &lo, const K &hi, V &&value) {
+        if (tree_.key_comp()(hi, lo)) {
+            throw std::invalid_argument("BIntervalMap::insert: hi < lo");
+        }
+        return tree_.insert(false, lo, EntryType{hi, std::move(value)});
+    }
+
+    // 对 pos 指向的区间的 value 调用 func(value)，区间的端点保持不变
+    template<typename Func>
+    void modify(Iterator pos, Func func) {
+        tree_.modify(pos, [&func](EntryType &entry) { func(entry.value); });
+    }
+
+    // 删除 pos 指向的区间，返回指向下一个区间的迭代器
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    // 删除所有端点恰好为 [lo, hi] 的区间，返回删除的区间数目
+    SizeType erase(const K &lo, const K &hi) {
+        SizeType cnt = 0;
+        Iterator iter = tree_.lower_bound(lo);
+        while (iter != tree_.end() && !tree_.key_comp()(lo, (*iter).first)) {
+            if (equal_((*iter).second.hi, hi)) {
+                iter = tree_.erase(iter);
+                cnt++;
+            } else {
+                ++iter;
+            }
+        }
+        return cnt;
+    }
+
+    // 删除所有区间
+    void clear() { tree_.clear(); }
+
+    void swap(BIntervalMap &other) noexcept { tree_.swap(other.tree_); }
+// @}  // 增加和删除区间的相关操作
+
+
+// @{  // 区间查询
+public:
+
+    /*
+     * @brief 返回任意一个与 [lo, hi] 重叠的区间，不存在时返回 end()，时间复杂度为 O(log n)
+     *
+     * 左子树中右端点的最大值 >= lo 时只需在左子树中查找：若左子树中没有重叠的区间，
+     * 则取得最大值的区间的左端点大于 hi，右子树中所有区间的左端点也都大于 hi
+     * */
+    Iterator find_overlap(const K &lo, const K &hi) const {
+        Compare cmp = tree_.key_comp();
+        NodeBase *node = tree_.root();
+        while (node != nullptr) {
+            auto tmp = static_cast<NodeType *>(node);
+            if (!cmp(hi, tmp->key) && !cmp(tmp->val.hi, lo)) return tree_.iterator_to(node);
+
+            if (node->left != nullptr && !cmp(static_cast<NodeType *>(node->left)->aggregate, lo)) {
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return tree_.end();
+    }
+
+    // 是否存在与 [lo, hi] 重叠的区间
+    bool overlaps(const K &lo, const K &hi) const {
+        return find_overlap(lo, hi) != tree_.end();
+    }
+
+    /*
+     * @brief 按左端点的升序，对每个与 [lo, hi] 重叠的区间调用 func(lo, hi, value)
+     *
+     * func 中不能插入或删除区间，也不能修改 hi
+     * */
+    template<typename Func>
+    void for_each_overlapping(const K &lo, const K &hi, Func func) const {
+        for_each_overlapping_(tree_.root(), lo, hi, func);
+    }
+
+    // 对每个包含点 point 的区间调用 func(lo, hi, value)，即点查询（stabbing query）
+    template<typename Func>
+    void for_each_stabbing(const K &point, Func func) const {
+        for_each_overlapping_(tree_.root(), point, point, func);
+    }
+
+    // 返回包含点 point 的区间数目
+    SizeType count_stabbing(const K &point) const {
+        SizeType cnt = 0;
+        for_each_stabbing(point, [&cnt](const K &, const K &, V &) { cnt++; });
+        return cnt;
+    }
+// @}  // 区间查询
+};
+
+#endif //CPPBABYSTL_BABY_INTERVAL_MAP_H
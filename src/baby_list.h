@@ -3,30 +3,42 @@
 //
 
 #include <cstddef>
+#include <memory>
 #include <utility>
+#include "baby_alloc_holder.h"
 
 #ifndef CPPBABYSTL_BABY_LIST_H
 #define CPPBABYSTL_BABY_LIST_H
 
+// BList 的两个辅助类，定义在类外以便 BList 以节点分配器为基类
+struct BListNodeBase {
+    BListNodeBase *prev, *next;
+
+    BListNodeBase() : prev(this), next(this) {}
+};
+
 template<typename Tp>
-class BList {
+struct BListNode : public BListNodeBase {
+    Tp data;
+
+    template<typename ...Args>
+    explicit BListNode(Args &&... args) : BListNodeBase(), data(std::forward<Args>(args)...) {}
+};
+
+template<typename Tp, typename Alloc = std::allocator<Tp>>
+class BList : private BAllocHolder<typename std::allocator_traits<Alloc>::template rebind_alloc<BListNode<Tp>>> {
 public:
     using SizeType = std::size_t;
+    using AllocatorType = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
     class Iterator;
 
 private:
-    // 定义两个辅助类
-    struct NodeBase {
-        NodeBase *prev, *next;
-
-        NodeBase() : prev(this), next(this) {}
-    };
-
-    struct Node : public NodeBase {
-        Tp data;
-
-        Node() = default;
-    };
+    using NodeBase = BListNodeBase;
+    using Node = BListNode<Tp>;
+    using NodeAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeAllocTraits = std::allocator_traits<NodeAllocType>;
+    using AllocHolder = BAllocHolder<NodeAllocType>;
+    using AllocHolder::alloc_;   // 分配节点所用的分配器
 
     NodeBase head_;
     SizeType size_{};
@@ -50,15 +62,20 @@ public:
     // 默认构造函数，创建一个空表
     BList() : size_(0) {}
 
+    // 创建一个使用分配器 alloc 的空表
+    explicit BList(const Alloc &alloc) : AllocHolder(NodeAllocType(alloc)), size_(0) {}
+
     // 拷贝构造函数
-    BList(const BList &other) : size_(0) {
+    BList(const BList &other)
+            : AllocHolder(NodeAllocTraits::select_on_container_copy_construction(other.alloc_())),
+              size_(0) {
         for (const auto &it: other) {
             this->emplace_back(it);
         }
     }
 
     // 移动构造函数
-    BList(BList &&other) noexcept: size_(other.size_) {
+    BList(BList &&other) noexcept: AllocHolder(other.alloc_()), size_(other.size_) {
         head_.next = other.head_.next;
         other.head_.next->prev = &head_;
         head_.prev = other.head_.prev;
@@ -113,12 +130,24 @@ public:
     // 拷贝赋值函数
     BList & operator=(const BList &other) {
         if (this == &other) return *this;  // 防止自赋值
+        if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+            // 旧节点只能由旧分配器释放
+            if (alloc_() != other.alloc_()) destroy_range_(head_.next, &head_);
+            alloc_() = other.alloc_();
+        }
         assign_range_(other.begin(), other.end());
         return *this;
     }
 
-    // 移动赋值函数
-    BList & operator=(BList &&other) noexcept;
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的所有节点；
+     * 否则只能逐个移动元素
+     * */
+    BList & operator=(BList &&other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value ||
+            NodeAllocTraits::is_always_equal::value);
 
     // 将一个初始化列表中的元素赋值给当前容器
     BList & operator=(std::initializer_list<Tp> init_list) {
@@ -184,6 +213,9 @@ public:
     // 检查容器是否为空
     bool empty() const { return size_ == 0; }
 
+    // 返回容器所使用的分配器
+    AllocatorType get_allocator() const { return AllocatorType(alloc_()); }
+
 
 // @}  // 与容器容量相关的操作
 
@@ -195,12 +227,23 @@ private:
      * @param args 创建节点所需的参数
      * */
     template<typename ...Args>
-    Node *create_node_(Args ...args) {
-        auto node = new Node;
-        new(&(node->data)) Tp(std::forward<Args>(args)...);
+    Node *create_node_(Args &&...args) {
+        Node *node = NodeAllocTraits::allocate(alloc_(), 1);
+        try {
+            NodeAllocTraits::construct(alloc_(), node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeAllocTraits::deallocate(alloc_(), node, 1);
+            throw;
+        }
         return node;
     }
 
+    // 析构节点中的元素并释放节点的内存，调用前需要保证节点已经断开连接
+    void destroy_node_(Node *node) {
+        NodeAllocTraits::destroy(alloc_(), node);
+        NodeAllocTraits::deallocate(alloc_(), node, 1);
+    }
+
     /*
      * @brief 插入元素
      * @param pos 插入位置，新元素将插入到pos前面
@@ -208,19 +251,19 @@ private:
      * 私有成员函数，仅供其余函数调用
      * */
     template<typename ...Args>
-    void insert_(NodeBase *pos, Args... args);
+    void insert_(NodeBase *pos, Args &&... args);
 
 public:
 
     // 在容器尾部原位构造新元素
     template<typename ...Args>
-    void emplace_back(Args... args) {
+    void emplace_back(Args &&... args) {
         insert_(&head_, std::forward<Args>(args)...);
     }
 
     // 在容器头部原位构造新元素
     template<typename ...Args>
-    void emplace_front(Args... args) {
+    void emplace_front(Args &&... args) {
         insert_(head_.next, std::forward<Args>(args)...);
     }
 
@@ -473,9 +516,9 @@ public:
 
 // @{  // 与BList相关的非成员函数
 // 重载==运算符
-template<typename T>
+template<typename T, typename Alloc>
 bool
-operator==(const BList<T> &x, const BList<T> &y) {
+operator==(const BList<T, Alloc> &x, const BList<T, Alloc> &y) {
     if (x.size() != y.size()) return false;
     auto beg1 = x.begin();
     auto beg2 = y.begin();
@@ -490,8 +533,8 @@ operator==(const BList<T> &x, const BList<T> &y) {
 
 
 // @{  // BList类迭代器的实现
-template<typename Tp>
-class BList<Tp>::Iterator {
+template<typename Tp, typename Alloc>
+class BList<Tp, Alloc>::Iterator {
 private:
     NodeBase *ptr;
     friend BList;
@@ -554,9 +597,9 @@ public:
 
 
 // @{  // BList中声明但是没有实现的成员函数
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<typename... Args>
-void BList<Tp>::insert_(BList::NodeBase *pos, Args... args) {
+void BList<Tp, Alloc>::insert_(BList::NodeBase *pos, Args &&... args) {
     Node *tmp = create_node_(std::forward<Args>(args)...);
 
     // 将tmp插入到pos前
@@ -568,8 +611,8 @@ void BList<Tp>::insert_(BList::NodeBase *pos, Args... args) {
     this->size_++;
 }
 
-template<typename Tp>
-void BList<Tp>::destroy_range_(BList::NodeBase *beg, BList::NodeBase *end) {
+template<typename Tp, typename Alloc>
+void BList<Tp, Alloc>::destroy_range_(BList::NodeBase *beg, BList::NodeBase *end) {
     while (beg != end) {
         auto tmp = static_cast<Node *>(beg);
         beg = beg->next;
@@ -582,13 +625,13 @@ void BList<Tp>::destroy_range_(BList::NodeBase *beg, BList::NodeBase *end) {
         size_--;
 
         // 销毁tmp指向的内存
-        delete tmp;
+        destroy_node_(tmp);
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<typename InputIter>
-void BList<Tp>::assign_range_(InputIter beg, InputIter end) {
+void BList<Tp, Alloc>::assign_range_(InputIter beg, InputIter end) {
     NodeBase *cur = head_.next;
     while (beg != end) {
         if (cur == &head_) {
@@ -607,10 +650,25 @@ void BList<Tp>::assign_range_(InputIter beg, InputIter end) {
     destroy_range_(cur, &head_);
 }
 
-template<typename Tp>
-BList<Tp> & BList<Tp>::operator=(BList &&other) noexcept {
+template<typename Tp, typename Alloc>
+BList<Tp, Alloc> & BList<Tp, Alloc>::operator=(BList &&other) noexcept(
+        NodeAllocTraits::propagate_on_container_move_assignment::value ||
+        NodeAllocTraits::is_always_equal::value) {
+    if (this == &other) return *this;
+
     // 销毁当前容器
     destroy_range_(head_.next, &head_);
+    if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+        alloc_() = other.alloc_();
+    } else {
+        if (alloc_() != other.alloc_()) {
+            // 分配器不相等，other 的节点不能由当前容器释放，只能逐个移动元素
+            for (auto &it : other) this->emplace_back(std::move(it));
+            other.clear();
+            return *this;
+        }
+    }
+    if (other.size_ == 0) return *this;
 
     // 执行移动赋值操作
     head_.next = other.head_.next;
@@ -622,10 +680,11 @@ BList<Tp> & BList<Tp>::operator=(BList &&other) noexcept {
     other.head_.prev = &other.head_;
     size_ = other.size_;
     other.size_ = 0;
+    return *this;
 }
 
-template<typename Tp>
-void BList<Tp>::assign(BList::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc>
+void BList<Tp, Alloc>::assign(BList::SizeType cnt, const Tp &val) {
     NodeBase *cur = head_.next;
     for (SizeType i = 0; i < cnt; i++) {
         if (cur == &head_) {
@@ -641,27 +700,34 @@ void BList<Tp>::assign(BList::SizeType cnt, const Tp &val) {
     destroy_range_(cur, &head_);  // 删除掉多余元素
 }
 
-template<typename Tp>
-void BList<Tp>::swap(BList &other) noexcept {
-    NodeBase *head = head_.next;
-    NodeBase *tail = head_.prev;
-
-    head_.next = other.head_.next;
-    other.head_.next->prev = &head_;
-    head_.prev = other.head_.prev;
-    other.head_.prev->next = &head_;
+template<typename Tp, typename Alloc>
+void BList<Tp, Alloc>::swap(BList &other) noexcept {
+    // 将 src 的所有节点挂到头节点 dst 上，空表需要特殊处理
+    auto relink = [](NodeBase &dst, NodeBase &src) {
+        if (src.next == &src) {
+            dst.next = dst.prev = &dst;
+        } else {
+            dst.next = src.next;
+            dst.prev = src.prev;
+            dst.next->prev = &dst;
+            dst.prev->next = &dst;
+        }
+    };
 
-    other.head_.next = head;
-    head->prev = &other.head_;
-    other.head_.prev = tail;
-    tail->next = &other.head_;
+    NodeBase tmp;
+    relink(tmp, head_);
+    relink(head_, other.head_);
+    relink(other.head_, tmp);
 
     std::swap(size_, other.size_);
+    if constexpr (NodeAllocTraits::propagate_on_container_swap::value) {
+        std::swap(alloc_(), other.alloc_());
+    }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Compare>
-void BList<Tp>::merge(BList &other, Compare cmp) {
+void BList<Tp, Alloc>::merge(BList &other, Compare cmp) {
     if (this == &other) return;
 
     NodeBase *l1 = head_.next;
@@ -699,8 +765,8 @@ void BList<Tp>::merge(BList &other, Compare cmp) {
     other.size_ = 0;
 }
 
-template<typename Tp>
-void BList<Tp>::remove(const Tp &val) {
+template<typename Tp, typename Alloc>
+void BList<Tp, Alloc>::remove(const Tp &val) {
     NodeBase *cur = head_.next;
     NodeBase *extra = nullptr;
     while (cur != &head_) {
@@ -722,9 +788,9 @@ void BList<Tp>::remove(const Tp &val) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Predicate>
-void BList<Tp>::remove_if(Predicate p) {
+void BList<Tp, Alloc>::remove_if(Predicate p) {
     NodeBase *cur = head_.next;
     while (cur != &head_) {
         NodeBase *tmp = nullptr;
@@ -738,9 +804,9 @@ void BList<Tp>::remove_if(Predicate p) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Predicate>
-void BList<Tp>::unique(Predicate p) {
+void BList<Tp, Alloc>::unique(Predicate p) {
     NodeBase *cur = head_.next->next;
     while (cur != &head_) {
         NodeBase *tmp = nullptr;
@@ -758,9 +824,9 @@ void BList<Tp>::unique(Predicate p) {
     }
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc>
 template<class Compare>
-void BList<Tp>::sort(Compare cmp) {
+void BList<Tp, Alloc>::sort(Compare cmp) {
     SizeType merge_len = 1;
     while (merge_len < size_) {
         NodeBase *p = head_.next;
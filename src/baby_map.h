@@ -7,16 +7,23 @@
 #ifndef CPPBABYSTL_BABY_MAP_H
 #define CPPBABYSTL_BABY_MAP_H
 
+/*
+ * @tparam Augment 增强策略，见 rb_tree.h 中的 RBTreeSizeAugment 等。包含
+ *   RBTreeAggregateAugment 时聚合结果可能依赖`值`：迭代器和 at 只给出`值`的常量引用，
+ *   operator[] 无法编译，修改`值`需要使用 assign / modify，它们会同时更新聚合结果
+ * */
 template<typename K, typename V,
-         typename Compare = std::less<K>>
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<std::pair<const K, V>>,
+         typename Augment = RBTreeNoAugment>  // 增强策略，见 rb_tree.h 中的 RBTreeSizeAugment 等
 class BMap {
 public:
-    using RBTree = RBTree<K, V, RBTreeMapNode<K, V>, Compare>;
-    using Iterator = typename RBTree::Iterator;
+    using TreeType = RBTree<K, V, RBTreeMapNode<K, V, Augment>, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
     using SizeType = std::size_t;
 
 private:
-    RBTree tree_;
+    TreeType tree_;
 
 // @{  // 各类构造函数 / 析构函数
 public:
@@ -24,11 +31,14 @@ public:
     // 默认构造函数
     BMap() = default;
 
-    // 拷贝构造函数
-    BMap(const BMap &other) {
-        for (const auto [k, v]: other.tree_) {
-            tree_.insert(true, k, v);
-        }
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BMap(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：other 中的元素已经有序，直接建立一棵平衡的树，时间复杂度为 O(n)
+    BMap(const BMap &other)
+            : tree_(std::allocator_traits<Alloc>::select_on_container_copy_construction(
+                    other.tree_.get_allocator())) {
+        tree_.assign_sorted(other.begin(), other.size());
     }
 
     // 移动构造函数
@@ -37,18 +47,13 @@ public:
 
     // 通过初始化列表进行构造
     BMap(std::initializer_list<std::pair<K, V>> init_list) {
-        for (const auto &[k, v]: init_list) {
-            tree_.insert(true, k, v);
-        }
+        tree_.insert_range(true, init_list.begin(), init_list.end());
     }
 
+    // [beg, end) 按`键`严格递增时，时间复杂度为 O(n)
     template<typename InputIter>
     BMap(InputIter beg, InputIter end) {
-        while (beg != end) {
-            auto &[k, v] = *beg;
-            tree_.insert(true, k, v);
-            ++beg;
-        }
+        tree_.insert_range(true, beg, end);
     }
 
     ~BMap() { tree_.clear(); }
@@ -62,10 +67,8 @@ public:
     BMap& operator=(const BMap &other) {
         if (this == &other) return *this;  // 防止自赋值
 
-        tree_.clear();
-        for (auto [k, v] : other) {
-            tree_.insert(true, k, v);
-        }
+        tree_.assign_sorted(other.begin(), other.size());
+        return *this;
     }
 
     // 重载移动赋值运函数
@@ -77,9 +80,7 @@ public:
     // 将一个初始化列表赋值给当前容器
     BMap& operator=(std::initializer_list<std::pair<K, V>> init_list) {
         tree_.clear();
-        for (const auto &[k, v] : init_list) {
-            tree_.insert(true, k, v);
-        }
+        tree_.insert_range(true, init_list.begin(), init_list.end());
         return *this;
     }
 // @} // 与赋值运算相关的操作
@@ -88,7 +89,8 @@ public:
 // @{ // 元素访问相关的操作
 public:
 
-    V& at(const K &key) {
+    // 含有聚合增强时只能得到常量引用，修改`值`需要使用 assign / modify
+    decltype(auto) at(const K &key) {
         auto iter = tree_.find(key);
         if (iter == tree_.end()) {
             throw std::out_of_range("BMap::at");
@@ -97,10 +99,16 @@ public:
     }
 
     const V& at(const K &key) const {
-        return this->at(key);
+        auto iter = tree_.find(key);
+        if (iter == tree_.end()) {
+            throw std::out_of_range("BMap::at");
+        }
+        return (*iter).second;
     }
 
     V& operator[](const K &key) {
+        static_assert(!rb_tree_has_aggregate_v<Augment>,
+                      "BMap::operator[] would leave subtree aggregates stale, use assign / modify instead");
         auto iter = tree_.get_or_insert(key);
         return (*iter).second;
     }
@@ -134,6 +142,9 @@ public:
     SizeType size() const noexcept {
         return tree_.size();
     }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
 // @}  // 容量相关的操作
 
 
@@ -153,19 +164,20 @@ public:
         return this->insert(value);
     }
 
+    // 以 hint 为提示插入，value 应当位于 hint 的前驱与 hint 之间，提示正确时均摊 O(1)
+    Iterator insert(Iterator hint, const std::pair<K, V> &value) {
+        auto &[k, v] = value;
+        return tree_.insert_hint(hint, true, k, v);
+    }
+
+    // 按`键`的升序插入时，每个元素都接在最大的元素之后，不需要从根节点开始查找
     template<typename InputIter>
     void insert(InputIter beg, InputIter end) {
-        while (beg != end) {
-            auto &[k, v] = *beg;
-            tree_.insert(true, k, v);
-            ++beg;
-        }
+        tree_.insert_range(true, beg, end);
     }
 
     void insert(std::initializer_list<std::pair<K, V>> init_list) {
-        for (const auto &[k, v] : init_list) {
-            tree_.insert(true, k, v);
-        }
+        tree_.insert_range(true, init_list.begin(), init_list.end());
     }
 
     template<typename ...Args>
@@ -180,6 +192,26 @@ public:
     emplace(K &&key, Args &&...args) {
         return this->emplace(key, std::forward<Args>(args)...);
     }
+
+    template<typename ...Args>
+    Iterator emplace_hint(Iterator hint, const K &key, Args &&...args) {
+        return tree_.insert_hint(hint, true, key, std::forward<Args>(args)...);
+    }
+
+    // 把 pos 指向的元素的`值`替换为 val，并重新计算增强数据
+    void assign(Iterator pos, const V &val) {
+        tree_.modify(pos, [&val](V &v) { v = val; });
+    }
+
+    void assign(Iterator pos, V &&val) {
+        tree_.modify(pos, [&val](V &v) { v = std::move(val); });
+    }
+
+    // 对 pos 指向的元素的`值`调用 func(val)，并重新计算增强数据，时间复杂度为 O(log n)
+    template<typename Func>
+    void modify(Iterator pos, Func func) {
+        tree_.modify(pos, func);
+    }
 // @}  // 向容器中添加元素相关的操作
 
 
@@ -194,10 +226,18 @@ public:
 
     void erase(K &&key) { tree_.remove(key); }
 
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器都不会失效
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    // 删除 [first, last) 中的元素，返回 last，不需要从根节点查找
+    Iterator erase(Iterator first, Iterator last) { return tree_.erase(first, last); }
+
+    // 删除所有满足 pred(*iter) 的元素，返回删除的元素数目，剩下的节点重新链接成平衡树，时间复杂度为 O(n)
+    template<typename Pred>
+    SizeType erase_if(Pred pred) { return tree_.erase_if(pred); }
+
     void swap(BMap &other) noexcept {
-        RBTree tmp = std::move(tree_);
-        tree_ = std::move(other.tree_);
-        other.tree_ = std::move(tmp);
+        tree_.swap(other.tree_);
     }
 // @}  // 在容器中删除元素相关的操作
 
@@ -207,7 +247,7 @@ public:
 
     // 返回键为`key`的元素数。由于BMap容器不允许存在相同的键，因此 count() 的
     // 返回值非 0 即 1。其中 0 表示不存在键`key`，1 表示存在键`key`
-    SizeType count(const K &key) {
+    SizeType count(const K &key) const {
         return tree_.find(key) != tree_.end();
     }
 
@@ -237,12 +277,95 @@ public:
     Iterator upper_bound(const K &key) const {
         return tree_.upper_bound(key);
     }
+
+    // 返回键为`key`的元素（至多一个）构成的区间，只向下查找一次
+    std::pair<Iterator, Iterator> equal_range(const K &key) const {
+        return tree_.equal_range(key);
+    }
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找，例如用 BStringView 查找 BString 类型的键，
+     * 而不必先构造一个临时的 K
+     * */
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return tree_.find(key) != tree_.end();
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) {
+        return tree_.upper_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const {
+        return tree_.upper_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        return tree_.equal_range(key);
+    }
 // @}  // 与查找相关的操作
+
+// @{  // 顺序统计，只有 Augment 为 RBTreeSizeAugment 时才能使用
+public:
+
+    // 返回`键`小于 key 的元素数目，即 lower_bound(key) 在遍历顺序中的下标，时间复杂度为 O(log n)
+    SizeType rank(const K &key) const {
+        return tree_.rank(key);
+    }
+
+    // 返回按`键`升序排列时下标为 k 的元素（第 k + 1 小）的迭代器，k >= size() 时返回 end()
+    Iterator select(SizeType k) const {
+        return tree_.select(k);
+    }
+
+    // 返回`键`位于闭区间 [lo, hi] 中的元素数目，时间复杂度为 O(log n)
+    SizeType count_range(const K &lo, const K &hi) const {
+        return tree_.count_range(lo, hi);
+    }
+// @}  // 顺序统计，只有 Augment 为 RBTreeSizeAugment 时才能使用
+
+
+// @{  // 子树聚合，只有 Augment 包含 RBTreeAggregateAugment 时才能使用
+public:
+
+    // 返回`键`小于 key 的所有元素按升序合并的结果，例如前缀和，时间复杂度为 O(log n)
+    auto prefix_aggregate(const K &key) const {
+        return tree_.prefix_aggregate(key);
+    }
+
+    // 返回`键`位于闭区间 [lo, hi] 中的所有元素按升序合并的结果，时间复杂度为 O(log n)
+    auto aggregate_range(const K &lo, const K &hi) const {
+        return tree_.aggregate_range(lo, hi);
+    }
+// @}  // 子树聚合，只有 Augment 包含 RBTreeAggregateAugment 时才能使用
 };
 
 // 判断两个 BMap 容器是否相等
-template<typename K, typename V, typename Compare>
-bool operator==(const BMap<K, V, Compare> &x, const BMap<K, V, Compare> &y) {
+template<typename K, typename V, typename Compare, typename Alloc, typename Augment>
+bool operator==(const BMap<K, V, Compare, Alloc, Augment> &x, const BMap<K, V, Compare, Alloc, Augment> &y) {
     if (x.size() != y.size()) return false;
 
     auto beg1 = x.begin();
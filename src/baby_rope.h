@@ -0,0 +1,328 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 适用于超大文本的绳（rope）结构 BRope
+//
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <iostream>
+#include <algorithm>
+#include "baby_string.h"
+#include "baby_string_view.h"
+
+#ifndef CPPBABYSTL_BABY_ROPE_H
+#define CPPBABYSTL_BABY_ROPE_H
+
+/*
+ * 绳：用一棵平衡二叉树表示一个长字符串，叶子节点保存文本片段，
+ * 中序遍历所有叶子即为完整的字符串
+ *
+ *   1. 节点创建后不再修改，多个 BRope 之间可以共享子树，复制 BRope 只需
+ *      增加根节点的引用计数
+ *   2. 叶子节点是某个共享缓冲区（BString）中的一段 [offset, offset + size)，
+ *      截取子串时只需要调整 offset 和 size，不复制任何字符
+ *   3. 整棵树按 AVL 的方式保持平衡（左右子树的高度差不超过 1），
+ *      拼接（join）和切分（split）都只沿一条路径重建节点，时间复杂度为 O(log n)
+ *   4. 两个总长度不超过 kLeafMerge 的叶子拼接时合并为一个新叶子，
+ *      避免逐字符追加时产生大量很小的叶子
+ * */
+class BRope {
+public:
+    using SizeType = std::size_t;
+
+    static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+    enum : SizeType {
+        kLeafMerge = 256  // 总长度不超过该值的两个叶子拼接时合并为一个叶子
+    };
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /*
+     * 树节点：left 为空时是叶子节点，否则是拼接节点
+     *
+     * 叶子节点：文本为 (*buf)[offset, offset + size)，height 为 0
+     * 拼接节点：文本为 left 的文本 + right 的文本
+     * */
+    struct Node {
+        SizeType size;
+        int height;
+        NodePtr left;
+        NodePtr right;
+        std::shared_ptr<const BString> buf;
+        SizeType offset;
+
+        bool is_leaf() const { return left == nullptr; }
+
+        // 叶子节点中的文本
+        BStringView text() const { return BStringView(buf->begin() + offset, size); }
+    };
+
+    NodePtr root_;
+
+    static int height_(const NodePtr &node) { return node == nullptr ? -1 : node->height; }
+
+    static SizeType size_(const NodePtr &node) { return node == nullptr ? 0 : node->size; }
+
+    // 创建一个指向 buf[offset, offset + n) 的叶子节点，n 为 0 时返回空树
+    static NodePtr make_leaf_(std::shared_ptr<const BString> buf, SizeType offset, SizeType n) {
+        if (n == 0) return nullptr;
+        return std::make_shared<const Node>(Node{n, 0, nullptr, nullptr, std::move(buf), offset});
+    }
+
+    // 复制 sv 中的字符，创建一个独占缓冲区的叶子节点
+    static NodePtr make_leaf_(BStringView sv) {
+        if (sv.empty()) return nullptr;
+        return make_leaf_(std::make_shared<const BString>(sv), 0, sv.size());
+    }
+
+    // 直接创建拼接节点，要求 left、right 非空且高度差不超过 1
+    static NodePtr make_concat_(NodePtr left, NodePtr right) {
+        SizeType size = left->size + right->size;
+        int height = std::max(left->height, right->height) + 1;
+        return std::make_shared<const Node>(
+                Node{size, height, std::move(left), std::move(right), nullptr, 0});
+    }
+
+    /*
+     * @brief 创建以 left、right 为左右子树的节点，并在需要时旋转
+     *
+     * 要求 left、right 非空，各自满足 AVL 性质，且高度差不超过 2。
+     * 与 AVL 树插入后的调整相同，最多需要两次旋转
+     * */
+    static NodePtr balance_(NodePtr left, NodePtr right) {
+        if (left->height > right->height + 1) {
+            // 左子树过高
+            const NodePtr &ll = left->left;
+            const NodePtr &lr = left->right;
+            if (ll->height >= lr->height) {
+                // 右旋
+                return make_concat_(ll, make_concat_(lr, std::move(right)));
+            }
+            // 先左旋再右旋
+            return make_concat_(make_concat_(ll, lr->left), make_concat_(lr->right, std::move(right)));
+        }
+        if (right->height > left->height + 1) {
+            // 右子树过高
+            const NodePtr &rl = right->left;
+            const NodePtr &rr = right->right;
+            if (rr->height >= rl->height) {
+                // 左旋
+                return make_concat_(make_concat_(std::move(left), rl), rr);
+            }
+            // 先右旋再左旋
+            return make_concat_(make_concat_(std::move(left), rl->left), make_concat_(rl->right, rr));
+        }
+        return make_concat_(std::move(left), std::move(right));
+    }
+
+    /*
+     * @brief 拼接两棵树，返回表示 left + right 的平衡树
+     *
+     * 沿较高一棵树的右（左）边界向下，直到子树高度与另一棵树相差不超过 1，
+     * 在该处拼接后逐层向上调整。时间复杂度为 O(|height(left) - height(right)| + 1)
+     * */
+    static NodePtr join_(const NodePtr &left, const NodePtr &right) {
+        if (left == nullptr) return right;
+        if (right == nullptr) return left;
+
+        if (left->height > right->height + 1) {
+            return balance_(left->left, join_(left->right, right));
+        }
+        if (right->height > left->height + 1) {
+            return balance_(join_(left, right->left), right->right);
+        }
+
+        // 两个短叶子直接合并
+        if (left->is_leaf() && right->is_leaf() && left->size + right->size <= kLeafMerge) {
+            auto buf = std::make_shared<BString>(left->text());
+            buf->append(right->text());
+            SizeType n = buf->size();
+            return make_leaf_(std::move(buf), 0, n);
+        }
+        return make_concat_(left, right);
+    }
+
+    /*
+     * @brief 把树切分为 [0, idx) 与 [idx, size()) 两棵树
+     *
+     * 只有从根到位置 idx 的路径上的节点需要重建，
+     * 路径两侧的子树通过 join_ 重新拼接，总代价为 O(log n)
+     * */
+    static std::pair<NodePtr, NodePtr> split_(const NodePtr &node, SizeType idx) {
+        if (node == nullptr) return {nullptr, nullptr};
+        if (idx == 0) return {nullptr, node};
+        if (idx >= node->size) return {node, nullptr};
+
+        if (node->is_leaf()) {
+            return {make_leaf_(node->buf, node->offset, idx),
+                    make_leaf_(node->buf, node->offset + idx, node->size - idx)};
+        }
+
+        SizeType left_size = node->left->size;
+        if (idx <= left_size) {
+            auto [a, b] = split_(node->left, idx);
+            return {std::move(a), join_(b, node->right)};
+        } else {
+            auto [a, b] = split_(node->right, idx - left_size);
+            return {join_(node->left, a), std::move(b)};
+        }
+    }
+
+    // 中序遍历 node 中的所有叶子
+    template<typename Func>
+    static void for_each_leaf_(const Node *node, Func &func) {
+        while (node != nullptr && !node->is_leaf()) {
+            for_each_leaf_(node->left.get(), func);
+            node = node->right.get();  // 右子树改为循环，减少递归深度
+        }
+        if (node != nullptr) func(node->text());
+    }
+
+    explicit BRope(NodePtr root) : root_(std::move(root)) {}
+
+public:
+
+    // 默认构造函数：创建一个空的 BRope
+    BRope() = default;
+
+    // 复制 sv 中的字符进行构造
+    BRope(BStringView sv) : root_(make_leaf_(sv)) {}
+
+    BRope(const char *s) : BRope(BStringView(s)) {}
+
+    // 接管 b_str 的空间进行构造，不复制字符
+    BRope(BString &&b_str) {
+        SizeType n = b_str.size();
+        root_ = make_leaf_(std::make_shared<const BString>(std::move(b_str)), 0, n);
+    }
+
+    BRope(const BString &b_str) : BRope(BStringView(b_str)) {}
+
+
+// @{  // 与容量和元素访问相关的操作
+public:
+
+    SizeType size() const { return size_(root_); }
+
+    bool empty() const { return root_ == nullptr; }
+
+    // 树的高度，空树为 -1，只有一个叶子时为 0
+    int height() const { return height_(root_); }
+
+    // 返回索引为 idx 的字符，时间复杂度为 O(log n)
+    char at(SizeType idx) const {
+        if (idx >= this->size()) {
+            throw std::out_of_range("BRope::at");
+        }
+        return (*this)[idx];
+    }
+
+    // 返回索引为 idx 的字符，不进行边界检查
+    char operator[](SizeType idx) const {
+        const Node *node = root_.get();
+        while (!node->is_leaf()) {
+            SizeType left_size = node->left->size;
+            if (idx < left_size) {
+                node = node->left.get();
+            } else {
+                idx -= left_size;
+                node = node->right.get();
+            }
+        }
+        return node->text()[idx];
+    }
+// @}  // 与容量和元素访问相关的操作
+
+
+// @{  // 拼接与截取
+public:
+
+    /*
+     * @brief 在末尾拼接另一个 BRope，两者共享子树，时间复杂度为 O(log n)
+     *
+     * BString、BStringView 和 c 风格字符串都可以隐式转换为 BRope，
+     * 因此也可以直接追加，追加时会复制其中的字符（BString 右值除外）
+     * */
+    BRope &append(const BRope &other) {
+        root_ = join_(root_, other.root_);
+        return *this;
+    }
+
+    BRope &operator+=(const BRope &other) { return this->append(other); }
+
+    friend BRope operator+(const BRope &lhs, const BRope &rhs) {
+        return BRope(join_(lhs.root_, rhs.root_));
+    }
+
+    /*
+     * @brief 截取从 idx 开始、长度至多为 n 的子串
+     * @return 与当前 BRope 共享叶子缓冲区的新 BRope，时间复杂度为 O(log n)
+     * @throw 当 idx > size() 时，抛出std::out_of_range异常
+     * */
+    BRope substr(SizeType idx, SizeType n = npos) const {
+        if (idx > this->size()) {
+            throw std::out_of_range("BRope::substr");
+        }
+        n = std::min(n, this->size() - idx);
+        NodePtr right = split_(root_, idx).second;
+        return BRope(split_(right, n).first);
+    }
+
+    // 在位置 idx 处插入 other，时间复杂度为 O(log n)
+    BRope &insert(SizeType idx, const BRope &other) {
+        if (idx > this->size()) {
+            throw std::out_of_range("BRope::insert");
+        }
+        auto [left, right] = split_(root_, idx);
+        root_ = join_(join_(left, other.root_), right);
+        return *this;
+    }
+
+    // 删除从 idx 开始的 n 个字符，时间复杂度为 O(log n)
+    BRope &erase(SizeType idx, SizeType n = npos) {
+        if (idx > this->size()) {
+            throw std::out_of_range("BRope::erase");
+        }
+        n = std::min(n, this->size() - idx);
+        auto [left, rest] = split_(root_, idx);
+        root_ = join_(left, split_(rest, n).second);
+        return *this;
+    }
+
+    void clear() { root_ = nullptr; }
+// @}  // 拼接与截取
+
+
+// @{  // 转换为连续的字符串
+public:
+
+    // 按顺序对每个叶子中的文本调用 func(BStringView)
+    template<typename Func>
+    void for_each_chunk(Func &&func) const {
+        for_each_leaf_(root_.get(), func);
+    }
+
+    // 拼接为一个连续的 BString，只分配一次内存
+    BString str() const {
+        BString ret;
+        ret.reserve(this->size());
+        this->for_each_chunk([&ret](BStringView sv) { ret.append(sv); });
+        return ret;
+    }
+
+    // 逐个叶子输出到流中
+    friend std::ostream &operator<<(std::ostream &os, const BRope &rope) {
+        rope.for_each_chunk([&os](BStringView sv) { os << sv; });
+        return os;
+    }
+// @}  // 转换为连续的字符串
+};
+
+#endif //CPPBABYSTL_BABY_ROPE_H
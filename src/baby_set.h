@@ -7,47 +7,50 @@
 #ifndef CPPBABYSTL_BABY_SET_H
 #define CPPBABYSTL_BABY_SET_H
 
-template<typename K, typename Compare = std::less<K>>
-class BMultiSet {
+template<typename K, typename Compare = std::less<K>,
+         typename Alloc = std::allocator<K>,
+         typename Augment = RBTreeNoAugment>  // 增强策略，见 rb_tree.h 中的 RBTreeSizeAugment 等
+class BSet {
 public:
-    using RBTree = RBTree<K, K, RBTreeSetNode<K>, Compare>;
-    using Iterator = typename RBTree::Iterator;
+    using TreeType = RBTree<K, K, RBTreeSetNode<K, Augment>, Compare, Alloc>;
+    using Iterator = typename TreeType::Iterator;
     using SizeType = std::size_t;
 
 private:
-    RBTree tree_;
+    TreeType tree_;
 
 // @{  // 各类构造函数 / 析构函数
 public:
 
     // 默认构造函数
-    BMultiSet() = default;
+    BSet() = default;
 
-    // 拷贝构造函数
-    BMultiSet(const BMultiSet &other) {
-        for (const K &key : other.tree_) {
-            tree_.insert(true, key);
-        }
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BSet(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：other 中的元素已经有序，直接建立一棵平衡的树，时间复杂度为 O(n)
+    BSet(const BSet &other)
+            : tree_(std::allocator_traits<Alloc>::select_on_container_copy_construction(
+                    other.tree_.get_allocator())) {
+        tree_.assign_sorted(other.begin(), other.size());
     }
 
     // 移动构造函数
-    BMultiSet(BMultiSet &&other) noexcept
+    BSet(BSet &&other) noexcept
             : tree_(std::move(other.tree_)) {}
 
     // 通过初始化列表构造对象
-    BMultiSet(std::initializer_list<K> init_list) {
-        for (const auto &it : init_list) tree_.insert(true, it);
+    BSet(std::initializer_list<K> init_list) {
+        tree_.insert_range(true, init_list.begin(), init_list.end());
     }
 
+    // [beg, end) 严格递增时，时间复杂度为 O(n)
     template<typename InputIter>
-    BMultiSet(InputIter beg, InputIter end) {
-        while (beg != end) {
-            tree_.insert(true, *beg);
-            ++beg;
-        }
+    BSet(InputIter beg, InputIter end) {
+        tree_.insert_range(true, beg, end);
     }
 
-    ~BMultiSet() { tree_.clear(); }
+    ~BSet() { tree_.clear(); }
 // @}  // 各类构造函数 / 析构函数
 
 
@@ -55,25 +58,24 @@ public:
 public:
 
     // 拷贝赋值函数
-    BMultiSet& operator=(const BMultiSet &other) {
+    BSet& operator=(const BSet &other) {
         if (this == &other) return *this;
 
-        tree_.clear();
-        for (const auto &key : other.tree_)
-            tree_.insert(true, key);
+        tree_.assign_sorted(other.begin(), other.size());
         return *this;
     }
 
     // 移动赋值函数
-    BMultiSet& operator=(BMultiSet &&other) noexcept {
+    BSet& operator=(BSet &&other) noexcept {
         tree_ = std::move(other.tree_);
         return *this;
     }
 
     // 通过初始化列表赋值
-    BMultiSet& operator=(std::initializer_list<K> init_list) {
+    BSet& operator=(std::initializer_list<K> init_list) {
         tree_.clear();
-        for (const auto &it : init_list) tree_.insert(true, it);
+        tree_.insert_range(true, init_list.begin(), init_list.end());
+        return *this;
     }
 // @}  // 赋值运算符相关操作
 
@@ -100,6 +102,9 @@ public:
     SizeType size() const {
         return tree_.size();
     }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return tree_.get_allocator(); }
 // @}  // 与容量相关的操作
 
 
@@ -114,17 +119,19 @@ public:
         return {tree_.insert(true, key), true};
     }
 
+    // 以 hint 为提示插入，key 应当位于 hint 的前驱与 hint 之间，提示正确时均摊 O(1)
+    Iterator insert(Iterator hint, const K &key) {
+        return tree_.insert_hint(hint, true, key);
+    }
+
+    // 按升序插入时，每个元素都接在最大的元素之后，不需要从根节点开始查找
     template <typename InputIter>
     void insert(InputIter beg, InputIter end) {
-        while (beg != end) {
-            tree_.insert(true, *beg);
-            ++beg;
-        }
+        tree_.insert_range(true, beg, end);
     }
 
     void insert(std::initializer_list<K> init_list) {
-        for (const auto &it : init_list)
-            tree_.insert(true, it);
+        tree_.insert_range(true, init_list.begin(), init_list.end());
     }
 // @}  // 向容器中增加元素相关的操作
 
@@ -135,16 +142,24 @@ public:
     void erase(const K &key) { tree_.remove(key); }
     void erase(K &&key) { tree_.remove(key); }
 
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器都不会失效
+    Iterator erase(Iterator pos) { return tree_.erase(pos); }
+
+    // 删除 [first, last) 中的元素，返回 last，不需要从根节点查找
+    Iterator erase(Iterator first, Iterator last) { return tree_.erase(first, last); }
+
+    // 删除所有满足 pred(*iter) 的元素，返回删除的元素数目，剩下的节点重新链接成平衡树，时间复杂度为 O(n)
+    template<typename Pred>
+    SizeType erase_if(Pred pred) { return tree_.erase_if(pred); }
+
     void clear() { tree_.clear(); }
 // @}  // 向容器中删除元素的相关操作
 
 
 public:
     // 交换两个容器中的内容
-    void swap(BMultiSet &other) noexcept {
-        RBTree tmp = std::move(tree_);
-        tree_ = std::move(other.tree_);
-        other.tree_ = std::move(tmp);
+    void swap(BSet &other) noexcept {
+        tree_.swap(other.tree_);
     }
 
 
@@ -183,13 +198,96 @@ public:
     Iterator upper_bound(const K &key) const {
         return tree_.upper_bound(key);
     }
+
+    // 返回`键`为`key`的元素（至多一个）构成的区间，只向下查找一次
+    std::pair<Iterator, Iterator> equal_range(const K &key) const {
+        return tree_.equal_range(key);
+    }
+    /*
+     * 异构查找：当 Compare 是透明比较器（如 std::less<>）时，可以直接使用
+     * 与 K 可比较的其他类型查找，例如用 BStringView 查找 BString 类型的键，
+     * 而不必先构造一个临时的 K
+     * */
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return tree_.find(key) != tree_.end();
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return tree_.find(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const {
+        return tree_.lower_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) {
+        return tree_.upper_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const {
+        return tree_.upper_bound(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        return tree_.equal_range(key);
+    }
 // @}  // 与元素查找相关的操作
+
+// @{  // 顺序统计，只有 Augment 为 RBTreeSizeAugment 时才能使用
+public:
+
+    // 返回`键`小于 key 的元素数目，即 lower_bound(key) 在遍历顺序中的下标，时间复杂度为 O(log n)
+    SizeType rank(const K &key) const {
+        return tree_.rank(key);
+    }
+
+    // 返回按`键`升序排列时下标为 k 的元素（第 k + 1 小）的迭代器，k >= size() 时返回 end()
+    Iterator select(SizeType k) const {
+        return tree_.select(k);
+    }
+
+    // 返回`键`位于闭区间 [lo, hi] 中的元素数目，时间复杂度为 O(log n)
+    SizeType count_range(const K &lo, const K &hi) const {
+        return tree_.count_range(lo, hi);
+    }
+// @}  // 顺序统计，只有 Augment 为 RBTreeSizeAugment 时才能使用
+
+
+// @{  // 子树聚合，只有 Augment 包含 RBTreeAggregateAugment 时才能使用
+public:
+
+    // 返回`键`小于 key 的所有元素按升序合并的结果，例如前缀和，时间复杂度为 O(log n)
+    auto prefix_aggregate(const K &key) const {
+        return tree_.prefix_aggregate(key);
+    }
+
+    // 返回`键`位于闭区间 [lo, hi] 中的所有元素按升序合并的结果，时间复杂度为 O(log n)
+    auto aggregate_range(const K &lo, const K &hi) const {
+        return tree_.aggregate_range(lo, hi);
+    }
+// @}  // 子树聚合，只有 Augment 包含 RBTreeAggregateAugment 时才能使用
 };
 
 
 
-template<typename K, typename Compare>
-bool operator==(const BMultiSet<K, Compare> &x, const BMultiSet<K, Compare> &y) {
+template<typename K, typename Compare, typename Alloc, typename Augment>
+bool operator==(const BSet<K, Compare, Alloc, Augment> &x, const BSet<K, Compare, Alloc, Augment> &y) {
     if (x.size() != y.size()) return false;
 
     auto beg1 = x.begin();
@@ -0,0 +1,195 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 引用计数的不可变字符串 BSharedString
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <iostream>
+#include <functional>
+#include "baby_hash.h"
+#include "baby_string.h"
+#include "baby_string_view.h"
+#include "baby_type_traits.h"
+
+#ifndef CPPBABYSTL_BABY_SHARED_STRING_H
+#define CPPBABYSTL_BABY_SHARED_STRING_H
+
+/*
+ * 不可变的共享字符串
+ *
+ * 对象本身只有一个指针，指向堆上的一块内存：头部保存引用计数、长度和
+ * 预先计算好的哈希值，紧接着是字符本身（以'\0'结尾）。复制只需要原子地
+ * 增加引用计数，时间复杂度为 O(1)，适合同一个长字符串被放进大量容器节点
+ * （如 BMap 的键、BVector 的元素）的场景
+ *
+ *   1. 内容在构造后不能修改，因此多个线程可以同时读取、复制和销毁
+ *      指向同一块内存的不同 BSharedString 对象
+ *   2. 空字符串不申请内存，指针为 nullptr
+ *   3. 比较相等时先比较指针和哈希值，只有两者都无法判断时才比较字符
+ * */
+class BSharedString {
+public:
+    using SizeType = std::size_t;
+
+private:
+    // 堆上的头部，字符紧跟在头部之后
+    struct Rep {
+        std::atomic<std::uint32_t> refs;
+        SizeType size;
+        std::uint64_t hash;
+
+        char *chars() { return reinterpret_cast<char *>(this + 1); }
+    };
+
+    Rep *rep_{};
+
+    // 申请一块能容纳 n 个字符的内存并复制 s，引用计数为 1
+    static Rep *create_(const char *s, SizeType n) {
+        if (n == 0) return nullptr;
+
+        void *mem = ::operator new(sizeof(Rep) + n + 1);
+        Rep *rep = new(mem) Rep{{1}, n, BHash::bytes(s, n)};
+        memcpy(rep->chars(), s, n);
+        rep->chars()[n] = '\0';
+        return rep;
+    }
+
+    void retain_() const noexcept {
+        if (rep_ != nullptr) rep_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 引用计数减为 0 时释放内存
+    void release_() noexcept {
+        if (rep_ != nullptr && rep_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            rep_->~Rep();
+            ::operator delete(rep_);
+        }
+        rep_ = nullptr;
+    }
+
+public:
+
+    // 默认构造函数：创建一个空字符串
+    BSharedString() noexcept = default;
+
+    // 复制 sv 中的字符进行构造，同时计算哈希值
+    explicit BSharedString(BStringView sv) : rep_(create_(sv.data(), sv.size())) {}
+
+    explicit BSharedString(const BString &b_str) : BSharedString(BStringView(b_str)) {}
+
+    explicit BSharedString(const char *s) : BSharedString(BStringView(s)) {}
+
+    // 拷贝构造函数：只增加引用计数
+    BSharedString(const BSharedString &other) noexcept : rep_(other.rep_) {
+        retain_();
+    }
+
+    // 移动构造函数：接管 other 的引用，other 变为空字符串
+    BSharedString(BSharedString &&other) noexcept : rep_(std::exchange(other.rep_, nullptr)) {}
+
+    BSharedString &operator=(const BSharedString &other) noexcept {
+        // 先增加再减少，自赋值时也是安全的
+        Rep *rep = other.rep_;
+        other.retain_();
+        release_();
+        rep_ = rep;
+        return *this;
+    }
+
+    BSharedString &operator=(BSharedString &&other) noexcept {
+        if (this == &other) return *this;
+        release_();
+        rep_ = std::exchange(other.rep_, nullptr);
+        return *this;
+    }
+
+    ~BSharedString() { release_(); }
+
+
+// @{  // 访问内容
+public:
+
+    SizeType size() const noexcept { return rep_ == nullptr ? 0 : rep_->size; }
+
+    bool empty() const noexcept { return rep_ == nullptr; }
+
+    // 返回以'\0'结尾的字符数组
+    const char *c_str() const noexcept { return rep_ == nullptr ? "" : rep_->chars(); }
+
+    const char *data() const noexcept { return this->c_str(); }
+
+    const char *begin() const noexcept { return this->c_str(); }
+
+    const char *end() const noexcept { return this->c_str() + this->size(); }
+
+    // 返回索引为 idx 的字符，不进行边界检查
+    char operator[](SizeType idx) const { return rep_->chars()[idx]; }
+
+    // 构造时预先计算好的哈希值，与 BHash::bytes(data(), size()) 相同
+    std::uint64_t hash() const noexcept {
+        return rep_ == nullptr ? BHash::bytes(nullptr, 0) : rep_->hash;
+    }
+
+    // 共享同一块内存的对象数目，空字符串返回 0
+    SizeType use_count() const noexcept {
+        return rep_ == nullptr ? 0 : rep_->refs.load(std::memory_order_relaxed);
+    }
+
+    // 转换为字符串视图，视图在最后一个共享者销毁前有效
+    operator BStringView() const noexcept { return BStringView(this->data(), this->size()); }
+
+    // 复制为可修改的 BString
+    BString str() const { return BString(BStringView(*this)); }
+// @}  // 访问内容
+
+
+// @{  // 比较操作
+public:
+
+    /*
+     * 两个 BSharedString 之间比较相等：指向同一块内存时直接相等，
+     * 哈希值不同时直接不等，只有哈希值相同时才需要比较字符
+     *
+     * 与 BString、c 风格字符串等其他类型之间的比较使用 baby_string_view.h
+     * 中的运算符
+     * */
+    friend bool operator==(const BSharedString &lhs, const BSharedString &rhs) noexcept {
+        if (lhs.rep_ == rhs.rep_) return true;
+        if (lhs.rep_ == nullptr || rhs.rep_ == nullptr) return false;
+        if (lhs.rep_->hash != rhs.rep_->hash) return false;
+        return BStringView(lhs) == BStringView(rhs);
+    }
+
+    friend bool operator!=(const BSharedString &lhs, const BSharedString &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const BSharedString &s) {
+        return os << BStringView(s);
+    }
+// @}  // 比较操作
+};
+
+static_assert(sizeof(BSharedString) == sizeof(void *), "BSharedString should hold a single pointer");
+
+// BSharedString 只持有一个堆指针，BVector 扩容时可以直接按字节搬迁
+template<>
+struct b_is_trivially_relocatable<BSharedString> : std::true_type {};
+
+// 直接返回预先计算好的哈希值
+namespace std {
+template<>
+struct hash<BSharedString> {
+    size_t operator()(const BSharedString &s) const noexcept {
+        return static_cast<size_t>(s.hash());
+    }
+};
+}  // namespace std
+
+#endif //CPPBABYSTL_BABY_SHARED_STRING_H
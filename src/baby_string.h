@@ -6,6 +6,17 @@
 #include <initializer_list>
 #include <iostream>
 #include <cstring>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <functional>
+#include "baby_charconv.h"
+#include "baby_hash.h"
+#include "baby_string_search.h"
+#include "baby_string_transform.h"
+#include "baby_string_view.h"
+#include "baby_vector.h"
+#include "baby_type_traits.h"
 
 #ifndef CPPBABYSTL_BABY_STRING_H
 #define CPPBABYSTL_BABY_STRING_H
@@ -19,20 +30,105 @@ public:
     static const SizeType npos = static_cast<SizeType>(-1);
 
 private:
-    char *ptr_;
-    SizeType str_len_{};  // 字符串长度
-    enum {
-        kLocalCapacity = 15
-    };  // 小字符串的长度
+    /*
+     * 内存布局（共 24 字节，参考 fbstring / libc++）：
+     *
+     *   短字符串：local_buf_[0, 23) 存放字符，最后一个字节存放
+     *            kLocalCapacity - size()。长度恰好为 23 时最后一个字节为 0，
+     *            同时充当结尾的'\0'
+     *   长字符串：heap_ 存放堆指针、长度和容量，容量中编码了一个标记位，
+     *            该标记位恰好落在整个对象的最后一个字节的最高位
+     *
+     * 两种状态通过最后一个字节的最高位区分，对象中不包含指向自身的指针，
+     * 因此 BString 可以平凡重定位。长字符串的最后一个字节中还有一个标记位
+     * 表示缓冲区末尾是否缓存了哈希值，见 cache_hash
+     * */
+    struct Heap {
+        char *data;     // 堆上的空间，实际大小为容量 + 1，其中1表示最后一位存储'\0'
+        SizeType size;  // 字符串长度
+        SizeType cap;   // 经过 encode_cap_ 编码的容量
+    };
 
-    union {
-        char local_buf_[kLocalCapacity + 1]{};
+    enum : SizeType {
+        kLocalCapacity = sizeof(Heap) - 1  // 小字符串的长度
+    };
 
-        // 在堆上分配的空间，实际空间为 allocated_capacity_ + 1
-        // 其中1表示最后一位存储'\0'
-        SizeType allocated_capacity_;
+    enum : unsigned char {
+        kHeapFlag = 0x80,  // 最后一个字节中表示“长字符串”的标记位
+        kHashFlag = 0x40   // 最后一个字节中表示“已缓存哈希值”的标记位，只用于长字符串
     };
 
+    union {
+        Heap heap_;
+        char local_buf_[kLocalCapacity + 1];
+    };
+
+    // @{  // 容量的编码：将标记位放在 cap 所在内存的最后一个字节的最高位
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // 大端：最后一个字节是最低位字节，容量整体左移 8 位
+    static constexpr SizeType kCapHashFlag = kHashFlag;
+    static SizeType encode_cap_(SizeType cap) { return (cap << 8) | kHeapFlag; }
+    static SizeType decode_cap_(SizeType cap) { return cap >> 8; }
+#else
+    // 小端：最后一个字节是最高位字节
+    static constexpr SizeType kCapFlag = SizeType(kHeapFlag) << (8 * (sizeof(SizeType) - 1));
+    static constexpr SizeType kCapHashFlag = SizeType(kHashFlag) << (8 * (sizeof(SizeType) - 1));
+    static SizeType encode_cap_(SizeType cap) { return cap | kCapFlag; }
+    static SizeType decode_cap_(SizeType cap) { return cap & ~(kCapFlag | kCapHashFlag); }
+#endif
+    // @}
+
+    // 判断字符串是否存放在 local_buf_ 中
+    bool is_local_() const {
+        return (static_cast<unsigned char>(local_buf_[kLocalCapacity]) & kHeapFlag) == 0;
+    }
+
+    // 返回字符串首字符的地址
+    char *data_() const {
+        return is_local_() ? const_cast<char *>(local_buf_) : heap_.data;
+    }
+
+    // 修改字符串的长度，并在末尾写入'\0'，同时使缓存的哈希值失效
+    void set_size_(SizeType n) {
+        if (is_local_()) {
+            local_buf_[n] = '\0';
+            local_buf_[kLocalCapacity] = static_cast<char>(kLocalCapacity - n);
+        } else {
+            heap_.data[n] = '\0';
+            heap_.size = n;
+            heap_.cap &= ~kCapHashFlag;
+        }
+    }
+
+    // 内容可能被修改时调用，使缓存的哈希值失效
+    void invalidate_hash_() {
+        if (!is_local_()) heap_.cap &= ~kCapHashFlag;
+    }
+
+    // 判断长字符串的缓冲区末尾是否缓存了哈希值
+    bool hash_cached_() const {
+        return !is_local_() && (heap_.cap & kCapHashFlag) != 0;
+    }
+
+    // 缓存哈希值的位置：缓冲区（大小为容量 + 1）的最后 8 个字节
+    char *hash_slot_() const {
+        return heap_.data + decode_cap_(heap_.cap) + 1 - sizeof(std::uint64_t);
+    }
+
+    // 将字符串置为空的短字符串，不释放内存
+    void set_empty_() {
+        local_buf_[0] = '\0';
+        local_buf_[kLocalCapacity] = static_cast<char>(kLocalCapacity);
+    }
+
+    // 切换为使用堆空间 data（容量为 cap）的长字符串，长度为 n
+    void set_heap_(char *data, SizeType n, SizeType cap) {
+        heap_.data = data;
+        heap_.size = n;
+        heap_.cap = encode_cap_(cap);
+        data[n] = '\0';
+    }
+
 private:
 
     /*
@@ -58,11 +154,12 @@ private:
         // 重新分配内存
         auto tmp = creat_(new_capacity);
 
-        // 将原来的字符串拷贝到新内存中
-        strcpy(tmp, ptr_);
+        // 将原来的字符串拷贝到新内存中：长度已知，只复制有效字符，
+        // 中间的'\0'也会被保留
+        SizeType len = this->size();
+        memcpy(tmp, data_(), len);
         destroy_();  // 释放原来的内存
-        ptr_ = tmp;
-        allocated_capacity_ = new_capacity;
+        set_heap_(tmp, len, new_capacity);
     }
 
 
@@ -75,53 +172,53 @@ private:
      * */
     void construct_(const char *s, SizeType n);
 
-    // 销毁 ptr_ 指向的堆空间
+    // 释放堆空间（如果有），之后字符串变为空的短字符串
     void destroy_() {
-        if (ptr_ == local_buf_) return;
-        delete[] ptr_;
-        ptr_ = local_buf_;
-        str_len_ = 0;
+        if (!is_local_()) delete[] heap_.data;
+        set_empty_();
     }
 
 public:
 
     // 默认构造函数：创建一个空字符串
-    BString() : ptr_(local_buf_), str_len_(0) {
-        ptr_[0] = '\0';
-    }
+    BString() { set_empty_(); }
 
     // 拷贝构造函数
-    BString(const BString &b_str) : ptr_(local_buf_) {
-        construct_(b_str.ptr_, b_str.str_len_);
+    BString(const BString &b_str) {
+        construct_(b_str.data_(), b_str.size());
     }
 
     // 移动构造函数
     BString(BString &&b_str) noexcept;
 
     // 通过 std::string 对象进行构造
-    explicit BString(const std::string &str)
-            : ptr_(local_buf_) {
+    explicit BString(const std::string &str) {
         construct_(str.c_str(), str.size());
     }
 
-    // 通过 c 风格字符串进行构造
-    explicit BString(const char *s, SizeType n)
-            : ptr_(local_buf_) {
-        SizeType len = strlen(s);
-        if (n == npos || n > len) {
-            n = len;
-        }
+    /*
+     * @brief 使用字符数组 s 的前 n 个字符进行构造
+     *
+     * 与 std::string 一致，复制恰好 n 个字符，其中可以包含'\0'（二进制数据）；
+     * n 为 npos 时按 c 风格字符串处理，长度由 strlen 确定
+     * */
+    explicit BString(const char *s, SizeType n) {
+        if (n == npos) n = strlen(s);
         construct_(s, n);
     }
 
     // 通过 c 风格字符串进行构造
-    BString(const char *s)
-            : ptr_(local_buf_) {
+    BString(const char *s) {
         construct_(s, strlen(s));
     }
 
+    // 通过字符串视图进行构造，视图中可以包含'\0'
+    explicit BString(BStringView sv) {
+        construct_(sv.data(), sv.size());
+    }
+
     // 通过 std::string 进行移动构造
-    explicit BString(std::string &&str) : ptr_(local_buf_) {
+    explicit BString(std::string &&str) {
         // 无法修改_str中的内容，因此和 BString(const std::string& str)
         // 操作一样
         construct_(str.c_str(), str.size());
@@ -132,25 +229,23 @@ public:
      * @param n 字符的数目
      * @param c 使用的单个字符
      * */
-    BString(SizeType n, char c) : ptr_(local_buf_) {
+    BString(SizeType n, char c) {
         if (n > kLocalCapacity) {
-            ptr_ = new char[n + 1]{};
-            allocated_capacity_ = n;
+            set_heap_(new char[n + 1], n, n);
+        } else {
+            set_empty_();
+            set_size_(n);
         }
 
         // 复制字符
-        for (SizeType i = 0; i < n; i++) {
-            ptr_[i] = c;
-        }
-        ptr_[n] = '\0';
-        str_len_ = n;
+        memset(data_(), c, n);
     }
 
     /*
      * @brief 通过初始化列表进行构造
      * @param init_list 初始化列表
      * */
-    BString(std::initializer_list<char> init_list) : ptr_(local_buf_) {
+    BString(std::initializer_list<char> init_list) {
         construct_(init_list.begin(), init_list.size());
     }
 
@@ -175,7 +270,7 @@ public:
     BString & operator=(const BString &b_str) {
         if (this == &b_str) return *this;  // 防止自赋值
 
-        assign_(b_str.ptr_, b_str.str_len_);
+        assign_(b_str.data_(), b_str.size());
         return *this;
     }
 
@@ -200,6 +295,12 @@ public:
         assign_(s, strlen(s));
         return *this;
     }
+
+    // 通过字符串视图进行拷贝赋值
+    BString & operator=(BStringView sv) {
+        assign_(sv.data(), sv.size());
+        return *this;
+    }
 // @}  // 与赋值相关的操作
 
 
@@ -207,10 +308,11 @@ public:
 public:
     // 直接使用 `数组首地址` 作为迭代器即可
 
-    char* begin() { return ptr_; }
-    char* begin() const {return ptr_; }
-    char* end() { return ptr_ + this->size(); }
-    char* end() const { return ptr_ + this->size(); }
+    // 非 const 版本返回的迭代器可以修改字符，因此会使缓存的哈希值失效
+    char* begin() { invalidate_hash_(); return data_(); }
+    char* begin() const {return data_(); }
+    char* end() { invalidate_hash_(); return data_() + this->size(); }
+    char* end() const { return data_() + this->size(); }
 // @}  //  与迭代器相关的操作
 
 
@@ -218,18 +320,42 @@ public:
 public:
 
     // 返回BString中字符的数目
-    SizeType size() const { return str_len_; }
+    SizeType size() const {
+        return is_local_() ?
+               kLocalCapacity - static_cast<unsigned char>(local_buf_[kLocalCapacity]) : heap_.size;
+    }
 
     // @brief 返回BString的存储空间
     SizeType capacity() const {
-        return ptr_ == local_buf_ ?
-               kLocalCapacity : allocated_capacity_;
+        return is_local_() ?
+               SizeType(kLocalCapacity) : decode_cap_(heap_.cap);
     }
 
     // 判断字符串是否为空
     bool empty() const {
         return this->size() == 0;
     }
+
+    /*
+     * @brief 预留至少能容纳 n 个字符的空间
+     *
+     * 与扩容不同，reserve 按 n 精确分配，适合在已知最终长度时（如拼接大量片段）
+     * 一次性分配，之后的 append 不再触发重新分配
+     * */
+    void reserve(SizeType n) {
+        if (n <= this->capacity()) return;
+
+        SizeType len = this->size();
+        char *tmp = new char[n + 1];
+        memcpy(tmp, data_(), len);
+        destroy_();
+        set_heap_(tmp, len, n);
+    }
+
+    // 清空字符串，保留已经分配的空间
+    void clear() noexcept {
+        set_size_(0);
+    }
 // @}  // 与容器容量相关的操作
 
 
@@ -241,17 +367,25 @@ public:
         if (idx >= this->size()) {
             throw std::out_of_range("BString::operator[]: Index out of range");
         }
-        return ptr_[idx];
+        return data_()[idx];
     }
 
-    // 重载[]操作符
+    // 重载[]操作符，返回的引用可以修改字符，因此会使缓存的哈希值失效
     char & operator[](SizeType idx) {
-        if (idx >= str_len_) {
+        if (idx >= this->size()) {
             throw std::out_of_range("BString::operator[]: Index out of range");
         }
-        return ptr_[idx];
+        invalidate_hash_();
+        return data_()[idx];
     }
 
+    // 返回以'\0'结尾的字符数组
+    const char *c_str() const { return data_(); }
+
+    // 返回底层字符数组，[data(), data() + size()) 为有效范围
+    const char *data() const { return data_(); }
+    char *data() { invalidate_hash_(); return data_(); }
+
     // 返回字符串第一个字符的引用
     const char & front() const noexcept {
         return operator[](0);
@@ -284,11 +418,31 @@ private:
      * */
     void append_(const char *s, SizeType n);
 
+    /*
+     * @brief 在末尾追加 write(first) 写入的字符，write 返回写入结束的位置
+     * @param max_n write 最多写入的字符数
+     *
+     * 剩余空间足够时直接写入当前字符串的空间，不需要临时缓冲区；否则先写入
+     * 栈上的缓冲区再按 append_ 的方式扩容，避免短字符串仅仅因为预留了
+     * max_n 个字符而被迫改用堆空间
+     * */
+    template<SizeType max_n, typename Write>
+    void append_formatted_(Write write) {
+        SizeType len = this->size();
+        if (this->capacity() - len >= max_n) {
+            char *last = write(data_() + len);
+            set_size_(static_cast<SizeType>(last - data_()));
+        } else {
+            char buf[max_n];
+            append_(buf, static_cast<SizeType>(write(buf) - buf));
+        }
+    }
+
 public:
 
     // 向当前字符串末尾追加一个 BString 类型的字符串
     BString & append(const BString &b_str) {
-        append_(b_str.ptr_, b_str.size());
+        append_(b_str.data_(), b_str.size());
         return *this;
     }
 
@@ -304,6 +458,12 @@ public:
         return *this;
     }
 
+    // 向当前字符串末尾追加一个字符串视图
+    BString & append(BStringView sv) {
+        append_(sv.data(), sv.size());
+        return *this;
+    }
+
     // 向当前BString末尾追加一个字符
     BString & push_back(char c) {
         append_(&c, 1);
@@ -325,10 +485,36 @@ public:
         return this->append(s);
     }
 
+    // 重载 += 操作符
+    BString & operator+=(BStringView sv) {
+        return this->append(sv);
+    }
+
     // 重载+=操作符
     BString & operator+=(char c) {
         return this->push_back(c);
     }
+
+    /*
+     * @brief 向末尾追加整数 v 的十进制表示
+     *
+     * 不经过 std::to_string 产生的临时字符串，见 append_formatted_
+     * */
+    template<typename Int, typename std::enable_if<std::is_integral<Int>::value, int>::type = 0>
+    BString & append_int(Int v) {
+        append_formatted_<BCharConv::kMaxIntChars>([v](char *first) { return BCharConv::write_int(first, v); });
+        return *this;
+    }
+
+    /*
+     * @brief 向末尾追加浮点数 v 的最短十进制表示
+     *
+     * 结果能被 parse_double 精确解析回 v，格式见 BCharConv::write_double
+     * */
+    BString & append_double(double v) {
+        append_formatted_<BCharConv::kMaxDoubleChars>([v](char *first) { return BCharConv::write_double(first, v); });
+        return *this;
+    }
 // @}  // 向容器中增加元素相关的操作
 
 
@@ -365,8 +551,7 @@ public:
         }
         if (n == npos) {
             // idx之后的字符 ==> 全部删除
-            str_len_ = idx;
-            ptr_[idx] = '\0';
+            set_size_(idx);
         } else if (n != 0) {
             n = std::min(this->size() - idx, n);
             erase_(idx, n);
@@ -394,11 +579,32 @@ private:
      * @param s 待匹配的模式串
      * @param n 模式串 s 的长度
      *
-     * 采用KMP算法实现，时间复杂度O(m + n), 空间复杂度O(m + n), 参考
-     * 链接：https://oi-wiki.org/string/kmp/, 标准库采用暴力算法实
-     * 现，时间复杂度为O(m * n), 空间复杂度为O(1)
+     * 具体算法见 BStringSearch::find：短模式串使用 SIMD 首尾字节过滤，
+     * 长模式串使用 Horspool 算法，整个过程不申请内存
      * */
-    SizeType find_(SizeType beg, SizeType end, const char *s, SizeType n) const;
+    SizeType find_(SizeType beg, SizeType end, const char *s, SizeType n) const {
+        SizeType pos = BStringSearch::find(data_() + beg, end - beg, s, n);
+        return pos == npos ? npos : beg + pos;
+    }
+
+    /*
+     * @brief 查找模式串 s 最后一次出现的索引，匹配的起点不超过 idx
+     * @param s 待匹配的模式串
+     * @param n 模式串 s 的长度
+     * @param idx 匹配起点的上限
+     * */
+    SizeType rfind_(const char *s, SizeType n, SizeType idx) const {
+        if (n > this->size()) return npos;
+        SizeType len = std::min(idx, this->size() - n) + n;
+        return BStringSearch::rfind(data_(), len, s, n);
+    }
+
+    // 在[idx, size())中查找第一个属于字符集合 s 的字符
+    SizeType find_first_of_(const char *s, SizeType n, SizeType idx) const {
+        if (idx >= this->size()) return npos;
+        SizeType pos = BStringSearch::find_first_of(data_() + idx, this->size() - idx, s, n);
+        return pos == npos ? npos : idx + pos;
+    }
 
 public:
 
@@ -409,7 +615,7 @@ public:
      * */
     SizeType find(const BString &b_str, SizeType idx = 0) const {
         if (idx >= this->size()) return npos;
-        return find_(idx, this->size(), b_str.ptr_, b_str.size());
+        return find_(idx, this->size(), b_str.data_(), b_str.size());
     }
 
     /*
@@ -432,6 +638,114 @@ public:
         return find_(idx, this->size(), s, strlen(s));
     }
 
+    /*
+     * @brief 在[idx, size())中查找子串 sv 首次出现的位置
+     * @param sv 待匹配的模式串
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find(BStringView sv, SizeType idx = 0) const {
+        if (idx >= this->size()) return npos;
+        return find_(idx, this->size(), sv.data(), sv.size());
+    }
+
+    // 在[idx, size())中查找字符 c 首次出现的位置
+    SizeType find(char c, SizeType idx = 0) const {
+        if (idx >= this->size()) return npos;
+        return find_(idx, this->size(), &c, 1);
+    }
+
+    /*
+     * @brief 使用预编译的模式串在[idx, size())中查找
+     * @param searcher 预编译的模式串，可以在多个主串之间复用
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find(const BStringSearcher &searcher, SizeType idx = 0) const {
+        if (idx >= this->size()) return npos;
+        return searcher.search(data_(), this->size(), idx);
+    }
+
+    /*
+     * @brief 查找子串 b_str 最后一次出现的位置
+     * @param b_str 待匹配的模式串
+     * @param idx 匹配的起始位置不超过 idx，默认查找整个字符串
+     * */
+    SizeType rfind(const BString &b_str, SizeType idx = npos) const {
+        return rfind_(b_str.data_(), b_str.size(), idx);
+    }
+
+    /*
+     * @brief 查找子串 str 最后一次出现的位置
+     * @param str 待匹配的模式串
+     * @param idx 匹配的起始位置不超过 idx，默认查找整个字符串
+     * */
+    SizeType rfind(const std::string &str, SizeType idx = npos) const {
+        return rfind_(str.c_str(), str.size(), idx);
+    }
+
+    /*
+     * @brief 查找子串 s 最后一次出现的位置
+     * @param s 待匹配的模式串
+     * @param idx 匹配的起始位置不超过 idx，默认查找整个字符串
+     * */
+    SizeType rfind(const char *s, SizeType idx = npos) const {
+        return rfind_(s, strlen(s), idx);
+    }
+
+    /*
+     * @brief 查找子串 sv 最后一次出现的位置
+     * @param sv 待匹配的模式串
+     * @param idx 匹配的起始位置不超过 idx，默认查找整个字符串
+     * */
+    SizeType rfind(BStringView sv, SizeType idx = npos) const {
+        return rfind_(sv.data(), sv.size(), idx);
+    }
+
+    // 查找字符 c 最后一次出现的位置，位置不超过 idx
+    SizeType rfind(char c, SizeType idx = npos) const {
+        return rfind_(&c, 1, idx);
+    }
+
+    /*
+     * @brief 在[idx, size())中查找第一个属于 b_str 的字符
+     * @param b_str 待查找的字符集合
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find_first_of(const BString &b_str, SizeType idx = 0) const {
+        return find_first_of_(b_str.data_(), b_str.size(), idx);
+    }
+
+    /*
+     * @brief 在[idx, size())中查找第一个属于 str 的字符
+     * @param str 待查找的字符集合
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find_first_of(const std::string &str, SizeType idx = 0) const {
+        return find_first_of_(str.c_str(), str.size(), idx);
+    }
+
+    /*
+     * @brief 在[idx, size())中查找第一个属于 s 的字符
+     * @param s 待查找的字符集合
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find_first_of(const char *s, SizeType idx = 0) const {
+        return find_first_of_(s, strlen(s), idx);
+    }
+
+    /*
+     * @brief 在[idx, size())中查找第一个属于 sv 的字符
+     * @param sv 待查找的字符集合
+     * @param idx 从主串的 idx 后开始查找
+     * */
+    SizeType find_first_of(BStringView sv, SizeType idx = 0) const {
+        return find_first_of_(sv.data(), sv.size(), idx);
+    }
+
+    // 在[idx, size())中查找字符 c 首次出现的位置，与 find(c, idx) 相同
+    SizeType find_first_of(char c, SizeType idx = 0) const {
+        return find_first_of_(&c, 1, idx);
+    }
+
     /*
      * @brief 获取一个从 idx 位置开始，长度为 n 的子串
      * @param idx 开始索引
@@ -442,46 +756,185 @@ public:
         if (idx >= this->size()) {
             throw std::out_of_range("BString::substr");
         }
-        if (n == npos) n = this->size();
-        n = std::min(n, this->size() - idx);
-        return BString(ptr_ + idx, n);
+        // 经由视图构造，避免 BString(const char*, n) 对剩余部分调用 strlen
+        return BString(substr_view(idx, n));
+    }
+
+    /*
+     * @brief 获取一个从 idx 位置开始，长度为 n 的子串视图，不复制任何字符
+     * @param idx 开始索引
+     * @param n 子串的长度
+     * @return 指向当前字符串内部的视图，在当前字符串被修改或销毁后失效
+     * */
+    BStringView substr_view(SizeType idx, SizeType n = npos) const {
+        if (idx > this->size()) {
+            throw std::out_of_range("BString::substr_view");
+        }
+        return BStringView(data_() + idx, std::min(n, this->size() - idx));
     }
 // @}  //  与子串和元素查找相关的操作
 
 
-// @{  // 重载各类操作符
+// @{  // 批量变换
+private:
+    // 判断 [s, s + n) 是否与当前字符串的空间重叠
+    bool overlaps_(const char *s, SizeType n) const {
+        const char *beg = data_();
+        const char *last = beg + this->capacity() + 1;
+        return n != 0 && std::less<const char *>()(s, last) && std::less<const char *>()(beg, s + n);
+    }
+
 public:
 
-    // 重载 << 运算符
-    friend std::ostream &
-    operator<<(std::ostream &os, const BString &b_str) {
-        os << b_str.ptr_;
-        return os;
+    // 把 ASCII 大写字母原地转换为小写，x86 平台上每次处理 16 个字节
+    BString & to_lower() {
+        invalidate_hash_();
+        BStringTransform::to_lower(data_(), this->size());
+        return *this;
     }
 
-    // 重载 == 操作符
-    bool operator==(const BString &b_str) {
-        return strcmp(ptr_, b_str.ptr_) == 0;
+    // 把 ASCII 小写字母原地转换为大写，x86 平台上每次处理 16 个字节
+    BString & to_upper() {
+        invalidate_hash_();
+        BStringTransform::to_upper(data_(), this->size());
+        return *this;
     }
 
-    //  重载 > 操作符
-    bool operator>(const BString &b_str) {
-        return strcmp(ptr_, b_str.ptr_) > 0;
+    // 原地去掉首尾的空白字符，不释放空间
+    BString & trim() {
+        BStringView sv = BStringView(*this).trim();
+        if (sv.data() != data_()) memmove(data_(), sv.data(), sv.size());
+        set_size_(sv.size());
+        return *this;
     }
 
-    // 重载 >= 操作符
-    bool operator>=(const BString &b_str) {
-        return strcmp(ptr_, b_str.ptr_) >= 0;
+    /*
+     * @brief 按分隔符 delim 切分，把各段的视图依次放入 out
+     * @return 段数，规则见 BStringView::split
+     *
+     * 各段指向当前字符串内部，在当前字符串被修改或销毁后失效
+     * */
+    SizeType split(char delim, BVector<BStringView> &out) const {
+        return BStringView(*this).split(delim, out);
     }
 
-    // 重载 < 操作符
-    bool operator<(const BString &b_str) {
-        return strcmp(ptr_, b_str.ptr_) < 0;
+    /*
+     * @brief 把所有（互不重叠的）子串 from 替换为 to
+     *
+     * 与反复调用 find + erase + append 不同，整个替换只移动每个字符一次：
+     *   1. to 不比 from 长：从左到右原地压缩，不申请内存
+     *   2. to 比 from 长：先数出匹配的次数，按最终长度只分配一次空间，
+     *      再把各段依次复制过去
+     * from 为空时不做任何修改
+     * */
+    BString & replace_all(BStringView from, BStringView to);
+// @}  // 批量变换
+
+
+// @{  // 哈希
+public:
+
+    /*
+     * @brief 返回字符串的 64 位哈希值，与 BHash::bytes(data(), size()) 相同
+     *
+     * 调用过 cache_hash() 且之后没有修改过时，直接返回缓存的值
+     * */
+    std::uint64_t hash() const {
+        if (hash_cached_()) {
+            std::uint64_t h;
+            memcpy(&h, hash_slot_(), sizeof(h));
+            return h;
+        }
+        return BHash::bytes(data_(), this->size());
+    }
+
+    /*
+     * @brief 计算并缓存哈希值，之后的 hash() 不再需要遍历字符
+     *
+     * 适合长字符串作为哈希表的键被反复查找的场景：
+     *   1. 只有长字符串会缓存，哈希值保存在缓冲区末尾未使用的 8 个字节中，
+     *      不增加对象的大小；剩余空间不足 8 个字节时扩容一次
+     *   2. 短字符串计算哈希值本身只需要几纳秒，不缓存
+     *   3. 任何修改（包括通过非 const 的 data()、operator[]、begin() 获得可写指针）
+     *      都会使缓存失效
+     * */
+    std::uint64_t cache_hash() {
+        if (is_local_()) return BHash::bytes(data_(), this->size());
+        if (hash_cached_()) return this->hash();
+
+        std::uint64_t h = BHash::bytes(data_(), this->size());
+        if (this->capacity() - this->size() < sizeof(h)) this->reserve(this->size() + sizeof(h));
+        memcpy(hash_slot_(), &h, sizeof(h));
+        heap_.cap |= kCapHashFlag;
+        return h;
     }
+// @}  // 哈希
+
+
+// @{  // 数值解析
+public:
 
-    // 重载 <= 操作符
-    bool operator<=(const BString &b_str) {
-        return strcmp(ptr_, b_str.ptr_) <= 0;
+    /*
+     * @brief 把字符串开头的十进制整数解析为 Int 类型
+     * @param pos 不为空时，写入第一个未被解析的字符的索引
+     * @throw 开头不是整数时抛出std::invalid_argument异常，
+     *        超出 Int 的范围时抛出std::out_of_range异常
+     *
+     * 与 std::stoll 不同，不跳过前导空白，也不接受'+'，格式见 BCharConv::parse_int
+     * */
+    template<typename Int = long long>
+    Int parse_int(SizeType *pos = nullptr) const {
+        Int v{};
+        auto ret = BCharConv::parse_int(begin(), end(), v);
+        if (ret.ec == std::errc::invalid_argument) {
+            throw std::invalid_argument("BString::parse_int");
+        }
+        if (ret.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("BString::parse_int");
+        }
+        if (pos != nullptr) *pos = static_cast<SizeType>(ret.ptr - begin());
+        return v;
+    }
+
+    /*
+     * @brief 把字符串开头的十进制浮点数解析为 double
+     * @param pos 不为空时，写入第一个未被解析的字符的索引
+     * @throw 开头不是浮点数时抛出std::invalid_argument异常，
+     *        上溢或下溢时抛出std::out_of_range异常
+     * */
+    double parse_double(SizeType *pos = nullptr) const {
+        double v{};
+        auto ret = BCharConv::parse_double(begin(), end(), v);
+        if (ret.ec == std::errc::invalid_argument) {
+            throw std::invalid_argument("BString::parse_double");
+        }
+        if (ret.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("BString::parse_double");
+        }
+        if (pos != nullptr) *pos = static_cast<SizeType>(ret.ptr - begin());
+        return v;
+    }
+// @}  // 数值解析
+
+
+// @{  // 重载各类操作符
+public:
+
+    // 重载 << 运算符，按长度输出，字符串中的'\0'也会被输出
+    friend std::ostream &
+    operator<<(std::ostream &os, const BString &b_str) {
+        return os << BStringView(b_str);
+    }
+
+    /*
+     * 转换为字符串视图
+     *
+     * ==、<、> 等比较运算符定义在 baby_string_view.h 中，BString 与
+     * BString / std::string / c 风格字符串 / BStringView 之间的比较
+     * 都会先转换为视图，不会构造临时的 BString
+     * */
+    operator BStringView() const noexcept {
+        return BStringView(data_(), this->size());
     }
 
     /*
@@ -548,27 +1001,56 @@ public:
         str.append(b_str2);
         return str;
     }
-// @}  // 重载各类操作符
-};
 
-#endif //CPPBABYSTL_BABY_STRING_H
+    /*
+     * @brief 重载+操作符 ==> 左操作数是右值时直接在其末尾追加
+     *
+     * a + b + c + ... 中除第一次以外的拼接，左操作数都是上一次拼接得到的
+     * 临时对象，复用它的空间（按 2 倍扩容）可以避免每次都复制整个左操作数，
+     * 使连续拼接的总代价从平方级降为线性
+     * */
+    friend BString
+    operator+(BString &&b_str1, const BString &b_str2) {
+        b_str1.append(b_str2);
+        return std::move(b_str1);
+    }
+
+    friend BString
+    operator+(BString &&b_str1, const std::string &str2) {
+        b_str1.append(str2);
+        return std::move(b_str1);
+    }
 
+    friend BString
+    operator+(BString &&b_str1, const char *s2) {
+        b_str1.append(s2);
+        return std::move(b_str1);
+    }
+
+    friend BString
+    operator+(BString &&b_str1, BStringView sv2) {
+        b_str1.append(sv2);
+        return std::move(b_str1);
+    }
+// @}  // 重载各类操作符
+};
 
 
 /* BSting 对象部分成员函数的实现 */
-void BString::construct_(const char *s, BString::SizeType n) {
+inline void BString::construct_(const char *s, BString::SizeType n) {
     if (n > kLocalCapacity) {
         // 在堆上分配空间
-        ptr_ = new char[n + 1]{};  // 多一位存储'\0'
-        allocated_capacity_ = n;
+        set_heap_(new char[n + 1], n, n);  // 多一位存储'\0'
+    } else {
+        set_empty_();
+        set_size_(n);
     }
 
-    // 复制字符
-    strncpy(ptr_, s, n);
-    str_len_ = n;
+    // 复制字符：长度已知，不需要 strncpy 逐字节检查'\0'
+    memcpy(data_(), s, n);
 }
 
-void BString::assign_(const char *s, BString::SizeType n) {
+inline void BString::assign_(const char *s, BString::SizeType n) {
     SizeType capacity = this->capacity();
 
     if (n > capacity) {
@@ -576,64 +1058,25 @@ void BString::assign_(const char *s, BString::SizeType n) {
         reallocation_(n);
     }
 
-    // 复制字符串
-    strncpy(ptr_, s, n);
-    ptr_[n] = '\0';  // strncpy不保证复制'\0'
-    str_len_ = n;
+    // 复制字符串：s 可能指向自身（如 str = str.substr_view(1)），因此使用 memmove
+    memmove(data_(), s, n);
+    set_size_(n);
 }
 
-void BString::erase_(BString::SizeType idx, BString::SizeType n) {
+inline void BString::erase_(BString::SizeType idx, BString::SizeType n) {
     if (idx >= this->size()) return;
 
     if (idx + n >= this->size()) {
-        ptr_[idx] = '\0';
-        str_len_ = idx;
+        set_size_(idx);
     } else {
+        char *ptr = data_();
         SizeType cnt = this->size() - (idx + n);
-        memmove(ptr_ + idx, ptr_ + idx + n, cnt);
-        ptr_[this->size() - n] = '\0';
-        str_len_ = this->size() - n;
-    }
-}
-
-BString::SizeType BString::find_(
-        BString::SizeType beg, BString::SizeType end, const char *s, BString::SizeType n) const {
-    if (n == 0) return beg;  // 空串能够匹配上任意字符串
-    if (n > end - beg) return npos;
-
-    // 计算前缀函数
-    const auto prefix_func = [](const char *str, SizeType n) -> SizeType * {
-        // n为字符串str的长度
-        auto pi = new SizeType[n];
-        pi[0] = SizeType(0);
-        for (SizeType i = 1; i < n; i++) {
-            SizeType j = pi[i - 1];
-            while (j > 0 && str[i] != str[j]) j = pi[j - 1];
-            if (str[i] == str[j]) j++;
-            pi[i] = j;
-        }
-        return pi;
-    };
-
-    SizeType m = end - beg;
-    auto cur = new char[m + 1 + n];
-    strncpy(cur, s, n);
-    cur[n] = '\0';  // 分隔符，既不能在 ptr_ 中也不能在 s_ 中存在
-    strncpy(cur + n + 1, ptr_ + beg, m);
-
-    SizeType *lps = prefix_func(cur, m + 1 + n);
-    for (SizeType i = n + 1; i <= m + n; i++) {
-        if (lps[i] == n) return i - 2 * n + beg;
+        memmove(ptr + idx, ptr + idx + n, cnt);
+        set_size_(this->size() - n);
     }
-
-    // 释放临时变量的内存
-    delete[] cur;
-    delete[] lps;
-
-    return npos;
 }
 
-char *BString::creat_(BString::SizeType &new_capacity) const {
+inline char *BString::creat_(BString::SizeType &new_capacity) const {
     SizeType old_capacity = this->capacity();
     // TODO: new_capacity > max_size() ==> 抛出异常
     if (new_capacity > old_capacity && new_capacity < 2 * old_capacity) {
@@ -644,52 +1087,125 @@ char *BString::creat_(BString::SizeType &new_capacity) const {
     return new char[new_capacity + 1];
 }
 
-void BString::append_(const char *s, BString::SizeType n) {
+inline void BString::append_(const char *s, BString::SizeType n) {
     SizeType len = this->size() + n;
     SizeType capacity = this->capacity();
 
     if (len > capacity) {
-        // 重新分配内存
-        reallocation_(len);
+        // s 可能指向自身（如 str.append(str)），因此先把两部分都复制到新空间，
+        // 再释放旧空间
+        SizeType new_capacity = len;
+        char *tmp = creat_(new_capacity);
+        memcpy(tmp, data_(), this->size());
+        memcpy(tmp + this->size(), s, n);
+        destroy_();
+        set_heap_(tmp, len, new_capacity);
+        return;
     }
 
-    // 将_s串前_n个字符拷贝到_M_ptr后
-    strncpy(ptr_ + str_len_, s, n);
-    ptr_[len] = '\0';
-    str_len_ = len;
+    // 将 s 串前 n 个字符拷贝到字符串末尾，目标位置在有效字符之后，不会与 s 重叠
+    memcpy(data_() + this->size(), s, n);
+    set_size_(len);
 }
 
-BString::BString(BString &&b_str) noexcept {
-    ptr_ = local_buf_;
-    SizeType len = b_str.size();
-    if (len <= kLocalCapacity) {
-        // 字符串存储在栈上，直接复制
-        strcpy(ptr_, b_str.ptr_);
-    } else {
-        ptr_ = b_str.ptr_;
-        allocated_capacity_ = b_str.allocated_capacity_;
+inline BString &BString::replace_all(BStringView from, BStringView to) {
+    const SizeType m = from.size();
+    const SizeType len = this->size();
+    if (m == 0 || m > len) return *this;
 
-        // 将b_str置为空
-        b_str.ptr_ = b_str.local_buf_;
-        b_str.str_len_ = 0;
-        b_str.ptr_[0] = '\0';
+    // from 或 to 指向自身时，原地修改会破坏它们，先复制一份
+    if (overlaps_(from.data(), m) || overlaps_(to.data(), to.size())) {
+        BString from_copy(from), to_copy(to);
+        return replace_all(from_copy, to_copy);
     }
-    str_len_ = len;
-}
 
-BString &BString::operator=(BString &&b_str) noexcept {
-    if (this == &b_str) return *this;
+    // 长模式串的跳转表只计算一次
+    BStringSearch::ShiftTable shift;
+    const bool use_horspool = m > BStringSearch::kShortNeedle;
+    if (use_horspool) BStringSearch::build_shift_table(from.data(), m, shift);
 
-    SizeType len = b_str.size();
-    if (b_str.ptr_ == b_str.local_buf_) {
-        strcpy(ptr_, b_str.ptr_);
-    } else {
-        ptr_ = b_str.ptr_;
-        allocated_capacity_ = b_str.allocated_capacity_;
+    char *s = data_();
+    auto next = [&](SizeType idx) -> SizeType {
+        SizeType pos = use_horspool ? BStringSearch::horspool(s + idx, len - idx, from.data(), m, shift)
+                                    : BStringSearch::find(s + idx, len - idx, from.data(), m);
+        return pos == npos ? npos : idx + pos;
+    };
+
+    if (to.size() <= m) {
+        // 写入位置 w 始终不超过读取位置 r
+        SizeType r = 0, w = 0;
+        for (SizeType pos = next(0); pos != npos; pos = next(r)) {
+            if (w != r) memmove(s + w, s + r, pos - r);
+            w += pos - r;
+            memcpy(s + w, to.data(), to.size());
+            w += to.size();
+            r = pos + m;
+        }
+        if (r == 0) return *this;
+        memmove(s + w, s + r, len - r);
+        set_size_(w + len - r);
+        return *this;
+    }
+
+    SizeType cnt = 0;
+    for (SizeType pos = next(0); pos != npos; pos = next(pos + m)) cnt++;
+    if (cnt == 0) return *this;
+
+    const SizeType new_len = len + cnt * (to.size() - m);
+    char local[kLocalCapacity + 1];
+    SizeType new_capacity = new_len;
+    char *buf = new_len <= kLocalCapacity ? local : creat_(new_capacity);
+
+    SizeType r = 0, w = 0;
+    for (SizeType pos = next(0); pos != npos; pos = next(r)) {
+        memcpy(buf + w, s + r, pos - r);
+        w += pos - r;
+        memcpy(buf + w, to.data(), to.size());
+        w += to.size();
+        r = pos + m;
+    }
+    memcpy(buf + w, s + r, len - r);
 
-        b_str.ptr_ = b_str.local_buf_;
-        b_str.str_len_ = 0;
+    if (buf == local) {
+        // 结果仍然是短字符串，原来的空间也一定足够
+        memcpy(s, local, new_len);
+        set_size_(new_len);
+    } else {
+        destroy_();
+        set_heap_(buf, new_len, new_capacity);
     }
-    str_len_ = len;
     return *this;
 }
+
+inline BString::BString(BString &&b_str) noexcept {
+    // 两种状态下都直接复制全部 24 个字节，长字符串相当于接管了堆空间
+    memcpy(local_buf_, b_str.local_buf_, sizeof(local_buf_));
+    b_str.set_empty_();
+}
+
+inline BString &BString::operator=(BString &&b_str) noexcept {
+    if (this == &b_str) return *this;
+
+    destroy_();  // 释放自身的堆空间
+    memcpy(local_buf_, b_str.local_buf_, sizeof(local_buf_));
+    b_str.set_empty_();
+    return *this;
+}
+
+static_assert(sizeof(BString) == 3 * sizeof(BString::SizeType), "BString should be 24 bytes on 64-bit");
+
+// BString 中没有指向自身的指针，BVector 扩容时可以直接按字节搬迁
+template<>
+struct b_is_trivially_relocatable<BString> : std::true_type {};
+
+// 使用 BString::hash()，已缓存哈希值的长字符串不需要遍历字符
+namespace std {
+template<>
+struct hash<BString> {
+    size_t operator()(const BString &s) const noexcept {
+        return static_cast<size_t>(s.hash());
+    }
+};
+}  // namespace std
+
+#endif //CPPBABYSTL_BABY_STRING_H
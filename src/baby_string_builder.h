@@ -0,0 +1,195 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 用于逐段拼接大字符串的 BStringBuilder
+//
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <iostream>
+#include <algorithm>
+#include "baby_charconv.h"
+#include "baby_string.h"
+#include "baby_string_view.h"
+#include "baby_vector.h"
+
+#ifndef CPPBABYSTL_BABY_STRING_BUILDER_H
+#define CPPBABYSTL_BABY_STRING_BUILDER_H
+
+/*
+ * 字符串构建器：把追加的片段依次复制到一组块（chunk）中，只在 str() 时
+ * 一次性拼接成 BString
+ *
+ * 与直接向 BString 追加相比，构建过程中已经写入的字符不会因为扩容而被
+ * 反复复制，也不需要一块连续的大内存：块的大小从 kMinChunk 开始按 2 倍
+ * 增长，到 kMaxChunk 后保持不变。每个字符在构建过程中只被复制一次，
+ * str() 时再复制一次
+ * */
+class BStringBuilder {
+public:
+    using SizeType = std::size_t;
+
+    enum : SizeType {
+        kMinChunk = 1024,     // 第一个块的大小
+        kMaxChunk = 1 << 20   // 块的最大大小，超过该长度的单个片段会独占一个块
+    };
+
+private:
+    // 一个块：data 的前 size 个字节已经写入
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        SizeType size;
+        SizeType cap;
+    };
+
+    BVector<Chunk> chunks_;
+    SizeType size_{};        // 所有块中已写入的字符总数
+    SizeType next_cap_{kMinChunk};  // 下一个块的大小
+
+    // 新建一个至少能容纳 n 个字符的块
+    void add_chunk_(SizeType n) {
+        SizeType cap = std::max(n, next_cap_);
+        chunks_.emplace_back(Chunk{std::unique_ptr<char[]>(new char[cap]), 0, cap});
+        next_cap_ = std::min<SizeType>(next_cap_ * 2, kMaxChunk);
+    }
+
+public:
+
+    BStringBuilder() = default;
+
+    // 预计最终长度为 n 时，第一个块直接按 n 分配，str() 前不会再新建块
+    explicit BStringBuilder(SizeType n) {
+        if (n > 0) add_chunk_(n);
+    }
+
+    // 移动后 other 变为空的构建器
+    BStringBuilder(BStringBuilder &&other) noexcept
+            : chunks_(std::move(other.chunks_)),
+              size_(std::exchange(other.size_, 0)),
+              next_cap_(std::exchange(other.next_cap_, SizeType(kMinChunk))) {}
+
+    BStringBuilder &operator=(BStringBuilder &&other) noexcept {
+        if (this == &other) return *this;
+        chunks_ = std::move(other.chunks_);
+        size_ = std::exchange(other.size_, 0);
+        next_cap_ = std::exchange(other.next_cap_, SizeType(kMinChunk));
+        return *this;
+    }
+
+    BStringBuilder(const BStringBuilder &) = delete;
+
+    BStringBuilder &operator=(const BStringBuilder &) = delete;
+
+
+// @{  // 追加内容
+public:
+
+    /*
+     * @brief 向末尾追加一个片段
+     *
+     * 先填满当前块的剩余空间，放不下的部分写入一个新块
+     * */
+    BStringBuilder &append(BStringView sv) {
+        const char *s = sv.data();
+        SizeType n = sv.size();
+        if (n == 0) return *this;
+
+        if (!chunks_.empty()) {
+            Chunk &last = chunks_.back();
+            SizeType cnt = std::min(n, last.cap - last.size);
+            memcpy(last.data.get() + last.size, s, cnt);
+            last.size += cnt;
+            s += cnt;
+            n -= cnt;
+        }
+        if (n > 0) {
+            add_chunk_(n);
+            Chunk &last = chunks_.back();
+            memcpy(last.data.get(), s, n);
+            last.size = n;
+        }
+        size_ += sv.size();
+        return *this;
+    }
+
+    // 向末尾追加一个字符
+    BStringBuilder &push_back(char c) {
+        if (chunks_.empty() || chunks_.back().size == chunks_.back().cap) add_chunk_(1);
+        Chunk &last = chunks_.back();
+        last.data[last.size++] = c;
+        ++size_;
+        return *this;
+    }
+
+    BStringBuilder &operator+=(BStringView sv) { return this->append(sv); }
+
+    BStringBuilder &operator+=(char c) { return this->push_back(c); }
+
+    // 支持 builder << "HTTP/1.1 " << status << "\r\n" 的链式写法
+    BStringBuilder &operator<<(BStringView sv) { return this->append(sv); }
+
+    BStringBuilder &operator<<(char c) { return this->push_back(c); }
+
+    // 向末尾追加整数 v 的十进制表示
+    template<typename Int, typename std::enable_if<std::is_integral<Int>::value, int>::type = 0>
+    BStringBuilder &append_int(Int v) {
+        char buf[BCharConv::kMaxIntChars];
+        return this->append(BStringView(buf, BCharConv::write_int(buf, v) - buf));
+    }
+
+    // 向末尾追加浮点数 v 的最短十进制表示
+    BStringBuilder &append_double(double v) {
+        char buf[BCharConv::kMaxDoubleChars];
+        return this->append(BStringView(buf, BCharConv::write_double(buf, v) - buf));
+    }
+// @}  // 追加内容
+
+
+// @{  // 获取结果
+public:
+
+    // 已追加的字符总数
+    SizeType size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    // 当前使用的块数
+    SizeType chunk_count() const { return chunks_.size(); }
+
+    // 把所有块拼接为一个 BString，只分配一次内存
+    BString str() const {
+        BString ret;
+        ret.reserve(size_);
+        for (SizeType i = 0; i < chunks_.size(); i++) {
+            ret.append(BStringView(chunks_[i].data.get(), chunks_[i].size));
+        }
+        return ret;
+    }
+
+    // 依次对每个块调用 func(BStringView)，不需要先拼接成一个连续的字符串
+    template<typename Func>
+    void for_each_chunk(Func &&func) const {
+        for (SizeType i = 0; i < chunks_.size(); i++) {
+            func(BStringView(chunks_[i].data.get(), chunks_[i].size));
+        }
+    }
+
+    // 清空内容并释放所有块
+    void clear() {
+        chunks_.clear();
+        size_ = 0;
+        next_cap_ = kMinChunk;
+    }
+
+    // 逐块输出到流中
+    friend std::ostream &operator<<(std::ostream &os, const BStringBuilder &builder) {
+        builder.for_each_chunk([&os](BStringView sv) { os << sv; });
+        return os;
+    }
+// @}  // 获取结果
+};
+
+#endif //CPPBABYSTL_BABY_STRING_BUILDER_H
@@ -0,0 +1,293 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 字符串驻留池 BStringInterner：把重复出现的字符串映射为 32 位 id
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+#include "baby_hash.h"
+#include "baby_string_view.h"
+#include "baby_vector.h"
+
+#ifndef CPPBABYSTL_BABY_STRING_INTERNER_H
+#define CPPBABYSTL_BABY_STRING_INTERNER_H
+
+/*
+ * 驻留字符串的句柄，只保存一个 32 位 id
+ *
+ * 同一个 BStringInterner 中内容相同的字符串总是得到相同的 id，因此比较
+ * 两个句柄是否相等只需要比较 id。< 按 id（即首次驻留的先后顺序）排序，
+ * 而不是按字典序，BMap<BInternedStr, V> 中的每次比较都只是一次整数比较。
+ * 需要按字典序排序时使用 BStringInterner::LexLess
+ *
+ * 来自不同 BStringInterner 的句柄之间的比较没有意义
+ * */
+class BInternedStr {
+public:
+    using IdType = std::uint32_t;
+
+    static constexpr IdType kInvalid = std::numeric_limits<IdType>::max();
+
+private:
+    IdType id_{kInvalid};
+
+public:
+
+    // 默认构造函数：创建一个无效的句柄
+    constexpr BInternedStr() noexcept = default;
+
+    constexpr explicit BInternedStr(IdType id) noexcept : id_(id) {}
+
+    constexpr IdType id() const noexcept { return id_; }
+
+    // 判断句柄是否有效（由 intern 返回，或由 find 找到）
+    constexpr bool valid() const noexcept { return id_ != kInvalid; }
+
+    friend constexpr bool operator==(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ == rhs.id_; }
+
+    friend constexpr bool operator!=(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ != rhs.id_; }
+
+    friend constexpr bool operator<(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ < rhs.id_; }
+
+    friend constexpr bool operator<=(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ <= rhs.id_; }
+
+    friend constexpr bool operator>(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ > rhs.id_; }
+
+    friend constexpr bool operator>=(BInternedStr lhs, BInternedStr rhs) noexcept { return lhs.id_ >= rhs.id_; }
+};
+
+
+/*
+ * 字符串驻留池
+ *
+ *   1. 字符存储：所有字符串依次复制到若干个块中，同一个块内连续存放。
+ *      块的大小从 4KB 开始按 2 倍增长，最大为 64KB。块一旦分配就不再移动，
+ *      因此 view() 返回的视图在驻留池销毁前一直有效。超过最大块大小的字符串
+ *      单独占用一个块
+ *   2. 索引：entries_[id] 记录第 id 个字符串的位置、长度和哈希值；
+ *      去重使用开放寻址（线性探测）的哈希表 slots_，槽中保存 id + 1，
+ *      0 表示空槽。负载因子不超过 1/2
+ *
+ * 驻留池只增不减，不支持删除单个字符串
+ * */
+class BStringInterner {
+public:
+    using SizeType = std::size_t;
+    using IdType = BInternedStr::IdType;
+
+    enum : SizeType {
+        kMinChunk = 4 * 1024,    // 第一个块的大小
+        kMaxChunk = 64 * 1024,   // 块的最大大小
+        kMinSlots = 64           // 哈希表的初始槽数，必须是 2 的幂
+    };
+
+private:
+    struct Entry {
+        const char *data;
+        IdType size;
+        IdType hash;  // 哈希值的低 32 位，用于扩容时重新插入以及快速排除不同的字符串
+    };
+
+    BVector<std::unique_ptr<char[]>> chunks_;
+    char *cur_{};                  // 当前块中第一个未使用的字节
+    SizeType left_{};              // 当前块中剩余的字节数
+    SizeType bytes_{};             // 已分配的块的总字节数
+    SizeType next_chunk_{kMinChunk};  // 下一个块的大小
+
+    BVector<Entry> entries_;
+    BVector<IdType> slots_;
+
+    // 把 sv 复制到块中，返回复制后的地址
+    const char *store_(BStringView sv) {
+        SizeType n = sv.size();
+        if (n == 0) return "";
+        if (n > left_) {
+            if (n >= kMaxChunk) {
+                // 超长字符串独占一个块，不影响当前块的剩余空间
+                chunks_.emplace_back(new char[n]);
+                bytes_ += n;
+                char *p = chunks_.back().get();
+                memcpy(p, sv.data(), n);
+                return p;
+            }
+            SizeType cap = std::max(n, next_chunk_);
+            chunks_.emplace_back(new char[cap]);
+            bytes_ += cap;
+            next_chunk_ = std::min<SizeType>(next_chunk_ * 2, kMaxChunk);
+            cur_ = chunks_.back().get();
+            left_ = cap;
+        }
+        char *p = cur_;
+        memcpy(p, sv.data(), n);
+        cur_ += n;
+        left_ -= n;
+        return p;
+    }
+
+    static IdType hash_(BStringView sv) {
+        return static_cast<IdType>(BHash::bytes(sv.data(), sv.size()));
+    }
+
+    /*
+     * @brief 在哈希表中查找 sv
+     * @return 找到时返回所在的槽，否则返回应当插入的空槽
+     * */
+    SizeType probe_(BStringView sv, IdType hash) const {
+        SizeType mask = slots_.size() - 1;
+        for (SizeType i = hash & mask;; i = (i + 1) & mask) {
+            IdType slot = slots_[i];
+            if (slot == 0) return i;
+
+            const Entry &e = entries_[slot - 1];
+            if (e.hash == hash && e.size == sv.size() &&
+                BStringView(e.data, e.size) == sv) {
+                return i;
+            }
+        }
+    }
+
+    // 哈希表扩容为原来的 2 倍，并重新插入所有 id
+    void rehash_() {
+        SizeType cnt = std::max<SizeType>(kMinSlots, slots_.size() * 2);
+        BVector<IdType> slots(cnt, 0);
+        SizeType mask = cnt - 1;
+        for (SizeType id = 0; id < entries_.size(); id++) {
+            SizeType i = entries_[id].hash & mask;
+            while (slots[i] != 0) i = (i + 1) & mask;
+            slots[i] = static_cast<IdType>(id + 1);
+        }
+        slots_ = std::move(slots);
+    }
+
+public:
+
+    BStringInterner() = default;
+
+    // 移动后 other 变为空的驻留池，已有的视图仍然指向原来的块，继续有效
+    BStringInterner(BStringInterner &&other) noexcept
+            : chunks_(std::move(other.chunks_)),
+              cur_(std::exchange(other.cur_, nullptr)),
+              left_(std::exchange(other.left_, 0)),
+              bytes_(std::exchange(other.bytes_, 0)),
+              next_chunk_(std::exchange(other.next_chunk_, SizeType(kMinChunk))),
+              entries_(std::move(other.entries_)),
+              slots_(std::move(other.slots_)) {}
+
+    BStringInterner &operator=(BStringInterner &&other) noexcept {
+        if (this == &other) return *this;
+        chunks_ = std::move(other.chunks_);
+        cur_ = std::exchange(other.cur_, nullptr);
+        left_ = std::exchange(other.left_, 0);
+        bytes_ = std::exchange(other.bytes_, 0);
+        next_chunk_ = std::exchange(other.next_chunk_, SizeType(kMinChunk));
+        entries_ = std::move(other.entries_);
+        slots_ = std::move(other.slots_);
+        return *this;
+    }
+
+    // 复制会使两个驻留池共享同一批块，因此禁止复制
+    BStringInterner(const BStringInterner &) = delete;
+
+    BStringInterner &operator=(const BStringInterner &) = delete;
+
+
+// @{  // 驻留与查找
+public:
+
+    /*
+     * @brief 驻留字符串 sv，返回其句柄
+     *
+     * sv 已经驻留过时直接返回原来的句柄，不复制任何字符
+     * @throw 当字符串数目或单个字符串的长度超过 32 位 id 的表示范围时，
+     *        抛出std::length_error异常
+     * */
+    BInternedStr intern(BStringView sv) {
+        if ((entries_.size() + 1) * 2 > slots_.size()) rehash_();
+
+        IdType hash = hash_(sv);
+        SizeType i = probe_(sv, hash);
+        if (slots_[i] != 0) return BInternedStr(slots_[i] - 1);
+
+        if (entries_.size() >= BInternedStr::kInvalid || sv.size() > std::numeric_limits<IdType>::max()) {
+            throw std::length_error("BStringInterner::intern");
+        }
+        auto id = static_cast<IdType>(entries_.size());
+        entries_.push_back(Entry{store_(sv), static_cast<IdType>(sv.size()), hash});
+        slots_[i] = id + 1;
+        return BInternedStr(id);
+    }
+
+    // 查找已经驻留的字符串 sv，不存在时返回无效的句柄，不会驻留 sv
+    BInternedStr find(BStringView sv) const {
+        if (slots_.empty()) return BInternedStr();
+
+        SizeType i = probe_(sv, hash_(sv));
+        return slots_[i] == 0 ? BInternedStr() : BInternedStr(slots_[i] - 1);
+    }
+
+    /*
+     * @brief 返回句柄对应的字符串
+     * @throw 当句柄无效或不属于当前驻留池时，抛出std::out_of_range异常
+     * */
+    BStringView view(BInternedStr s) const {
+        if (s.id() >= entries_.size()) {
+            throw std::out_of_range("BStringInterner::view");
+        }
+        const Entry &e = entries_[s.id()];
+        return BStringView(e.data, e.size);
+    }
+
+    // 已驻留的字符串数目
+    SizeType size() const { return entries_.size(); }
+
+    bool empty() const { return entries_.empty(); }
+
+    // 驻留池占用的内存：块、索引和哈希表
+    SizeType memory_usage() const {
+        return bytes_ + entries_.capacity() * sizeof(Entry) + slots_.capacity() * sizeof(IdType);
+    }
+// @}  // 驻留与查找
+
+
+// @{  // 比较器
+public:
+
+    /*
+     * 按字典序比较两个句柄的比较器，句柄相同时不访问字符
+     *
+     * 由于 BMap 使用默认构造的比较器，LexLess 主要用于排序等可以传入
+     * 比较器对象的场景，例如 std::sort(v.begin(), v.end(), interner.lex_less())
+     * */
+    struct LexLess {
+        const BStringInterner *interner;
+
+        bool operator()(BInternedStr lhs, BInternedStr rhs) const {
+            if (lhs == rhs) return false;
+            return interner->view(lhs) < interner->view(rhs);
+        }
+    };
+
+    LexLess lex_less() const { return LexLess{this}; }
+// @}  // 比较器
+};
+
+
+// 句柄的哈希值即为 id
+namespace std {
+template<>
+struct hash<BInternedStr> {
+    size_t operator()(BInternedStr s) const noexcept {
+        return static_cast<size_t>(s.id());
+    }
+};
+}  // namespace std
+
+#endif //CPPBABYSTL_BABY_STRING_INTERNER_H
@@ -0,0 +1,316 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// BString 使用的子串查找算法，查找过程中不申请任何内存：
+//   1. 单个字符：直接调用 memchr
+//   2. 短模式串：SIMD 首尾字节过滤（SSE2 / AVX2，运行时根据 CPU 选择）
+//   3. 长模式串：Boyer-Moore-Horspool，跳转表放在栈上
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <algorithm>
+
+#ifndef CPPBABYSTL_BABY_STRING_SEARCH_H
+#define CPPBABYSTL_BABY_STRING_SEARCH_H
+
+// 只在 GCC / Clang 的 x86 平台上启用 SIMD，其他平台退化为 memchr + memcmp
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define CPPBABYSTL_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * 子串查找的具体实现，所有函数都是无状态的静态函数
+ *
+ * 返回值均为相对于 hay 的下标，查找失败时返回 npos
+ * */
+class BStringSearch {
+public:
+    using SizeType = std::size_t;
+
+    static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+    enum : SizeType {
+        kShortNeedle = 32  // 不超过该长度的模式串使用 SIMD 首尾字节过滤
+    };
+
+    // Horspool 算法的跳转表，以字节值为下标
+    using ShiftTable = std::uint32_t[256];
+
+private:
+    using FindFunc = SizeType (*)(const char *, SizeType, const char *, SizeType);
+
+    /*
+     * @brief 使用 memchr 定位首字节，再用 memcmp 验证剩余部分
+     *
+     * 要求 1 <= m <= n，用于没有 SIMD 的平台以及 SIMD 版本处理尾部
+     * */
+    static SizeType find_scalar_(const char *hay, SizeType n, const char *needle, SizeType m) {
+        const char *p = hay;
+        const char *last = hay + (n - m);  // 最后一个可能的匹配起点
+        while (p <= last) {
+            p = static_cast<const char *>(std::memchr(p, needle[0], SizeType(last - p) + 1));
+            if (p == nullptr) return npos;
+            if (std::memcmp(p + 1, needle + 1, m - 1) == 0) return SizeType(p - hay);
+            ++p;
+        }
+        return npos;
+    }
+
+#ifdef CPPBABYSTL_SEARCH_X86
+    /*
+     * @brief SIMD 首尾字节过滤
+     *
+     * 每次比较 16 个候选起点：同时检查 hay[i] == needle[0] 与
+     * hay[i + m - 1] == needle[m - 1]，两者都成立的位置才用 memcmp 验证，
+     * 对于自然文本绝大多数候选都在这一步被排除。要求 2 <= m <= n
+     * */
+    static SizeType find_sse2_(const char *hay, SizeType n, const char *needle, SizeType m) {
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+        SizeType i = 0;
+        for (; i + m + 15 <= n; i += 16) {
+            __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i));
+            __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i + m - 1));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    _mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                                  _mm_cmpeq_epi8(block_last, last))));
+            while (mask != 0) {
+                unsigned bit = __builtin_ctz(mask);
+                if (std::memcmp(hay + i + bit + 1, needle + 1, m - 2) == 0) return i + bit;
+                mask &= mask - 1;
+            }
+        }
+
+        // 剩余不足一个块的部分
+        if (i + m > n) return npos;
+        SizeType pos = find_scalar_(hay + i, n - i, needle, m);
+        return pos == npos ? npos : i + pos;
+    }
+
+    // 与 find_sse2_ 相同，每次比较 32 个候选起点
+    __attribute__((target("avx2")))
+    static SizeType find_avx2_(const char *hay, SizeType n, const char *needle, SizeType m) {
+        const __m256i first = _mm256_set1_epi8(needle[0]);
+        const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+
+        SizeType i = 0;
+        for (; i + m + 31 <= n; i += 32) {
+            __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i));
+            __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hay + i + m - 1));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                                     _mm256_cmpeq_epi8(block_last, last))));
+            while (mask != 0) {
+                unsigned bit = __builtin_ctz(mask);
+                if (std::memcmp(hay + i + bit + 1, needle + 1, m - 2) == 0) return i + bit;
+                mask &= mask - 1;
+            }
+        }
+
+        if (i + m > n) return npos;
+        SizeType pos = find_sse2_(hay + i, n - i, needle, m);
+        return pos == npos ? npos : i + pos;
+    }
+#endif
+
+    // 根据当前 CPU 支持的指令集选择短模式串的查找函数，只在第一次调用时检测
+    static FindFunc short_finder_() {
+#ifdef CPPBABYSTL_SEARCH_X86
+        static const FindFunc func = __builtin_cpu_supports("avx2") ? &find_avx2_ : &find_sse2_;
+        return func;
+#else
+        return &find_scalar_;
+#endif
+    }
+
+public:
+
+    // 为模式串 needle 构建 Horspool 跳转表，要求 m >= 1
+    static void build_shift_table(const char *needle, SizeType m, ShiftTable &shift) {
+        // 跳转距离偏小只会降低速度而不影响正确性，因此超长模式串可以安全地截断
+        auto limit = static_cast<std::uint32_t>(std::min<SizeType>(m, UINT32_MAX));
+        for (auto &s : shift) s = limit;
+        for (SizeType i = 0; i + 1 < m; i++) {
+            SizeType dist = m - 1 - i;
+            shift[static_cast<unsigned char>(needle[i])] =
+                    static_cast<std::uint32_t>(std::min<SizeType>(dist, limit));
+        }
+    }
+
+    /*
+     * @brief 使用 Boyer-Moore-Horspool 算法查找，要求 1 <= m
+     * @param shift 由 build_shift_table 为 needle 构建的跳转表
+     *
+     * 每次比较窗口的最后一个字节，失配时按该字节跳过最多 m 个位置，
+     * 模式串越长平均速度越快
+     * */
+    static SizeType horspool(const char *hay, SizeType n, const char *needle, SizeType m,
+                             const ShiftTable &shift) {
+        if (m > n) return npos;
+        const char tail = needle[m - 1];
+        for (SizeType i = 0; i <= n - m;) {
+            char c = hay[i + m - 1];
+            if (c == tail && std::memcmp(hay + i, needle, m - 1) == 0) return i;
+            i += shift[static_cast<unsigned char>(c)];
+        }
+        return npos;
+    }
+
+    /*
+     * @brief 查找 needle 在 hay 中第一次出现的位置
+     * @param hay    主串
+     * @param n      主串的长度
+     * @param needle 模式串
+     * @param m      模式串的长度
+     *
+     * 空模式串匹配位置 0
+     * */
+    static SizeType find(const char *hay, SizeType n, const char *needle, SizeType m) {
+        if (m == 0) return 0;
+        if (m > n) return npos;
+        if (m == 1) {
+            auto p = static_cast<const char *>(std::memchr(hay, needle[0], n));
+            return p == nullptr ? npos : SizeType(p - hay);
+        }
+        if (m <= kShortNeedle) return short_finder_()(hay, n, needle, m);
+
+        ShiftTable shift;
+        build_shift_table(needle, m, shift);
+        return horspool(hay, n, needle, m, shift);
+    }
+
+    /*
+     * @brief 查找 needle 在 hay 中最后一次出现的位置
+     *
+     * 空模式串匹配位置 n
+     * */
+    static SizeType rfind(const char *hay, SizeType n, const char *needle, SizeType m) {
+        if (m > n) return npos;
+        if (m == 0) return n;
+
+        const char head = needle[0];
+        const char tail = needle[m - 1];
+        for (SizeType i = n - m + 1; i-- > 0;) {
+            if (hay[i] == head && hay[i + m - 1] == tail &&
+                std::memcmp(hay + i, needle, m) == 0) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    /*
+     * @brief 查找 hay 中第一个属于字符集合 set 的字符
+     * @param set 字符集合
+     * @param k   字符集合的大小
+     *
+     * 字符集合预先展开成 256 位的位图，每个字符只需一次查表
+     * */
+    static SizeType find_first_of(const char *hay, SizeType n, const char *set, SizeType k) {
+        if (k == 0 || n == 0) return npos;
+        if (k == 1) {
+            auto p = static_cast<const char *>(std::memchr(hay, set[0], n));
+            return p == nullptr ? npos : SizeType(p - hay);
+        }
+
+        std::uint64_t bits[4]{};
+        for (SizeType i = 0; i < k; i++) {
+            auto c = static_cast<unsigned char>(set[i]);
+            bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+        }
+        for (SizeType i = 0; i < n; i++) {
+            auto c = static_cast<unsigned char>(hay[i]);
+            if ((bits[c >> 6] >> (c & 63)) & 1) return i;
+        }
+        return npos;
+    }
+};
+
+
+/*
+ * 预编译的模式串
+ *
+ * 在构造时复制模式串并预先计算 Horspool 跳转表，适合用同一个模式串
+ * 反复查找大量主串（如逐行扫描日志）的场景，search 不申请任何内存
+ * */
+class BStringSearcher {
+public:
+    using SizeType = BStringSearch::SizeType;
+
+    static constexpr SizeType npos = BStringSearch::npos;
+
+private:
+    std::unique_ptr<char[]> needle_;
+    SizeType len_{};
+    BStringSearch::ShiftTable shift_{};  // 只有长模式串才会用到
+
+public:
+
+    // 使用 s 的前 n 个字符作为模式串
+    BStringSearcher(const char *s, SizeType n)
+            : needle_(new char[n + 1]), len_(n) {
+        std::memcpy(needle_.get(), s, n);
+        needle_[n] = '\0';
+        if (len_ > BStringSearch::kShortNeedle) {
+            BStringSearch::build_shift_table(needle_.get(), len_, shift_);
+        }
+    }
+
+    // 使用 c 风格字符串作为模式串
+    explicit BStringSearcher(const char *s) : BStringSearcher(s, std::strlen(s)) {}
+
+    BStringSearcher(const BStringSearcher &other)
+            : BStringSearcher(other.needle_.get(), other.len_) {}
+
+    // 移动后 other 变为空模式串
+    BStringSearcher(BStringSearcher &&other) noexcept
+            : needle_(std::move(other.needle_)), len_(std::exchange(other.len_, 0)) {
+        std::memcpy(shift_, other.shift_, sizeof(shift_));
+    }
+
+    BStringSearcher &operator=(const BStringSearcher &other) {
+        if (this != &other) *this = BStringSearcher(other);
+        return *this;
+    }
+
+    BStringSearcher &operator=(BStringSearcher &&other) noexcept {
+        if (this == &other) return *this;
+        needle_ = std::move(other.needle_);
+        len_ = std::exchange(other.len_, 0);
+        std::memcpy(shift_, other.shift_, sizeof(shift_));
+        return *this;
+    }
+
+    /*
+     * @brief 在 hay 的 [from, n) 中查找模式串第一次出现的位置
+     * @param hay  主串
+     * @param n    主串的长度
+     * @param from 开始查找的位置
+     * @return 相对于 hay 的下标，查找失败时返回 npos
+     * */
+    SizeType search(const char *hay, SizeType n, SizeType from = 0) const {
+        if (from > n) return npos;
+
+        SizeType pos;
+        if (len_ > BStringSearch::kShortNeedle) {
+            pos = BStringSearch::horspool(hay + from, n - from, needle_.get(), len_, shift_);
+        } else {
+            pos = BStringSearch::find(hay + from, n - from, needle_.get(), len_);
+        }
+        return pos == npos ? npos : from + pos;
+    }
+
+    // 模式串
+    const char *data() const { return needle_.get(); }
+
+    // 模式串的长度
+    SizeType size() const { return len_; }
+};
+
+#endif //CPPBABYSTL_BABY_STRING_SEARCH_H
@@ -0,0 +1,115 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// BString 使用的批量字符变换：大小写转换、空白字符的识别
+//   1. x86 平台上每次处理 16 个字节（SSE2），尾部逐字节处理
+//   2. 只处理 ASCII 字符，与 locale 无关，UTF-8 中的多字节字符保持不变
+//
+
+#include <cstddef>
+#include <cstdint>
+#include "baby_string_search.h"
+
+#ifndef CPPBABYSTL_BABY_STRING_TRANSFORM_H
+#define CPPBABYSTL_BABY_STRING_TRANSFORM_H
+
+/*
+ * 字符变换的具体实现，所有函数都是无状态的静态函数
+ *
+ * 空白字符与 C locale 下的 isspace 相同：' '、'\t'、'\n'、'\v'、'\f'、'\r'
+ * */
+class BStringTransform {
+public:
+    using SizeType = std::size_t;
+
+private:
+    static bool is_space_(char c) {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+    }
+
+    // 把 [lo, hi] 范围内的字母与 0x20 异或，即大小写互换
+    static void flip_case_scalar_(char *s, SizeType n, char lo, char hi) {
+        for (SizeType i = 0; i < n; i++) {
+            if (static_cast<unsigned char>(s[i] - lo) <= static_cast<unsigned char>(hi - lo)) s[i] ^= 0x20;
+        }
+    }
+
+#ifdef CPPBABYSTL_SEARCH_X86
+    /*
+     * @brief 每次处理 16 个字节：找出落在 [lo, hi] 中的字节，把它们与 0x20 异或
+     *
+     * 使用有符号比较，>= 0x80 的字节是负数，不会落在字母的范围内
+     * */
+    static void flip_case_sse2_(char *s, SizeType n, char lo, char hi) {
+        const __m128i below = _mm_set1_epi8(static_cast<char>(lo - 1));
+        const __m128i above = _mm_set1_epi8(static_cast<char>(hi + 1));
+        const __m128i flip = _mm_set1_epi8(0x20);
+
+        SizeType i = 0;
+        for (; i + 16 <= n; i += 16) {
+            auto p = reinterpret_cast<__m128i *>(s + i);
+            __m128i x = _mm_loadu_si128(p);
+            __m128i in = _mm_and_si128(_mm_cmpgt_epi8(x, below), _mm_cmplt_epi8(x, above));
+            _mm_storeu_si128(p, _mm_xor_si128(x, _mm_and_si128(in, flip)));
+        }
+        flip_case_scalar_(s + i, n - i, lo, hi);
+    }
+
+    // 16 个字节中空白字符的位掩码，第 i 位对应 p[i]
+    static unsigned space_mask_(const char *p) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i sp = _mm_cmpeq_epi8(x, _mm_set1_epi8(' '));
+        __m128i ctl = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8('\t' - 1)),
+                                    _mm_cmplt_epi8(x, _mm_set1_epi8('\r' + 1)));
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(sp, ctl)));
+    }
+#endif
+
+    static void flip_case_(char *s, SizeType n, char lo, char hi) {
+#ifdef CPPBABYSTL_SEARCH_X86
+        flip_case_sse2_(s, n, lo, hi);
+#else
+        flip_case_scalar_(s, n, lo, hi);
+#endif
+    }
+
+public:
+
+    // 把 s 的前 n 个字符中的大写字母原地转换为小写
+    static void to_lower(char *s, SizeType n) { flip_case_(s, n, 'A', 'Z'); }
+
+    // 把 s 的前 n 个字符中的小写字母原地转换为大写
+    static void to_upper(char *s, SizeType n) { flip_case_(s, n, 'a', 'z'); }
+
+    // 返回 s 的前 n 个字符开头的空白字符数目
+    static SizeType count_leading_space(const char *s, SizeType n) {
+        SizeType i = 0;
+#ifdef CPPBABYSTL_SEARCH_X86
+        for (; i + 16 <= n; i += 16) {
+            unsigned mask = space_mask_(s + i);
+            if (mask != 0xFFFF) return i + static_cast<SizeType>(__builtin_ctz(~mask));
+        }
+#endif
+        while (i < n && is_space_(s[i])) i++;
+        return i;
+    }
+
+    // 返回 s 的前 n 个字符末尾的空白字符数目
+    static SizeType count_trailing_space(const char *s, SizeType n) {
+        SizeType i = 0;  // 已经确认的末尾空白字符数目
+#ifdef CPPBABYSTL_SEARCH_X86
+        for (; i + 16 <= n; i += 16) {
+            unsigned mask = space_mask_(s + n - i - 16);
+            if (mask != 0xFFFF) {
+                // 最高的非空白字节之后都是空白字符
+                auto last = static_cast<SizeType>(31 - __builtin_clz(~mask & 0xFFFF));
+                return i + 15 - last;
+            }
+        }
+#endif
+        while (i < n && is_space_(s[n - i - 1])) i++;
+        return i;
+    }
+};
+
+#endif //CPPBABYSTL_BABY_STRING_TRANSFORM_H
@@ -0,0 +1,298 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 不拥有内存的只读字符串视图，类似于 std::string_view
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <functional>
+#include <iostream>
+#include <algorithm>
+#include "baby_hash.h"
+#include "baby_string_search.h"
+#include "baby_string_transform.h"
+#include "baby_vector.h"
+
+#ifndef CPPBABYSTL_BABY_STRING_VIEW_H
+#define CPPBABYSTL_BABY_STRING_VIEW_H
+
+/*
+ * 字符串视图：只保存指向字符数组的指针和长度
+ *
+ * BStringView 不负责管理内存，使用者需要保证视图的生命周期不超过底层
+ * 字符数组。视图中的字符不要求以'\0'结尾，也可以包含'\0'
+ * */
+class BStringView {
+public:
+    using SizeType = std::size_t;
+
+    static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+private:
+    const char *data_{};
+    SizeType size_{};
+
+    /*
+     * @brief 判断 a、b 的前 n 个字节是否相同
+     *
+     * 相等判断不需要像 memcmp 那样找出第一个不同的字节并计算大小关系，
+     * 常见的短键可以内联完成，省去函数调用：
+     *   1. n < 16：用两次相互重叠的 8 / 4 字节整数比较覆盖全部字节
+     *   2. 16 <= n <= 32：用两次相互重叠的 SSE2 16 字节比较覆盖全部字节
+     *   3. n > 32：调用 memcmp，glibc 会根据 CPU 选择 AVX2 / AVX-512 实现，
+     *      对长字符串比手写的 SSE2 循环更快
+     * */
+    static bool equal_bytes_(const char *a, const char *b, SizeType n) {
+        if (n < 16) {
+            if (n >= 8) {
+                return load_<std::uint64_t>(a) == load_<std::uint64_t>(b) &&
+                       load_<std::uint64_t>(a + n - 8) == load_<std::uint64_t>(b + n - 8);
+            }
+            if (n >= 4) {
+                return load_<std::uint32_t>(a) == load_<std::uint32_t>(b) &&
+                       load_<std::uint32_t>(a + n - 4) == load_<std::uint32_t>(b + n - 4);
+            }
+            for (SizeType i = 0; i < n; i++) {
+                if (a[i] != b[i]) return false;
+            }
+            return true;
+        }
+#ifdef CPPBABYSTL_SEARCH_X86
+        if (n <= 32) {
+            return block_equal_(a, b) && block_equal_(a + n - 16, b + n - 16);
+        }
+#endif
+        return std::memcmp(a, b, n) == 0;
+    }
+
+    // 从任意地址读取一个整数，memcpy 会被编译为一条非对齐的 load 指令
+    template<typename Int>
+    static Int load_(const char *p) {
+        Int v;
+        std::memcpy(&v, p, sizeof(Int));
+        return v;
+    }
+
+#ifdef CPPBABYSTL_SEARCH_X86
+    // 比较 a、b 起始的 16 个字节是否相同
+    static bool block_equal_(const char *a, const char *b) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) == 0xFFFF;
+    }
+#endif
+
+public:
+
+    // 默认构造函数：创建一个空视图
+    constexpr BStringView() noexcept = default;
+
+    // 通过字符数组的前 n 个字符进行构造
+    constexpr BStringView(const char *s, SizeType n) noexcept : data_(s), size_(n) {}
+
+    // 通过 c 风格字符串进行构造
+    BStringView(const char *s) : data_(s), size_(std::strlen(s)) {}
+
+    // 通过 std::string 对象进行构造
+    BStringView(const std::string &str) noexcept : data_(str.data()), size_(str.size()) {}
+
+
+// @{  // 与容量和数据访问相关的操作
+public:
+
+    constexpr SizeType size() const noexcept { return size_; }
+
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr const char *data() const noexcept { return data_; }
+
+    constexpr const char *begin() const noexcept { return data_; }
+
+    constexpr const char *end() const noexcept { return data_ + size_; }
+
+    // 返回索引为 idx 的字符，不进行边界检查
+    constexpr const char &operator[](SizeType idx) const { return data_[idx]; }
+
+    // 返回第一个字符，在空视图上调用属于未定义的行为
+    constexpr const char &front() const { return data_[0]; }
+
+    // 返回最后一个字符，在空视图上调用属于未定义的行为
+    constexpr const char &back() const { return data_[size_ - 1]; }
+// @}  // 与容量和数据访问相关的操作
+
+
+// @{  // 修改视图的相关操作
+public:
+
+    // 将视图的起点后移 n 个字符，要求 n <= size()
+    constexpr void remove_prefix(SizeType n) {
+        data_ += n;
+        size_ -= n;
+    }
+
+    // 将视图的终点前移 n 个字符，要求 n <= size()
+    constexpr void remove_suffix(SizeType n) { size_ -= n; }
+
+    /*
+     * @brief 返回从 idx 开始、长度至多为 n 的子视图，不复制任何字符
+     * @throw 当 idx > size() 时，抛出std::out_of_range异常
+     * */
+    BStringView substr(SizeType idx, SizeType n = npos) const {
+        if (idx > size_) {
+            throw std::out_of_range("BStringView::substr");
+        }
+        return BStringView(data_ + idx, std::min(n, size_ - idx));
+    }
+
+    // 返回去掉首尾空白字符后的子视图，空白字符的定义见 BStringTransform
+    BStringView trim() const {
+        SizeType lead = BStringTransform::count_leading_space(data_, size_);
+        if (lead == size_) return BStringView(data_ + size_, 0);
+        SizeType trail = BStringTransform::count_trailing_space(data_ + lead, size_ - lead);
+        return BStringView(data_ + lead, size_ - lead - trail);
+    }
+
+    /*
+     * @brief 按分隔符 delim 切分，把各段的视图依次放入 out
+     * @param out 先被清空再写入，已有的容量会被复用，反复切分时不再申请内存
+     * @return 段数，等于分隔符的数目 + 1
+     *
+     * 相邻的分隔符之间、以及首尾的分隔符之外会产生空视图，
+     * 空视图切分的结果为一个空视图。各段指向当前视图的字符，不复制任何字符
+     * */
+    SizeType split(char delim, BVector<BStringView> &out) const {
+        out.clear();
+        const char *p = data_;
+        const char *last = data_ + size_;
+        for (;;) {
+            auto q = static_cast<const char *>(
+                    p == last ? nullptr : std::memchr(p, delim, static_cast<SizeType>(last - p)));
+            if (q == nullptr) break;
+            out.push_back(BStringView(p, static_cast<SizeType>(q - p)));
+            p = q + 1;
+        }
+        out.push_back(BStringView(p, static_cast<SizeType>(last - p)));
+        return out.size();
+    }
+// @}  // 修改视图的相关操作
+
+
+// @{  // 与查找相关的操作
+public:
+
+    // 在[idx, size())中查找 sv 首次出现的位置
+    SizeType find(BStringView sv, SizeType idx = 0) const {
+        if (idx > size_) return npos;
+        SizeType pos = BStringSearch::find(data_ + idx, size_ - idx, sv.data_, sv.size_);
+        return pos == npos ? npos : idx + pos;
+    }
+
+    // 在[idx, size())中查找字符 c 首次出现的位置
+    SizeType find(char c, SizeType idx = 0) const {
+        return find(BStringView(&c, 1), idx);
+    }
+
+    // 查找 sv 最后一次出现的位置，匹配的起点不超过 idx
+    SizeType rfind(BStringView sv, SizeType idx = npos) const {
+        if (sv.size_ > size_) return npos;
+        SizeType len = std::min(idx, size_ - sv.size_) + sv.size_;
+        return BStringSearch::rfind(data_, len, sv.data_, sv.size_);
+    }
+
+    // 在[idx, size())中查找第一个属于 chars 的字符
+    SizeType find_first_of(BStringView chars, SizeType idx = 0) const {
+        if (idx >= size_) return npos;
+        SizeType pos = BStringSearch::find_first_of(data_ + idx, size_ - idx, chars.data_, chars.size_);
+        return pos == npos ? npos : idx + pos;
+    }
+
+    // 判断视图是否以 sv 开头
+    bool starts_with(BStringView sv) const {
+        return size_ >= sv.size_ && std::memcmp(data_, sv.data_, sv.size_) == 0;
+    }
+
+    // 判断视图是否以 sv 结尾
+    bool ends_with(BStringView sv) const {
+        return size_ >= sv.size_ && std::memcmp(data_ + size_ - sv.size_, sv.data_, sv.size_) == 0;
+    }
+// @}  // 与查找相关的操作
+
+
+// @{  // 比较操作
+public:
+
+    /*
+     * @brief 按字典序比较两个视图
+     * @return 小于、等于、大于 sv 时分别返回负数、0、正数
+     *
+     * 先比较公共前缀，再比较长度，因此可以正确处理包含'\0'的字符串
+     * */
+    int compare(BStringView sv) const {
+        SizeType n = std::min(size_, sv.size_);
+        int ret = n == 0 ? 0 : std::memcmp(data_, sv.data_, n);
+        if (ret != 0) return ret;
+        if (size_ == sv.size_) return 0;
+        return size_ < sv.size_ ? -1 : 1;
+    }
+
+    // 判断两个视图的内容是否相同：长度不同时不需要比较任何字符
+    bool equals(BStringView sv) const {
+        return size_ == sv.size_ && (data_ == sv.data_ || equal_bytes_(data_, sv.data_, size_));
+    }
+// @}  // 比较操作
+
+    // 重载 << 运算符，按长度输出，视图中的'\0'也会被输出
+    friend std::ostream &operator<<(std::ostream &os, BStringView sv) {
+        return os.write(sv.data_, static_cast<std::streamsize>(sv.size_));
+    }
+};
+
+
+/*
+ * 字符串的比较运算符
+ *
+ * BString、std::string 和 c 风格字符串都可以隐式转换为 BStringView，
+ * 因此这组运算符同时负责它们之间的比较，比较过程中不会创建临时字符串
+ * */
+inline bool operator==(BStringView lhs, BStringView rhs) { return lhs.equals(rhs); }
+
+inline bool operator!=(BStringView lhs, BStringView rhs) { return !lhs.equals(rhs); }
+
+inline bool operator<(BStringView lhs, BStringView rhs) { return lhs.compare(rhs) < 0; }
+
+inline bool operator<=(BStringView lhs, BStringView rhs) { return lhs.compare(rhs) <= 0; }
+
+inline bool operator>(BStringView lhs, BStringView rhs) { return lhs.compare(rhs) > 0; }
+
+inline bool operator>=(BStringView lhs, BStringView rhs) { return lhs.compare(rhs) >= 0; }
+
+// 与 std::hash<BString>、BSharedString::hash() 的结果相同，可以用视图查找以字符串为键的哈希表
+namespace std {
+template<>
+struct hash<BStringView> {
+    size_t operator()(BStringView sv) const noexcept {
+        return static_cast<size_t>(BHash::bytes(sv.data(), sv.size()));
+    }
+};
+}  // namespace std
+
+/*
+ * 透明的字符串哈希函数，结果与 std::hash<BStringView> 相同
+ *
+ * 与 std::equal_to<> 一起作为哈希容器的模板实参时，例如
+ * BUnorderedMap<BString, V, BStringHash, std::equal_to<>>，可以直接用
+ * BStringView 或 c 风格字符串查找，查找过程中不会创建临时的 BString
+ * */
+struct BStringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(BStringView sv) const noexcept {
+        return static_cast<std::size_t>(BHash::bytes(sv.data(), sv.size()));
+    }
+};
+
+#endif //CPPBABYSTL_BABY_STRING_VIEW_H
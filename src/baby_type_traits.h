@@ -0,0 +1,83 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 容器内部使用的类型萃取（type traits）
+//
+
+#include <type_traits>
+#include <iterator>
+
+#ifndef CPPBABYSTL_BABY_TYPE_TRAITS_H
+#define CPPBABYSTL_BABY_TYPE_TRAITS_H
+
+/*
+ * @brief 判断类型 Tp 是否可以“平凡重定位”（trivially relocatable）
+ *
+ * 若一个对象可以通过逐字节复制到新地址、并且不再调用原对象的析构函数的方式
+ * 完成搬迁，则称该类型可以平凡重定位。BVector 扩容时会对这样的类型直接
+ * 调用 memcpy / memmove，而不是逐个移动构造再析构
+ *
+ * 默认只有平凡可复制的类型满足要求。不含自引用指针的类型（例如只持有
+ * 堆指针的字符串、智能指针）也可以安全地重定位，使用者可以为其特化：
+ *
+ *     template<>
+ *     struct b_is_trivially_relocatable<MyType> : std::true_type {};
+ *
+ * 注意：libstdc++ 的 std::string 在 SSO 时持有指向自身的指针，不能特化
+ * */
+template<typename Tp>
+struct b_is_trivially_relocatable : std::is_trivially_copyable<Tp> {};
+
+template<typename Tp>
+inline constexpr bool b_is_trivially_relocatable_v = b_is_trivially_relocatable<Tp>::value;
+
+/*
+ * @brief 判断 Iter 是否是随机访问迭代器
+ *
+ * 没有提供 std::iterator_traits 的迭代器（例如部分 B 系列容器的迭代器）
+ * 一律视为非随机访问迭代器
+ * */
+template<typename Iter, typename = void>
+struct b_is_random_access_iterator : std::false_type {};
+
+template<typename Iter>
+struct b_is_random_access_iterator<
+        Iter, std::void_t<typename std::iterator_traits<Iter>::iterator_category>>
+        : std::is_base_of<std::random_access_iterator_tag,
+                          typename std::iterator_traits<Iter>::iterator_category> {};
+
+template<typename Iter>
+inline constexpr bool b_is_random_access_iterator_v = b_is_random_access_iterator<Iter>::value;
+
+// 判断 Iter 是否是前向迭代器，即区间可以被遍历多次
+template<typename Iter, typename = void>
+struct b_is_forward_iterator : std::false_type {};
+
+template<typename Iter>
+struct b_is_forward_iterator<
+        Iter, std::void_t<typename std::iterator_traits<Iter>::iterator_category>>
+        : std::is_base_of<std::forward_iterator_tag,
+                          typename std::iterator_traits<Iter>::iterator_category> {};
+
+template<typename Iter>
+inline constexpr bool b_is_forward_iterator_v = b_is_forward_iterator<Iter>::value;
+
+/*
+ * @brief 判断比较器 Compare 是否是“透明”的（声明了 is_transparent 类型）
+ *
+ * 透明比较器（如 std::less<>）可以直接比较不同类型的对象，关联容器据此
+ * 启用异构查找。b_transparent_key_t 只在 Compare 透明时才有定义，用于
+ * 在模板参数中进行 SFINAE；KeyArg 参与推导，保证替换失败发生在重载决议阶段
+ * */
+template<typename Compare, typename KeyArg, typename = void>
+struct b_transparent_key {};
+
+template<typename Compare, typename KeyArg>
+struct b_transparent_key<Compare, KeyArg, std::void_t<typename Compare::is_transparent>> {
+    using type = KeyArg;
+};
+
+template<typename Compare, typename KeyArg>
+using b_transparent_key_t = typename b_transparent_key<Compare, KeyArg>::type;
+
+#endif //CPPBABYSTL_BABY_TYPE_TRAITS_H
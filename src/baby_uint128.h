@@ -0,0 +1,42 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 64 x 64 -> 128 位无符号乘法，供浮点数转换和哈希函数使用
+//
+
+#include <cstdint>
+
+#ifndef CPPBABYSTL_BABY_UINT128_H
+#define CPPBABYSTL_BABY_UINT128_H
+
+#ifdef __SIZEOF_INT128__
+// GCC / Clang 提供的 128 位整数是语言扩展，__extension__ 避免 -Wpedantic 警告
+__extension__ typedef unsigned __int128 b_uint128_t;
+#endif
+
+/*
+ * @brief 计算 a * b 的 128 位乘积
+ * @param hi 用于返回乘积的高 64 位
+ * @return 乘积的低 64 位
+ *
+ * 支持 128 位整数时编译为一条乘法指令，否则拆分为四个 32 x 32 位的部分积
+ * */
+inline std::uint64_t b_mul_128(std::uint64_t a, std::uint64_t b, std::uint64_t &hi) noexcept {
+#ifdef __SIZEOF_INT128__
+    b_uint128_t r = static_cast<b_uint128_t>(a) * b;
+    hi = static_cast<std::uint64_t>(r >> 64);
+    return static_cast<std::uint64_t>(r);
+#else
+    std::uint64_t ha = a >> 32, hb = b >> 32;
+    std::uint64_t la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+    std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t carry = t < rl;
+    std::uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    return lo;
+#endif
+}
+
+#endif //CPPBABYSTL_BABY_UINT128_H
@@ -0,0 +1,296 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于开放寻址哈希表的无序关联容器 BUnorderedMap
+//
+
+#include "swiss_table.h"
+
+#ifndef CPPBABYSTL_BABY_UNORDERED_MAP_H
+#define CPPBABYSTL_BABY_UNORDERED_MAP_H
+
+/*
+ * 无序的`键值对`容器，接口与 BMap 相同，但不提供 lower_bound / upper_bound
+ *
+ * 元素直接存放在 SwissTable 的槽数组中，查找、插入和删除的平均时间复杂度
+ * 为 O(1)。与 std::unordered_map 不同，扩容和插入会移动元素，因此任何插入
+ * 都可能使迭代器以及元素的引用失效
+ *
+ * 与 std::unordered_map 相同，insert / emplace 遇到已经存在的`键`时不会
+ * 修改原来的`值`，需要覆盖时使用 insert_or_assign 或 operator[]
+ * */
+template<typename K, typename V,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>,
+         typename Alloc = std::allocator<std::pair<const K, V>>>
+class BUnorderedMap {
+public:
+    using TableType = SwissTable<K, SwissMapSlot<K, V>, Hash, KeyEqual, Alloc>;
+    using Iterator = typename TableType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TableType table_;
+
+    // Hash 和 KeyEqual 都声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Hash, b_transparent_key_t<KeyEqual, KeyArg>>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    // 默认构造函数
+    BUnorderedMap() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BUnorderedMap(const Alloc &alloc) : table_(alloc) {}
+
+    // 拷贝构造函数：元素被复制到与 other 相同的槽中，不重新计算哈希值
+    BUnorderedMap(const BUnorderedMap &other) = default;
+
+    // 移动构造函数
+    BUnorderedMap(BUnorderedMap &&other) noexcept = default;
+
+    // 通过初始化列表进行构造
+    BUnorderedMap(std::initializer_list<std::pair<K, V>> init_list) {
+        this->insert(init_list);
+    }
+
+    template<typename InputIter>
+    BUnorderedMap(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BUnorderedMap() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{ 与赋值运算相关的操作
+public:
+
+    BUnorderedMap &operator=(const BUnorderedMap &other) = default;
+
+    BUnorderedMap &operator=(BUnorderedMap &&other) noexcept = default;
+
+    // 将一个初始化列表赋值给当前容器
+    BUnorderedMap &operator=(std::initializer_list<std::pair<K, V>> init_list) {
+        table_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @} // 与赋值运算相关的操作
+
+
+// @{ // 元素访问相关的操作
+public:
+
+    V &at(const K &key) {
+        auto iter = table_.find(key);
+        if (iter == table_.end()) {
+            throw std::out_of_range("BUnorderedMap::at");
+        }
+        return (*iter).second;
+    }
+
+    const V &at(const K &key) const {
+        return const_cast<BUnorderedMap *>(this)->at(key);
+    }
+
+    // `键`不存在时插入一个`值`被值初始化的元素
+    V &operator[](const K &key) {
+        return (*table_.try_emplace(key).first).second;
+    }
+
+    V &operator[](K &&key) {
+        return (*table_.try_emplace(std::move(key)).first).second;
+    }
+// @} // 元素访问相关的操作
+
+
+// @{  // 迭代器，直接复用哈希表的迭代器，遍历顺序与插入顺序无关
+public:
+
+    Iterator begin() { return table_.begin(); }
+    Iterator begin() const { return table_.begin(); }
+    Iterator end() { return table_.end(); }
+    Iterator end() const { return table_.end(); }
+// @}  // 迭代器，直接复用哈希表的迭代器，遍历顺序与插入顺序无关
+
+
+// @{  // 容量相关的操作
+public:
+
+    // 检查容器是否为空
+    bool empty() const noexcept {
+        return table_.size() == 0;
+    }
+
+    // 返回容器的元素数目
+    SizeType size() const noexcept {
+        return table_.size();
+    }
+
+    // 返回槽的数目
+    SizeType bucket_count() const noexcept {
+        return table_.capacity();
+    }
+
+    float load_factor() const noexcept {
+        return table_.load_factor();
+    }
+
+    // 预留至少能容纳 n 个元素的空间，已知元素数目时可以避免多次扩容
+    void reserve(SizeType n) {
+        table_.reserve(n);
+    }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return table_.get_allocator(); }
+// @}  // 容量相关的操作
+
+
+// @{  // 向容器中添加元素相关的操作
+public:
+
+    std::pair<Iterator, bool>
+    insert(const std::pair<K, V> &value) {
+        return table_.try_emplace(value.first, value.second);
+    }
+
+    std::pair<Iterator, bool>
+    insert(std::pair<K, V> &&value) {
+        return table_.try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        while (beg != end) {
+            auto &[k, v] = *beg;
+            table_.try_emplace(k, v);
+            ++beg;
+        }
+    }
+
+    void insert(std::initializer_list<std::pair<K, V>> init_list) {
+        table_.reserve(table_.size() + init_list.size());
+        for (const auto &[k, v] : init_list) {
+            table_.try_emplace(k, v);
+        }
+    }
+
+    // `键`不存在时插入，存在时用 val 覆盖原来的`值`
+    template<typename ValArg>
+    std::pair<Iterator, bool>
+    insert_or_assign(const K &key, ValArg &&val) {
+        auto res = table_.try_emplace(key, std::forward<ValArg>(val));
+        if (!res.second) (*res.first).second = std::forward<ValArg>(val);
+        return res;
+    }
+
+    // args 被转发给`值`的构造函数，`键`已经存在时不构造任何对象
+    template<typename ...Args>
+    std::pair<Iterator, bool>
+    emplace(const K &key, Args &&...args) {
+        return table_.try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template<typename ...Args>
+    std::pair<Iterator, bool>
+    emplace(K &&key, Args &&...args) {
+        return table_.try_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+// @}  // 向容器中添加元素相关的操作
+
+
+// @{  // 在容器中删除元素相关的操作
+public:
+
+    // 删除所有元素，保留已经申请的槽数组
+    void clear() noexcept {
+        table_.clear();
+    }
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    SizeType erase(const K &key) { return table_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器仍然有效
+    Iterator erase(Iterator pos) { return table_.erase(pos); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return table_.erase(key); }
+
+    void swap(BUnorderedMap &other) noexcept {
+        table_.swap(other.table_);
+    }
+// @}  // 在容器中删除元素相关的操作
+
+
+// @{  // 与查找相关的操作
+public:
+
+    // 返回键为`key`的元素数，非 0 即 1
+    SizeType count(const K &key) const {
+        return table_.contains(key);
+    }
+
+    bool contains(const K &key) const {
+        return table_.contains(key);
+    }
+
+    // 返回指向键为`key`的迭代器，若不存在键为`key`的元素，返回 end()
+    Iterator find(const K &key) {
+        return table_.find(key);
+    }
+
+    Iterator find(const K &key) const {
+        return table_.find(key);
+    }
+
+    /*
+     * 异构查找：当 Hash 和 KeyEqual 都是透明的（如 BStringHash 与
+     * std::equal_to<>）时，可以直接使用与 K 可比较的其他类型查找，例如用
+     * BStringView 查找 BString 类型的键，而不必先构造一个临时的 K。
+     * 两者对相等的对象必须计算出相同的哈希值
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return table_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    bool contains(const KeyArg &key) const {
+        return table_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return table_.find(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return table_.find(key);
+    }
+// @}  // 与查找相关的操作
+};
+
+// 判断两个 BUnorderedMap 容器是否相等：元素数目相同，且 x 中的每个`键值对`都在 y 中
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+bool operator==(const BUnorderedMap<K, V, Hash, KeyEqual, Alloc> &x,
+                const BUnorderedMap<K, V, Hash, KeyEqual, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    for (auto [k, v] : x) {
+        auto iter = y.find(k);
+        if (iter == y.end() || !((*iter).second == v)) return false;
+    }
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Alloc>
+bool operator!=(const BUnorderedMap<K, V, Hash, KeyEqual, Alloc> &x,
+                const BUnorderedMap<K, V, Hash, KeyEqual, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_UNORDERED_MAP_H
@@ -0,0 +1,237 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 基于开放寻址哈希表的无序集合 BUnorderedSet
+//
+
+#include "swiss_table.h"
+
+#ifndef CPPBABYSTL_BABY_UNORDERED_SET_H
+#define CPPBABYSTL_BABY_UNORDERED_SET_H
+
+/*
+ * 无序集合，接口与 BSet 相同，但不提供 lower_bound / upper_bound
+ *
+ * `键`直接存放在 SwissTable 的槽数组中，任何插入都可能使迭代器以及
+ * 元素的引用失效
+ * */
+template<typename K,
+         typename Hash = std::hash<K>,
+         typename KeyEqual = std::equal_to<K>,
+         typename Alloc = std::allocator<K>>
+class BUnorderedSet {
+public:
+    using TableType = SwissTable<K, SwissSetSlot<K>, Hash, KeyEqual, Alloc>;
+    using Iterator = typename TableType::Iterator;
+    using SizeType = std::size_t;
+
+private:
+    TableType table_;
+
+    // Hash 和 KeyEqual 都声明了 is_transparent 时才启用异构查找
+    template<typename KeyArg>
+    using TransparentKey = b_transparent_key_t<Hash, b_transparent_key_t<KeyEqual, KeyArg>>;
+
+// @{  // 各类构造函数 / 析构函数
+public:
+
+    // 默认构造函数
+    BUnorderedSet() = default;
+
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BUnorderedSet(const Alloc &alloc) : table_(alloc) {}
+
+    // 拷贝构造函数：元素被复制到与 other 相同的槽中，不重新计算哈希值
+    BUnorderedSet(const BUnorderedSet &other) = default;
+
+    // 移动构造函数
+    BUnorderedSet(BUnorderedSet &&other) noexcept = default;
+
+    // 通过初始化列表构造对象
+    BUnorderedSet(std::initializer_list<K> init_list) {
+        this->insert(init_list);
+    }
+
+    template<typename InputIter>
+    BUnorderedSet(InputIter beg, InputIter end) {
+        this->insert(beg, end);
+    }
+
+    ~BUnorderedSet() = default;
+// @}  // 各类构造函数 / 析构函数
+
+
+// @{  // 赋值运算符相关操作
+public:
+
+    BUnorderedSet &operator=(const BUnorderedSet &other) = default;
+
+    BUnorderedSet &operator=(BUnorderedSet &&other) noexcept = default;
+
+    // 通过初始化列表赋值
+    BUnorderedSet &operator=(std::initializer_list<K> init_list) {
+        table_.clear();
+        this->insert(init_list);
+        return *this;
+    }
+// @}  // 赋值运算符相关操作
+
+
+// @{  // 迭代器相关，直接复用哈希表的迭代器，遍历顺序与插入顺序无关
+public:
+
+    Iterator begin() { return table_.begin(); }
+    Iterator begin() const { return table_.begin(); }
+    Iterator end() { return table_.end(); }
+    Iterator end() const { return table_.end(); }
+// @}  // 迭代器相关，直接复用哈希表的迭代器，遍历顺序与插入顺序无关
+
+
+// @{  // 与容量相关的操作
+public:
+
+    // 检查容器是否为空
+    bool empty() const noexcept {
+        return table_.size() == 0;
+    }
+
+    // 返回容器中的元素数
+    SizeType size() const noexcept {
+        return table_.size();
+    }
+
+    // 返回槽的数目
+    SizeType bucket_count() const noexcept {
+        return table_.capacity();
+    }
+
+    float load_factor() const noexcept {
+        return table_.load_factor();
+    }
+
+    // 预留至少能容纳 n 个元素的空间，已知元素数目时可以避免多次扩容
+    void reserve(SizeType n) {
+        table_.reserve(n);
+    }
+
+    // 返回容器所使用的分配器
+    Alloc get_allocator() const { return table_.get_allocator(); }
+// @}  // 与容量相关的操作
+
+
+// @{  // 向容器中增加元素相关的操作
+public:
+
+    std::pair<Iterator, bool> insert(const K &key) {
+        return table_.try_emplace(key);
+    }
+
+    std::pair<Iterator, bool> insert(K &&key) {
+        return table_.try_emplace(std::move(key));
+    }
+
+    template<typename InputIter>
+    void insert(InputIter beg, InputIter end) {
+        while (beg != end) {
+            table_.try_emplace(*beg);
+            ++beg;
+        }
+    }
+
+    void insert(std::initializer_list<K> init_list) {
+        table_.reserve(table_.size() + init_list.size());
+        for (const auto &it : init_list) table_.try_emplace(it);
+    }
+// @}  // 向容器中增加元素相关的操作
+
+
+// @{  // 向容器中删除元素的相关操作
+public:
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    SizeType erase(const K &key) { return table_.erase(key); }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器仍然有效
+    Iterator erase(Iterator pos) { return table_.erase(pos); }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType erase(const KeyArg &key) { return table_.erase(key); }
+
+    // 删除所有元素，保留已经申请的槽数组
+    void clear() noexcept { table_.clear(); }
+// @}  // 向容器中删除元素的相关操作
+
+
+public:
+    // 交换两个容器中的内容
+    void swap(BUnorderedSet &other) noexcept {
+        table_.swap(other.table_);
+    }
+
+
+// @{  // 与元素查找相关的操作
+public:
+
+    // 返回键为`key`的元素数，非 0 即 1
+    SizeType count(const K &key) const {
+        return table_.contains(key);
+    }
+
+    bool contains(const K &key) const {
+        return table_.contains(key);
+    }
+
+    // 寻找键为`key`的元素
+    Iterator find(const K &key) {
+        return table_.find(key);
+    }
+
+    Iterator find(const K &key) const {
+        return table_.find(key);
+    }
+
+    /*
+     * 异构查找：当 Hash 和 KeyEqual 都是透明的（如 BStringHash 与
+     * std::equal_to<>）时，可以直接使用与 K 可比较的其他类型查找
+     * */
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    SizeType count(const KeyArg &key) const {
+        return table_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    bool contains(const KeyArg &key) const {
+        return table_.contains(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return table_.find(key);
+    }
+
+    template<typename KeyArg, typename = TransparentKey<KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return table_.find(key);
+    }
+// @}  // 与元素查找相关的操作
+};
+
+// 判断两个 BUnorderedSet 容器是否相等：元素数目相同，且 x 中的每个`键`都在 y 中
+template<typename K, typename Hash, typename KeyEqual, typename Alloc>
+bool operator==(const BUnorderedSet<K, Hash, KeyEqual, Alloc> &x,
+                const BUnorderedSet<K, Hash, KeyEqual, Alloc> &y) {
+    if (x.size() != y.size()) return false;
+
+    for (const auto &key : x) {
+        if (!y.contains(key)) return false;
+    }
+    return true;
+}
+
+template<typename K, typename Hash, typename KeyEqual, typename Alloc>
+bool operator!=(const BUnorderedSet<K, Hash, KeyEqual, Alloc> &x,
+                const BUnorderedSet<K, Hash, KeyEqual, Alloc> &y) {
+    return !(x == y);
+}
+
+#endif //CPPBABYSTL_BABY_UNORDERED_SET_H
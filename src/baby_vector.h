@@ -6,34 +6,152 @@
 #include <memory>
 #include <iostream>
 #include <initializer_list>
+#include <iterator>
 #include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "baby_type_traits.h"
+#include "baby_alloc_holder.h"
 
 #ifndef CPPBABYSTL_BABY_VECTOR_H
 #define CPPBABYSTL_BABY_VECTOR_H
 
-template<typename Tp>
-class BVector {
+// @{  // BVector 的扩容策略
+/*
+ * 扩容策略决定容量不足时新数组的大小，需要提供静态成员函数：
+ *
+ *     static std::size_t next_capacity(std::size_t capacity,
+ *                                      std::size_t need,
+ *                                      std::size_t elem_size);
+ *
+ * 其中 capacity 为当前容量，need 为至少需要容纳的元素数量，elem_size 为
+ * 单个元素的字节数，返回值不能小于 need
+ *
+ * 策略中声明 static constexpr bool kRecordStats = true 时，BVector 额外记录
+ * 重新分配的统计信息（capacity_stats()），见 BVectorStatsGrowth
+ * */
+
+// 每次扩大为原来的 2 倍，扩容次数最少（默认策略）
+struct BVectorDoubleGrowth {
+    static std::size_t next_capacity(std::size_t capacity, std::size_t need, std::size_t) {
+        return std::max(need, 2 * capacity);
+    }
+};
+
+// 每次扩大为原来的 1.5 倍，浪费的空间更少，且释放的旧数组有机会被后续扩容复用
+struct BVectorHalfGrowth {
+    static std::size_t next_capacity(std::size_t capacity, std::size_t need, std::size_t) {
+        return std::max(need, capacity + capacity / 2);
+    }
+};
+
+/*
+ * 按 2 倍扩容，但当数组超过一页（4 KiB）时将字节数向上取整到页的整数倍，
+ * 使大数组恰好占满分配器返回的整页内存
+ * */
+struct BVectorPageGrowth {
+    static constexpr std::size_t kPageSize = 4096;
+
+    static std::size_t next_capacity(std::size_t capacity, std::size_t need, std::size_t elem_size) {
+        std::size_t cnt = std::max(need, 2 * capacity);
+        std::size_t bytes = cnt * elem_size;
+        if (bytes < kPageSize) return cnt;
+
+        bytes = (bytes + kPageSize - 1) / kPageSize * kPageSize;
+        return bytes / elem_size;
+    }
+};
+
+// 扩容方式与 Growth 相同，并开启重新分配统计，用于调试和基准测试
+template<typename Growth = BVectorDoubleGrowth>
+struct BVectorStatsGrowth : Growth {
+    static constexpr bool kRecordStats = true;
+};
+
+// 扩容策略 Growth 是否开启了重新分配统计
+template<typename Growth, typename = void>
+struct b_growth_records_stats : std::false_type {};
+
+template<typename Growth>
+struct b_growth_records_stats<Growth, std::void_t<decltype(Growth::kRecordStats)>>
+        : std::bool_constant<Growth::kRecordStats> {};
+
+// 底层数组重新分配的统计信息，见 BVector::capacity_stats()
+struct BVectorCapacityStats {
+    std::size_t reallocations;  // 分配新数组的次数
+    std::size_t bytes_copied;   // 搬迁旧元素时复制的字节数
+};
+
+// 保存统计信息的基类，未开启统计时是空类，通过空基类优化不占用空间
+template<bool Record>
+struct BVectorStatsHolder {};
+
+template<>
+struct BVectorStatsHolder<true> {
+    BVectorCapacityStats stats_{};  // 当前容器对象自身的重新分配统计
+};
+// @}  // BVector 的扩容策略
+
+
+template<typename Tp, typename Alloc = std::allocator<Tp>,
+        typename Growth = BVectorDoubleGrowth>
+class BVector : private BAllocHolder<typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>>,
+                private BVectorStatsHolder<b_growth_records_stats<Growth>::value> {
 public:
     using SizeType = std::size_t;
+    using AllocatorType = typename std::allocator_traits<Alloc>::template rebind_alloc<Tp>;
+
+    using CapacityStats = BVectorCapacityStats;
+
+    // 是否记录重新分配统计，由扩容策略 Growth 决定
+    static constexpr bool kRecordStats = b_growth_records_stats<Growth>::value;
 
 private:
+    using AllocTraits = std::allocator_traits<AllocatorType>;
+    using AllocHolder = BAllocHolder<AllocatorType>;
+    using AllocHolder::alloc_;   // 分配底层数组所用的分配器
+
     Tp *start_{};           // 指向容器的首元素
     Tp *finish_{};          // 指向容器的已使用空间的结束位置
     Tp *end_of_storage_{};  // 指向容器的开辟空间的结束位置
 
 private:
     /*
-     * @brief 将数组 src 中前 n 个元素复制到数组 dst 中，同时将 src 中前 n 个元素置为空
-     * @param dst 指向目标数组的指针
+     * @brief 将数组 src 中前 n 个元素搬迁到未初始化的数组 dst 中
+     * @param dst 指向目标数组的指针，[dst, dst + n) 尚未构造
      * @param src 指向源数组的指针
-     * @param n   需要复制的元素数量
+     * @param n   需要搬迁的元素数量
      *
-     * 不进行越界检查，调用者需保证参数的合法性
+     * 可以平凡重定位的类型直接按字节复制；其余类型在移动构造不会抛出异常
+     * （或者无法拷贝）时逐个移动构造，否则拷贝构造，使扩容失败时原数组保持不变。
+     * 搬迁完成后 src 中前 n 个元素的生命周期已经结束，只剩下未初始化的内存
+     * */
+    void relocate_(Tp *dst, Tp *src, SizeType n) {
+        if constexpr (b_is_trivially_relocatable_v<Tp>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(Tp));
+            }
+        } else {
+            move_construct_(dst, src, n);
+            destruct_range_(src, src + n);
+        }
+    }
+
+    /*
+     * 用 src 中前 n 个元素在未初始化的数组 dst 中逐个构造新元素（移动构造不会抛出
+     * 异常时移动，否则拷贝），src 中的元素不析构。构造失败时析构已经构造的部分，
+     * 此时若走的是拷贝路径，src 保持不变
      * */
-    static void move_copy_(Tp *dst, Tp *src, SizeType n) {
-        for (SizeType i = 0; i < n; i++) {
-            std::memcpy(&dst[i], &src[i], sizeof(Tp));
-            std::memset(&src[i], 0, sizeof(Tp));
+    void move_construct_(Tp *dst, Tp *src, SizeType n) {
+        SizeType i = 0;
+        try {
+            for (; i < n; i++) {
+                AllocTraits::construct(alloc_(), dst + i, std::move_if_noexcept(src[i]));
+            }
+        } catch (...) {
+            destruct_range_(dst, dst + i);
+            throw;
         }
     }
 
@@ -43,15 +161,26 @@ private:
      * @param end 结束位置的下一个位置
      * @param cnt 需要移动的数目
      *
-     * 调用该函数需要保证`数组`的空间 >= cnt + size()，此外还需确保
-     * 被覆盖掉的位置的数据已经无效或已被正确析构
+     * 调用前 [end, end + cnt) 必须是容量以内的未初始化内存；调用后
+     * [beg, beg + cnt) 变为未初始化内存，等待调用者在其中构造新元素。
+     * 可以平凡重定位的类型只调用一次 memmove
      * */
-    static void move_right_(Tp *beg, Tp *end, SizeType cnt) {
-        for (auto it = end - 1; it >= beg; --it) {
-            // 此处使用memcpy是不想触发对象的拷贝构造函数，减少不必要的额外开销
-            // 类似对象的移动语义，但如果Tp类没有定义移动语义，仍然会使用拷贝构造
-            std::memcpy(it + cnt, it, sizeof(Tp));
-            std::memset(it, 0, sizeof(Tp));
+    void move_right_(Tp *beg, Tp *end, SizeType cnt) {
+        if (beg == end || cnt == 0) return;
+        if constexpr (b_is_trivially_relocatable_v<Tp>) {
+            std::memmove(static_cast<void *>(beg + cnt), static_cast<const void *>(beg),
+                         SizeType(end - beg) * sizeof(Tp));
+        } else {
+            // 目标位置 >= end 的是未初始化内存，需要构造；其余位置上的元素仍然存活，直接移动赋值
+            for (Tp *src = end, *dst = end + cnt; src != beg;) {
+                --src, --dst;
+                if (dst >= end) {
+                    AllocTraits::construct(alloc_(), dst, std::move(*src));
+                } else {
+                    *dst = std::move(*src);
+                }
+            }
+            destruct_range_(beg, std::min(beg + cnt, end));
         }
     }
 
@@ -61,13 +190,58 @@ private:
      * @param end 结束位置的下一个位置
      * @param cnt 需要移动的数目
      *
-     * 调用该函数需要保证`数组`的空间 >= cnt + size()，此外还需确保
-     * 被覆盖掉的位置的数据已经无效或已被正确析构
+     * 调用前 [beg - cnt, beg) 必须是已经析构的内存；调用后
+     * [end - cnt, end) 变为未初始化内存。
+     * 可以平凡重定位的类型只调用一次 memmove
      * */
-    static void move_left_(Tp *beg, Tp *end, SizeType cnt) {
-        for (auto it = beg; it != end; ++it) {
-            std::memcpy(it - cnt, it, sizeof(Tp));
-            std::memset(it, 0, sizeof(Tp));
+    void move_left_(Tp *beg, Tp *end, SizeType cnt) {
+        if (beg == end || cnt == 0) return;
+        if constexpr (b_is_trivially_relocatable_v<Tp>) {
+            std::memmove(static_cast<void *>(beg - cnt), static_cast<const void *>(beg),
+                         SizeType(end - beg) * sizeof(Tp));
+        } else {
+            // 目标位置 < beg 的是已经析构的内存，需要构造；其余位置直接移动赋值
+            for (Tp *src = beg, *dst = beg - cnt; src != end; ++src, ++dst) {
+                if (dst < beg) {
+                    AllocTraits::construct(alloc_(), dst, std::move(*src));
+                } else {
+                    *dst = std::move(*src);
+                }
+            }
+            destruct_range_(std::max(end - cnt, beg), end);
+        }
+    }
+
+    /*
+     * @brief 在索引 idx 处空出 cnt 个未初始化的位置
+     * @param idx 空位的起始索引，[0, size()]
+     * @param cnt 空位的数量
+     * @return 指向第一个空位的指针
+     *
+     * 容量不足时直接把 [0, idx) 和 [idx, size()) 搬迁到新数组中空位的两侧，
+     * 每个元素只移动一次。调用后 finish_ 保持不变，由调用者在空位中构造
+     * 元素后再更新；构造失败时需调用 close_gap_ 恢复原状
+     * */
+    Tp *open_gap_(SizeType idx, SizeType cnt);
+
+    // 撤销 open_gap_(idx, cnt)，调用前需要保证空位中没有存活的对象
+    void close_gap_(SizeType idx, SizeType cnt) {
+        move_left_(start_ + idx + cnt, finish_ + cnt, cnt);
+    }
+
+    /*
+     * @brief 返回迭代器范围 [first, last) 中的元素个数
+     *
+     * 随机访问迭代器直接相减，其余迭代器逐个计数，因此至少需要是前向迭代器
+     * */
+    template<typename Iter>
+    static SizeType distance_(Iter first, Iter last) {
+        if constexpr (b_is_random_access_iterator_v<Iter>) {
+            return SizeType(last - first);
+        } else {
+            SizeType n = 0;
+            for (; first != last; ++first) ++n;
+            return n;
         }
     }
 
@@ -75,77 +249,133 @@ private:
 // @{  // 各种构造函数 / 析构函数
 private:
     /*
-     * @brief 动态调整内存容量
-     * @param new_capacity 新请求的容量大小
-     * @param old_capacity 当前容器的原始容量大小
+     * @brief 计算容纳 need 个元素时应当开辟的容量
+     * @param need 至少需要容纳的元素数量
+     *
+     * 具体的增长倍率由扩容策略 Growth 决定
+     * */
+    SizeType grow_capacity_(SizeType need) const {
+        if (need > this->max_size()) {
+            throw std::length_error("BVector");
+        }
+        SizeType cap = Growth::next_capacity(this->capacity(), need, sizeof(Tp));
+        return std::min(std::max(cap, need), this->max_size());
+    }
+
+    // 记录一次重新分配，len 为搬迁的元素数目
+    void record_realloc_(SizeType len) {
+        if constexpr (kRecordStats) {
+            ++this->stats_.reallocations;
+            this->stats_.bytes_copied += len * sizeof(Tp);
+        }
+    }
+
+    /*
+     * @brief 将底层数组重新分配为恰好能容纳 new_capacity 个元素的未初始化内存
+     * @param new_capacity 新数组的容量，需保证 new_capacity >= size()
+     *
+     * 原有的元素通过 relocate_ 搬迁到新数组中，不会构造多余的对象
+     * */
+    void reallocate_(SizeType new_capacity);
+
+    /*
+     * @brief 在扩容的同时于容器尾部构造一个新元素
+     * @param args 转发到元素构造函数的实参
      *
-     * 注意：实际分配的新空间大小并不一定是 new_capacity
+     * 先在新数组中构造新元素再搬迁旧元素，因此 args 引用容器中的元素也是安全的
      * */
-    void adjust_capacity_(SizeType new_capacity, SizeType old_capacity);
+    template<typename... Args>
+    void realloc_append_(Args &&... args);
 
     /*
-     * @brief 将数组 src 中前 n 个元素复制到数组 dst 中
-     * @param dst 指向目标数组的指针
+     * @brief 将数组 src 中前 n 个元素拷贝构造到未初始化的数组 dst 中
+     * @param dst 指向目标数组的指针，[dst, dst + n) 尚未构造
      * @param src 指向源数组的指针
      * @param n   需要复制的元素数量
      *
      * 不进行越界检查，调用者需保证参数的合法性
      * */
-    static void copy_(Tp *dst, const Tp *src, SizeType n) {
-        for (SizeType i = 0; i < n; i++) {
-            dst[i] = src[i];
+    void copy_(Tp *dst, const Tp *src, SizeType n) {
+        if constexpr (std::is_trivially_copyable_v<Tp>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(Tp));
+            }
+        } else {
+            for (SizeType i = 0; i < n; i++) {
+                AllocTraits::construct(alloc_(), dst + i, src[i]);
+            }
         }
     }
 
-    // 释放BVector容器底层数组的内存空间
+    /*
+     * @brief 释放BVector容器底层数组的内存空间
+     *
+     * 只有 [start_, finish_) 内的元素已经构造，[finish_, end_of_storage_)
+     * 是未初始化的内存，析构已有元素后将整个数组交还给分配器
+     * */
     void destroy_() {
-        delete[] start_;
+        if (start_ != nullptr) {
+            destruct_range_(start_, finish_);
+            AllocTraits::deallocate(alloc_(), start_, this->capacity());
+        }
         start_ = finish_ = end_of_storage_ = nullptr;
     }
 
+    // 接管 other 的底层数组，调用前需要保证当前容器已经释放
+    void steal_(BVector &other) noexcept {
+        start_ = other.start_;
+        finish_ = other.finish_;
+        end_of_storage_ = other.end_of_storage_;
+
+        other.start_ = other.finish_ = other.end_of_storage_ = nullptr;
+    }
+
 public:
 
     // 默认构造函数
     BVector() = default;
 
+    // 创建一个使用分配器 alloc 的空容器
+    explicit BVector(const Alloc &alloc) : AllocHolder(AllocatorType(alloc)) {}
+
     // 拷贝构造函数
-    BVector(const BVector &other) {
-        adjust_capacity_(other.size(), 0);
+    BVector(const BVector &other)
+            : AllocHolder(AllocTraits::select_on_container_copy_construction(other.alloc_())) {
+        reallocate_(other.size());
         copy_(start_, other.start_, other.size());
         finish_ = start_ + other.size();
     }
 
     // 移动构造函数
-    BVector(BVector &&other) noexcept {
-        start_ = other.start_;
-        finish_ = other.finish_;
-        end_of_storage_ = other.end_of_storage_;
-
-        other.start_ = other.finish_ = other.end_of_storage_ = nullptr;
+    BVector(BVector &&other) noexcept : AllocHolder(std::move(other.alloc_())) {
+        steal_(other);
     }
 
     // 创建一个长度为 n，值全为默认值的容器
     explicit BVector(SizeType n) {
         // 开辟存储空间
-        adjust_capacity_(n, 0);
-        finish_ = start_ + n;
+        reallocate_(n);
+
+        for (SizeType i = 0; i < n; i++, ++finish_) {
+            // 值初始化，基本数据类型被置为 0
+            AllocTraits::construct(alloc_(), finish_);
+        }
     }
 
     // 创建一个长度为 n，值全为 val 的容器
     explicit BVector(SizeType n, const Tp &val) {
         // 开辟存储空间
-        adjust_capacity_(n, 0);
+        reallocate_(n);
 
-        for (SizeType i = 0; i < n; i++) {
+        for (SizeType i = 0; i < n; i++, ++finish_) {
             // 调用 Tp 类型的拷贝构造函数
-            new(start_ + i) Tp(val);
+            AllocTraits::construct(alloc_(), finish_, val);
         }
-        finish_ = start_ + n;
     }
 
     // 使用初始化列表构造容器
     BVector(std::initializer_list<Tp> init_list) {
-        adjust_capacity_(init_list.size(), 0);
+        reallocate_(init_list.size());
         copy_(start_, init_list.begin(), init_list.size());
         finish_ = start_ + init_list.size();
     }
@@ -167,8 +397,8 @@ private:
      * 保证[beg, end)位置的合法
      * */
     static void destruct_range_(Tp *beg, Tp *end) {
-        // 基本数据类型无需调用析构函数
-        if (std::is_fundamental_v<Tp>) return;
+        // 平凡析构的类型无需调用析构函数
+        if (std::is_trivially_destructible_v<Tp>) return;
 
         for (auto it = beg; it != end; ++it) {
             it->~Tp();
@@ -190,17 +420,38 @@ public:
     // 拷贝赋值函数
     BVector &operator=(const BVector &other) {
         if (this == &other) return *this;  // 防止自赋值
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (alloc_() != other.alloc_()) destroy_();  // 旧数组只能由旧分配器释放
+            alloc_() = other.alloc_();
+        }
         assign_(other.begin(), other.end());
         return *this;
     }
 
-    // 移动赋值函数
-    BVector &operator=(BVector &&other) noexcept {
-        start_ = other.start_;
-        finish_ = other.finish_;
-        end_of_storage_ = other.end_of_storage_;
-
-        other.start_ = other.finish_ = other.end_of_storage_ = nullptr;
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的底层数组；
+     * 否则只能逐个移动元素
+     * */
+    BVector &operator=(BVector &&other) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value ||
+            AllocTraits::is_always_equal::value) {
+        if (this == &other) return *this;
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            destroy_();
+            alloc_() = std::move(other.alloc_());
+            steal_(other);
+        } else {
+            if (alloc_() == other.alloc_()) {
+                destroy_();
+                steal_(other);
+            } else {
+                assign_(std::make_move_iterator(other.begin()),
+                        std::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
         return *this;
     }
 
@@ -229,6 +480,54 @@ public:
     SizeType capacity() const {
         return SizeType(end_of_storage_ - start_);
     }
+
+    // 返回容器可容纳的最大元素数
+    SizeType max_size() const {
+        return AllocTraits::max_size(alloc_());
+    }
+
+    /*
+     * @brief 预留能够容纳至少 n 个元素的存储空间
+     * @param n 期望的最小容量
+     *
+     * n > capacity() 时恰好分配 n 个元素的空间，不受扩容策略的影响；
+     * 否则不做任何操作
+     * */
+    void reserve(SizeType n) {
+        if (n <= this->capacity()) return;
+        if (n > this->max_size()) {
+            throw std::length_error("BVector::reserve");
+        }
+        reallocate_(n);
+    }
+
+    // 释放未使用的容量，使 capacity() == size()
+    void shrink_to_fit() {
+        if (finish_ == end_of_storage_) return;
+        if (this->empty()) {
+            AllocTraits::deallocate(alloc_(), start_, this->capacity());
+            start_ = finish_ = end_of_storage_ = nullptr;
+            return;
+        }
+        reallocate_(this->size());
+    }
+
+    /*
+     * @brief 返回当前容器对象自身的重新分配统计
+     *
+     * 包括 reserve、shrink_to_fit 和自动扩容在内，每分配一次新数组
+     * reallocations 加一，bytes_copied 累加搬迁的旧元素的字节数。
+     * 统计信息不随移动、交换等操作转移
+     *
+     * 只有扩容策略开启了统计（如 BVectorStatsGrowth）时才能调用
+     * */
+    CapacityStats capacity_stats() const {
+        static_assert(kRecordStats, "BVector::capacity_stats requires a growth policy with kRecordStats");
+        return this->stats_;
+    }
+
+    // 返回容器所使用的分配器
+    AllocatorType get_allocator() const { return alloc_(); }
 // @}  // 与容量相关的操作
 
 
@@ -310,6 +609,19 @@ public:
      * */
     void insert(SizeType idx, SizeType cnt, const Tp &val);
 
+    /*
+     * @brief 将迭代器范围 [first, last) 内的元素插入到指定位置
+     * @param idx   插入元素的起始索引，[0, size()]
+     * @param first 迭代器，指向待插入的第一个元素
+     * @param last  迭代器，指向待插入的最后一个元素的下一个位置
+     *
+     * 无论插入多少个元素，[idx, size()) 内的元素都只移动一次。
+     * InputIter 为整数类型时该重载不参与决议，以免与 insert(idx, cnt, val) 混淆
+     * */
+    template<typename InputIter,
+            typename = std::enable_if_t<!std::is_integral_v<InputIter>>>
+    void insert(SizeType idx, InputIter first, InputIter last);
+
     /*
      * @brief 插入单个元素到指定位置
      * @param idx 插入元素的起始索引，[0, size()]
@@ -322,11 +634,17 @@ public:
     /*
      * @brief 插入单个元素到指定位置
      * @param idx 插入元素的起始索引，[0, size()]
-     * @param val 插入元素的值
+     * @param val 插入元素的值，新元素由 val 移动构造
      * */
-    void insert(SizeType idx, Tp &&val) {
-        this->insert(idx, val);
-    }
+    void insert(SizeType idx, Tp &&val);
+
+    /*
+     * @brief 在指定位置原地构造新元素
+     * @param idx  新元素的索引，[0, size()]
+     * @param args 转发到元素构造函数的实参
+     * */
+    template<typename... Args>
+    void emplace(SizeType idx, Args &&... args);
 
     /*
      * @brief 添加新元素到容器尾
@@ -334,23 +652,23 @@ public:
      * */
     template<typename... Args>
     void emplace_back(Args &&... args) {
-        if (this->size() + 1 > this->capacity()) {
-            adjust_capacity_(this->size() + 1, this->capacity());
+        if (finish_ == end_of_storage_) {
+            realloc_append_(std::forward<Args>(args)...);
+            return;
         }
 
-        // placement new 构造对象
-        new(finish_) Tp(std::forward<Args>(args)...);
+        AllocTraits::construct(alloc_(), finish_, std::forward<Args>(args)...);
         ++finish_;
     }
 
     // 在容器尾部追加 val
     void push_back(const Tp &val) {
-        this->insert(this->size(), 1, val);
+        this->emplace_back(val);
     }
 
-    // 在容器尾部追加 val
+    // 在容器尾部追加 val，新元素由 val 移动构造
     void push_back(Tp &&val) {
-        this->insert(this->size(), 1, val);
+        this->emplace_back(std::move(val));
     }
 // @}  // 向容器中添加元素的相关操作
 
@@ -392,11 +710,11 @@ public:
         if (beg >= end) return;
         end = std::min(end, this->size());
 
-        // [beg, end)内的元素调用析构函数
+        // [beg, end)内的元素一次性析构
         destruct_range_(start_ + beg, start_ + end);
 
-        // [end, size())上的所有元素左移 end - beg 个单位
-        move_left_(start_ + end, start_ + this->size(), end - beg);
+        // [end, size())上的所有元素整体左移 end - beg 个单位
+        move_left_(start_ + end, finish_, end - beg);
         finish_ -= (end - beg);
     }
 
@@ -421,95 +739,295 @@ public:
     Tp *end() { return finish_; }
     Tp *end() const { return finish_; }
 // @}  // 迭代器相关的操作
+
+
+// @{  // 修改容器的相关操作
+public:
+
+    // 将当前容器的内容与 other 交换，不在单独的元素上调用任何移动、复制或交换操作
+    void swap(BVector &other) noexcept {
+        std::swap(start_, other.start_);
+        std::swap(finish_, other.finish_);
+        std::swap(end_of_storage_, other.end_of_storage_);
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_(), other.alloc_());
+        }
+    }
+// @}  // 修改容器的相关操作
 };
 
 
 // 重载 == 运算赋
-template<typename Tp>
-bool operator==(const BVector<Tp> &x, const BVector<Tp> &y);
+template<typename Tp, typename Alloc, typename Growth>
+bool operator==(const BVector<Tp, Alloc, Growth> &x, const BVector<Tp, Alloc, Growth> &y);
 
 
 /* 类 BVector 中声明但没有实现的成员函数 */
-template<typename Tp>
-void BVector<Tp>::resize(BVector::SizeType cnt, const Tp &val) {
+template<typename Tp, typename Alloc, typename Growth>
+void BVector<Tp, Alloc, Growth>::resize(BVector::SizeType cnt, const Tp &val) {
     if (cnt == this->size()) return;
 
-    if (cnt > this->capacity()) {
-        adjust_capacity_(cnt, this->capacity());
-    }
-
     if (cnt < this->size()) {
         // 析构掉[cnt, size())内的所有对象
         destruct_range_(start_ + cnt, finish_);
-    } else {
-        for (SizeType i = this->size(); i < cnt; i++) {
-            new (start_ + i) Tp(val);
+        finish_ = start_ + cnt;
+        return;
+    }
+
+    if (cnt > this->capacity()) {
+        // val 可能是容器中的元素，扩容前先复制一份
+        if (&val >= start_ && &val < finish_) {
+            Tp copy(val);
+            reallocate_(grow_capacity_(cnt));
+            this->resize(cnt, copy);
+            return;
         }
+        reallocate_(grow_capacity_(cnt));
+    }
+
+    for (; finish_ != start_ + cnt; ++finish_) {
+        AllocTraits::construct(alloc_(), finish_, val);
     }
-    finish_ = start_ + cnt;
 }
 
-template<typename Tp>
-void BVector<Tp>::insert(
+template<typename Tp, typename Alloc, typename Growth>
+void BVector<Tp, Alloc, Growth>::insert(
         BVector::SizeType idx, BVector::SizeType cnt, const Tp &val) {
     if (idx > this->size()) {
         throw std::out_of_range("BVector::insert");
     }
 
-    SizeType len = this->size() + cnt;
-    if (len > this->capacity()) {
-        // 重新开辟空间
-        adjust_capacity_(len, this->capacity());
-    }
+    if (cnt == 0) return;
 
-    if (idx < this->size()) {
-        // [idx, idx + size())内所有元素后移_cnt个位置
-        move_right_(start_ + idx, start_ + idx + this->size(), cnt);
+    // val 可能是容器中的元素，扩容或移动元素之后就会失效，因此先复制一份
+    if (&val >= start_ && &val < finish_) {
+        Tp copy(val);
+        this->insert(idx, cnt, copy);
+        return;
     }
-    for (SizeType i = 0; i < cnt; i++) {
-        new (start_ + idx + i) Tp(val);
+
+    Tp *gap = open_gap_(idx, cnt);
+    SizeType i = 0;
+    try {
+        for (; i < cnt; i++) {
+            AllocTraits::construct(alloc_(), gap + i, val);
+        }
+    } catch (...) {
+        destruct_range_(gap, gap + i);
+        close_gap_(idx, cnt);
+        throw;
     }
 
     // 修改尾指针指向
     finish_ += cnt;
 }
 
-template<typename Tp>
+template<typename Tp, typename Alloc, typename Growth>
+void BVector<Tp, Alloc, Growth>::insert(BVector::SizeType idx, Tp &&val) {
+    if (idx > this->size()) {
+        throw std::out_of_range("BVector::insert");
+    }
+
+    // val 是容器中的元素时，由 emplace 先将其移动到临时对象中
+    if (idx == this->size() || (&val >= start_ && &val < finish_)) {
+        this->emplace(idx, std::move(val));
+        return;
+    }
+
+    Tp *gap = open_gap_(idx, 1);
+    try {
+        AllocTraits::construct(alloc_(), gap, std::move(val));
+    } catch (...) {
+        close_gap_(idx, 1);
+        throw;
+    }
+    ++finish_;
+}
+
+template<typename Tp, typename Alloc, typename Growth>
+template<typename InputIter, typename>
+void BVector<Tp, Alloc, Growth>::insert(
+        BVector::SizeType idx, InputIter first, InputIter last) {
+    if (idx > this->size()) {
+        throw std::out_of_range("BVector::insert");
+    }
+
+    // 范围来自容器自身时，移动元素会使其失效，因此先复制一份
+    if constexpr (std::is_convertible_v<InputIter, const Tp *>) {
+        const Tp *p = first;
+        if (p >= start_ && p < finish_) {
+            BVector copy(alloc_());
+            copy.insert(0, first, last);
+            this->insert(idx, std::make_move_iterator(copy.begin()),
+                         std::make_move_iterator(copy.end()));
+            return;
+        }
+    }
+
+    SizeType cnt = distance_(first, last);
+    if (cnt == 0) return;
+
+    Tp *gap = open_gap_(idx, cnt);
+    SizeType i = 0;
+    try {
+        for (; i < cnt; i++, ++first) {
+            AllocTraits::construct(alloc_(), gap + i, *first);
+        }
+    } catch (...) {
+        destruct_range_(gap, gap + i);
+        close_gap_(idx, cnt);
+        throw;
+    }
+    finish_ += cnt;
+}
+
+template<typename Tp, typename Alloc, typename Growth>
+template<typename... Args>
+void BVector<Tp, Alloc, Growth>::emplace(BVector::SizeType idx, Args &&... args) {
+    if (idx > this->size()) {
+        throw std::out_of_range("BVector::emplace");
+    }
+    if (idx == this->size()) {
+        this->emplace_back(std::forward<Args>(args)...);
+        return;
+    }
+
+    // 先构造出新元素，args 引用容器中的元素时，移动元素不会影响到它
+    Tp tmp(std::forward<Args>(args)...);
+    Tp *gap = open_gap_(idx, 1);
+    try {
+        AllocTraits::construct(alloc_(), gap, std::move(tmp));
+    } catch (...) {
+        close_gap_(idx, 1);
+        throw;
+    }
+    ++finish_;
+}
+
+template<typename Tp, typename Alloc, typename Growth>
+Tp *BVector<Tp, Alloc, Growth>::open_gap_(BVector::SizeType idx, BVector::SizeType cnt) {
+    SizeType len = this->size();
+    if (len + cnt <= this->capacity()) {
+        // [idx, size())内所有元素后移cnt个位置
+        move_right_(start_ + idx, finish_, cnt);
+        return start_ + idx;
+    }
+
+    // 容量不足，新数组中 [idx, idx + cnt) 留空，其余元素搬迁到两侧
+    SizeType new_capacity = grow_capacity_(len + cnt);
+    Tp *tmp = AllocTraits::allocate(alloc_(), new_capacity);
+    try {
+        if constexpr (b_is_trivially_relocatable_v<Tp>) {
+            relocate_(tmp, start_, idx);
+            relocate_(tmp + idx + cnt, start_ + idx, len - idx);
+        } else {
+            // 两段都构造成功之后才析构原数组：拷贝路径中任何一步失败时原数组都保持不变
+            move_construct_(tmp, start_, idx);
+            try {
+                move_construct_(tmp + idx + cnt, start_ + idx, len - idx);
+            } catch (...) {
+                destruct_range_(tmp, tmp + idx);
+                throw;
+            }
+            destruct_range_(start_, finish_);
+        }
+    } catch (...) {
+        AllocTraits::deallocate(alloc_(), tmp, new_capacity);
+        throw;
+    }
+
+    record_realloc_(len);
+    if (start_ != nullptr) {
+        AllocTraits::deallocate(alloc_(), start_, this->capacity());
+    }
+    start_ = tmp;
+    finish_ = start_ + len;
+    end_of_storage_ = start_ + new_capacity;
+    return start_ + idx;
+}
+
+template<typename Tp, typename Alloc, typename Growth>
 template<typename InputIter>
-void BVector<Tp>::assign_(InputIter beg, InputIter end) {
+void BVector<Tp, Alloc, Growth>::assign_(InputIter beg, InputIter end) {
     SizeType len = end - beg;
     if (len > this->capacity()) {
-        adjust_capacity_(len, this->capacity());
+        // 旧元素都会被覆盖，无需搬迁到新数组中
+        clear();
+        reallocate_(len);
     } else if (this->size() > len) {
         // 将多余的元素析构掉
         destruct_range_(start_ + len, finish_);
+        finish_ = start_ + len;
     }
 
-    // 复制内容
-    copy_(start_, beg, len);
-    finish_ = start_ + len;
+    // 复制内容，InputIter 可能是移动迭代器，因此逐个赋值
+    SizeType i = 0;
+    for (; i < this->size(); i++, ++beg) {
+        start_[i] = *beg;
+    }
+    // [size(), len) 是未初始化的内存，需要构造
+    for (; i < len; i++, ++beg, ++finish_) {
+        AllocTraits::construct(alloc_(), finish_, *beg);
+    }
 }
 
 
-template<typename Tp>
-void BVector<Tp>::adjust_capacity_(
-        BVector::SizeType new_capacity, BVector::SizeType old_capacity) {
-    if (new_capacity < 2 * old_capacity) {
-        new_capacity = 2 * old_capacity;
-    }
+template<typename Tp, typename Alloc, typename Growth>
+void BVector<Tp, Alloc, Growth>::reallocate_(BVector::SizeType new_capacity) {
+    if (new_capacity == 0) return;
     SizeType len = this->size();
 
-    auto tmp = new Tp[new_capacity]{};
-    move_copy_(tmp, start_, len);
-    destroy_();  // 释放原来的内存
+    // 新数组只分配内存，不构造任何对象
+    Tp *tmp = AllocTraits::allocate(alloc_(), new_capacity);
+    try {
+        relocate_(tmp, start_, len);
+    } catch (...) {
+        AllocTraits::deallocate(alloc_(), tmp, new_capacity);
+        throw;
+    }
 
+    // 旧数组中的元素已经搬迁走，只需归还内存
+    record_realloc_(len);
+    if (start_ != nullptr) {
+        AllocTraits::deallocate(alloc_(), start_, this->capacity());
+    }
     start_ = tmp;
     finish_ = start_ + len;
     end_of_storage_ = start_ + new_capacity;
 }
 
-template<typename Tp>
-bool operator==(const BVector<Tp> &x, const BVector<Tp> &y) {
+template<typename Tp, typename Alloc, typename Growth>
+template<typename... Args>
+void BVector<Tp, Alloc, Growth>::realloc_append_(Args &&... args) {
+    SizeType len = this->size();
+    SizeType new_capacity = grow_capacity_(len + 1);
+
+    Tp *tmp = AllocTraits::allocate(alloc_(), new_capacity);
+    try {
+        AllocTraits::construct(alloc_(), tmp + len, std::forward<Args>(args)...);
+    } catch (...) {
+        AllocTraits::deallocate(alloc_(), tmp, new_capacity);
+        throw;
+    }
+    try {
+        relocate_(tmp, start_, len);
+    } catch (...) {
+        AllocTraits::destroy(alloc_(), tmp + len);
+        AllocTraits::deallocate(alloc_(), tmp, new_capacity);
+        throw;
+    }
+
+    record_realloc_(len);
+    if (start_ != nullptr) {
+        AllocTraits::deallocate(alloc_(), start_, this->capacity());
+    }
+    start_ = tmp;
+    finish_ = start_ + len + 1;
+    end_of_storage_ = start_ + new_capacity;
+}
+
+template<typename Tp, typename Alloc, typename Growth>
+bool operator==(const BVector<Tp, Alloc, Growth> &x, const BVector<Tp, Alloc, Growth> &y) {
     if (x.size() != y.size()) return false;
 
     auto beg1 = x.begin();
@@ -0,0 +1,320 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 每个不同的`键`只占一个节点的红黑树，重复`键`的元素存放在节点的桶中
+//
+
+#include "rb_tree.h"
+#include "baby_vector.h"
+
+#ifndef CPPBABYSTL_RB_BUCKET_TREE_H
+#define CPPBABYSTL_RB_BUCKET_TREE_H
+
+/*
+ * @brief 桶式红黑树，BBucketMultiMap / BBucketMultiSet 的底层实现
+ *
+ * @tparam K `键`的类型
+ * @tparam V `值`的类型，为 void 时是集合，此时桶中存放的是`键`本身
+ * @tparam Compare 可调用对象，用于 K 类型之间的比较
+ * @tparam Alloc 分配器，会被 rebind 到树节点和桶中的元素类型
+ *
+ * 红黑树中每个节点的`键`互不相同，`键`等价的所有元素按插入顺序存放在该
+ * 节点的桶（BVector）中。查找、计数和删除整个`键`只需向下查找一次，与
+ * 重复元素的数目无关；重复元素之间也不再需要父节点和左右孩子指针
+ *
+ * 迭代器由节点和桶中的下标组成，按`键`的升序、同一`键`内按插入顺序遍历。
+ * 向桶中插入元素可能使桶重新分配，因此会使同一`键`的其他迭代器失效
+ * */
+template<typename K, typename V,
+         typename Compare = std::less<K>,
+         typename Alloc = std::allocator<K>>
+class RBBucketTree {
+public:
+    using SizeType = std::size_t;
+    using ElemType = std::conditional_t<std::is_void_v<V>, K, V>;
+    using BucketType = BVector<ElemType, typename std::allocator_traits<Alloc>::template rebind_alloc<ElemType>>;
+    using NodeType = RBTreeMapNode<K, BucketType>;
+    using TreeType = RBTree<K, BucketType, NodeType, Compare, Alloc>;
+    using TreeIterator = typename TreeType::Iterator;
+    using ReturnType = std::conditional_t<std::is_void_v<V>,
+            const K &, std::pair<const K &, ElemType &>>;
+    struct Iterator;
+
+private:
+    TreeType tree_;     // 每个不同的`键`对应一个节点
+    SizeType cnt_{};    // 所有桶中的元素总数
+
+    // 节点 node 中的`键`和桶
+    static const K &key_of_(const TreeIterator &node) {
+        return static_cast<NodeType *>(node.node)->key;
+    }
+
+    static BucketType &bucket_of_(const TreeIterator &node) {
+        return static_cast<NodeType *>(node.node)->val;
+    }
+
+    // 使用容器的分配器（rebind 到 ElemType）创建一个空桶
+    BucketType make_bucket_() const {
+        return BucketType(typename BucketType::AllocatorType(tree_.get_allocator()));
+    }
+
+    // 两个`键`是否等价
+    template<typename KeyArg>
+    bool equal_(const K &a, const KeyArg &b) const {
+        Compare cmp = tree_.key_comp();
+        return !cmp(a, b) && !cmp(b, a);
+    }
+
+    // 在 node 的桶中下标为 idx 的位置构造新元素
+    template<typename ...Args>
+    Iterator emplace_into_(TreeIterator node, SizeType idx, Args &&...args) {
+        BucketType &bucket = bucket_of_(node);
+        try {
+            bucket.emplace(idx, std::forward<Args>(args)...);
+        } catch (...) {
+            // 新建的节点不能以空桶的形式留在树中
+            if (bucket.empty()) tree_.erase(node);
+            throw;
+        }
+        cnt_++;
+        return Iterator(node, idx);
+    }
+
+public:
+    RBBucketTree() = default;
+
+    explicit RBBucketTree(const Alloc &alloc) : tree_(alloc) {}
+
+    // 拷贝构造函数：节点已经有序，整棵树按 O(n) 建立，每个桶整体拷贝
+    RBBucketTree(const RBBucketTree &other)
+            : tree_(std::allocator_traits<Alloc>::select_on_container_copy_construction(
+                    other.tree_.get_allocator())),
+              cnt_(other.cnt_) {
+        tree_.assign_sorted(other.tree_.begin(), other.tree_.size());
+    }
+
+    RBBucketTree(RBBucketTree &&other) noexcept
+            : tree_(std::move(other.tree_)),
+              cnt_(std::exchange(other.cnt_, 0)) {}
+
+    RBBucketTree &operator=(const RBBucketTree &other) {
+        if (this == &other) return *this;
+
+        tree_.assign_sorted(other.tree_.begin(), other.tree_.size());
+        cnt_ = other.cnt_;
+        return *this;
+    }
+
+    RBBucketTree &operator=(RBBucketTree &&other) noexcept {
+        if (this == &other) return *this;
+
+        tree_ = std::move(other.tree_);
+        cnt_ = std::exchange(other.cnt_, 0);
+        return *this;
+    }
+
+    ~RBBucketTree() = default;
+
+    Alloc get_allocator() const { return tree_.get_allocator(); }
+
+    Compare key_comp() const { return tree_.key_comp(); }
+
+    // 所有桶中的元素总数
+    SizeType size() const { return cnt_; }
+
+    // 不同`键`的数目，即树中的节点数目
+    SizeType key_count() const { return tree_.size(); }
+
+    void swap(RBBucketTree &other) noexcept {
+        tree_.swap(other.tree_);
+        std::swap(cnt_, other.cnt_);
+    }
+
+
+// @{  // 插入元素相关的操作
+public:
+
+    // 把 args 构造的元素追加到`键`为 key 的桶的末尾，`键`不存在时先建立节点
+    template<typename ...Args>
+    Iterator insert(const K &key, Args &&...args) {
+        TreeIterator node = tree_.get_or_insert(key, make_bucket_());
+        return emplace_into_(node, bucket_of_(node).size(), std::forward<Args>(args)...);
+    }
+
+    /*
+     * @brief 以 hint 为提示插入，新元素尽可能放在 hint 之前
+     *
+     * hint 指向`键`等价的元素时直接插入到同一个桶中的 hint 之前；hint 是某个
+     * 节点的首个元素且前一个节点的`键`与 key 等价时追加到前一个桶的末尾；
+     * key 恰好位于前后两个节点之间时以 O(1) 的均摊代价建立新节点。
+     * 例如按`键`的非递减顺序插入时 hint 为 end()，每次插入都是 O(1) 的
+     * */
+    template<typename ...Args>
+    Iterator insert_hint(Iterator hint, const K &key, Args &&...args) {
+        Compare cmp = tree_.key_comp();
+        TreeIterator next = hint.node;
+        if (next != tree_.end() && equal_(key_of_(next), key)) {
+            return emplace_into_(next, hint.idx, std::forward<Args>(args)...);
+        }
+
+        if (hint.idx == 0) {
+            TreeIterator prev = next;
+            bool has_prev = next != tree_.begin();
+            if (has_prev) --prev;
+            if (has_prev && equal_(key_of_(prev), key)) {
+                return emplace_into_(prev, bucket_of_(prev).size(), std::forward<Args>(args)...);
+            }
+            if ((next == tree_.end() || cmp(key, key_of_(next))) && (!has_prev || cmp(key_of_(prev), key))) {
+                TreeIterator node = tree_.insert_hint(next, false, key, make_bucket_());
+                return emplace_into_(node, 0, std::forward<Args>(args)...);
+            }
+        }
+
+        // 提示不正确
+        return this->insert(key, std::forward<Args>(args)...);
+    }
+// @}  // 插入元素相关的操作
+
+
+// @{  // 删除元素相关的操作
+public:
+
+    // 删除`键`为 key 的整个节点，返回删除的元素数目，时间复杂度为 O(log n) 加上析构桶中元素的代价
+    template<typename KeyArg>
+    SizeType erase(const KeyArg &key) {
+        TreeIterator node = tree_.find(key);
+        if (node == tree_.end()) return 0;
+
+        SizeType n = bucket_of_(node).size();
+        tree_.erase(node);
+        cnt_ -= n;
+        return n;
+    }
+
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器。桶中位于 pos 之后的元素会前移
+    Iterator erase(Iterator pos) {
+        BucketType &bucket = bucket_of_(pos.node);
+        bucket.erase(pos.idx);
+        cnt_--;
+        if (bucket.empty()) return Iterator(tree_.erase(pos.node), 0);
+        if (pos.idx == bucket.size()) return Iterator(++pos.node, 0);
+        return pos;
+    }
+
+    void clear() {
+        tree_.clear();
+        cnt_ = 0;
+    }
+// @}  // 删除元素相关的操作
+
+
+// @{  // 迭代器和查找相关的操作
+public:
+
+    Iterator begin() const { return Iterator(tree_.begin(), 0); }
+
+    Iterator end() const { return Iterator(tree_.end(), 0); }
+
+    // `键`为 key 的元素数目，即对应桶的大小
+    template<typename KeyArg>
+    SizeType count(const KeyArg &key) const {
+        TreeIterator node = tree_.find(key);
+        return node == tree_.end() ? 0 : bucket_of_(node).size();
+    }
+
+    // 返回`键`为 key 的首个元素
+    template<typename KeyArg>
+    Iterator find(const KeyArg &key) const {
+        return Iterator(tree_.find(key), 0);
+    }
+
+    template<typename KeyArg>
+    Iterator lower_bound(const KeyArg &key) const {
+        return Iterator(tree_.lower_bound(key), 0);
+    }
+
+    // 树中的`键`互不相同，越过 lower_bound 所在的整个节点即可
+    template<typename KeyArg>
+    Iterator upper_bound(const KeyArg &key) const {
+        TreeIterator node = tree_.lower_bound(key);
+        if (node != tree_.end() && !tree_.key_comp()(key, key_of_(node))) ++node;
+        return Iterator(node, 0);
+    }
+
+    // [lower_bound(key), upper_bound(key))，只向下查找一次
+    template<typename KeyArg>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        TreeIterator node = tree_.lower_bound(key);
+        if (node == tree_.end() || tree_.key_comp()(key, key_of_(node))) {
+            return {Iterator(node, 0), Iterator(node, 0)};
+        }
+        TreeIterator next = node;
+        ++next;
+        return {Iterator(node, 0), Iterator(next, 0)};
+    }
+// @}  // 迭代器和查找相关的操作
+};
+
+
+// 桶式红黑树的迭代器：所在的节点以及元素在桶中的下标，end() 的下标为 0
+template<typename K, typename V, typename Compare, typename Alloc>
+struct RBBucketTree<K, V, Compare, Alloc>::Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<ReturnType>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ReturnType;
+
+    TreeIterator node;
+    SizeType idx;
+
+    Iterator(TreeIterator n, SizeType i) : node(n), idx(i) {}
+
+    ReturnType operator*() const {
+        auto tmp = static_cast<NodeType *>(node.node);
+        if constexpr (std::is_void_v<V>) {
+            return tmp->val[idx];
+        } else {
+            return {tmp->key, tmp->val[idx]};
+        }
+    }
+
+    Iterator &operator++() {
+        if (++idx == bucket_of_(node).size()) {
+            ++node;
+            idx = 0;
+        }
+        return *this;
+    }
+
+    Iterator operator++(int) {
+        Iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    Iterator &operator--() {
+        if (idx == 0) {
+            --node;
+            idx = bucket_of_(node).size();
+        }
+        --idx;
+        return *this;
+    }
+
+    Iterator operator--(int) {
+        Iterator tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+        return node.node == other.node.node && idx == other.idx;
+    }
+
+    bool operator!=(const Iterator &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif //CPPBABYSTL_RB_BUCKET_TREE_H
@@ -4,8 +4,15 @@
 
 #include <functional>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <iterator>
 #include <stdexcept>
+#include <exception>
 #include <iostream>
+#include "baby_type_traits.h"
+#include "baby_alloc_holder.h"
 
 #ifndef CPPBABYSTL_RB_TREE_H
 #define CPPBABYSTL_RB_TREE_H
@@ -23,18 +30,41 @@ enum RBTreeColor {
  * 最后一个节点；
  * 当红黑树为 nullptr 时，parent = nullptr，同时 left 和 right
  * 均指向该节点本身。
+ *
+ * 节点至少按指针的大小对齐，父节点指针的最低位总是 0，因此节点的颜色存放在
+ * 父节点指针的最低位中，每个节点比单独存放一个 RBTreeColor 少 8 个字节
+ * （对齐后的大小）。头节点的颜色位不使用
  * */
 struct NodeBase {
-    NodeBase *parent;
+private:
+    std::uintptr_t parent_color_;  // 父节点指针 | 颜色
+
+public:
     NodeBase *left, *right;
 
     NodeBase()
-            : parent(nullptr),
+            : parent_color_(0),
               left(this), right(this) {}
 
+    NodeBase *parent() const {
+        return reinterpret_cast<NodeBase *>(parent_color_ & ~std::uintptr_t(1));
+    }
+
+    void set_parent(NodeBase *p) {
+        parent_color_ = reinterpret_cast<std::uintptr_t>(p) | (parent_color_ & 1);
+    }
+
+    RBTreeColor color() const {
+        return static_cast<RBTreeColor>(parent_color_ & 1);
+    }
+
+    void set_color(RBTreeColor c) {
+        parent_color_ = (parent_color_ & ~std::uintptr_t(1)) | static_cast<std::uintptr_t>(c);
+    }
+
     inline NodeBase *get_parent(const NodeBase *header) {
-        if (this->parent == header) return nullptr;
-        return this->parent;
+        if (this->parent() == header) return nullptr;
+        return this->parent();
     }
 
     inline NodeBase *get_uncle(const NodeBase *header) {
@@ -45,7 +75,7 @@ struct NodeBase {
         if (grandpa == nullptr) return nullptr;
 
         if (grandpa->left == p) return grandpa->right;
-        return grandpa->right;
+        return grandpa->left;
     }
 
     inline NodeBase *get_sibling(const NodeBase *header) {
@@ -57,52 +87,165 @@ struct NodeBase {
     }
 };
 
+/*
+ * 红黑树的增强（augmentation）策略
+ *
+ * 节点中额外存放一份由整棵子树计算出的信息，红黑树在旋转、插入和删除后
+ * 重新计算受影响的节点。一个策略提供：
+ *   NodeData：混入节点中的数据成员
+ *   kEnabled：是否需要维护，为 false 时红黑树在编译期跳过所有更新
+ *   update(node)：在 node 的左右孩子已经正确时，由 node 自身的`键`、`值`
+ *                 和左右孩子中的数据重新计算 node 中的数据
+ *
+ * 含有 RBTreeAggregateAugment 的 map 节点中，聚合结果可能依赖`值`，因此迭代器
+ * 只能得到`值`的常量引用，BMap 的 operator[] 和 at 也无法编译；修改`值`需要使用
+ * RBTree::modify（BMap / BMultiMap 的 assign 和 modify），它会重新计算到根节点的路径
+ *
+ * RBTreeNoAugment 是默认的策略，不存放任何数据（空基类不占空间）
+ * */
+struct RBTreeNoAugment {
+    struct NodeData {};
+
+    static constexpr bool kEnabled = false;
+
+    template<typename Node>
+    static void update(Node *) {}
+};
+
+/*
+ * 子树大小增强（order-statistic tree）
+ *
+ * 每个节点记录以它为根的子树中的节点数目，节点多 8 个字节，插入和删除时
+ * 需要更新到根节点的整条路径。据此可以在 O(log n) 时间内求`键`的排名
+ * （rank）、按排名选取元素（select）以及统计区间内的元素数目（count_range）
+ * */
+struct RBTreeSizeAugment {
+    struct NodeData {
+        std::size_t subtree_size = 1;  // 以该节点为根的子树中的节点数目
+    };
+
+    static constexpr bool kEnabled = true;
+
+    template<typename Node>
+    static void update(Node *node) {
+        std::size_t n = 1;
+        if (node->left != nullptr) n += static_cast<Node *>(node->left)->subtree_size;
+        if (node->right != nullptr) n += static_cast<Node *>(node->right)->subtree_size;
+        node->subtree_size = n;
+    }
+};
+
+/*
+ * @brief 子树聚合增强：节点记录整棵子树上一个满足结合律的运算的结果
+ *
+ * @tparam Op 聚合运算，提供：
+ *   ValueType：聚合结果的类型
+ *   of(node)：单个节点的值
+ *   combine(a, b)：合并中序遍历中相邻的两段，a 在前 b 在后
+ *   identity()：空区间的结果，只有 aggregate_range / prefix_aggregate 需要
+ *
+ * 例如 RBTreeSumOp 维护子树中`值`的和，可以在 O(log n) 时间内求前缀和与区间和；
+ * BIntervalMap 用它维护子树中区间右端点的最大值
+ * */
+template<typename Op>
+struct RBTreeAggregateAugment {
+    struct NodeData {
+        using AggregateOp = Op;
+        typename Op::ValueType aggregate{};  // 以该节点为根的子树的聚合结果
+    };
+
+    static constexpr bool kEnabled = true;
+
+    template<typename Node>
+    static void update(Node *node) {
+        typename Op::ValueType agg = Op::of(*node);
+        if (node->left != nullptr) agg = Op::combine(static_cast<Node *>(node->left)->aggregate, agg);
+        if (node->right != nullptr) agg = Op::combine(agg, static_cast<Node *>(node->right)->aggregate);
+        node->aggregate = std::move(agg);
+    }
+};
+
+// 求和运算：map 对`值`求和，set 对`键`求和
+template<typename T>
+struct RBTreeSumOp {
+    using ValueType = T;
+
+    template<typename Node>
+    static ValueType of(const Node &node) {
+        if constexpr (Node::kHasValue) {
+            return node.val;
+        } else {
+            return node.key;
+        }
+    }
+
+    static ValueType combine(const ValueType &a, const ValueType &b) { return a + b; }
+
+    static ValueType identity() { return ValueType{}; }
+};
+
+/*
+ * 同时使用多个增强策略，例如 RBTreeAugments<RBTreeSizeAugment, RBTreeAggregateAugment<Op>>
+ * 既能求排名也能求区间和。各策略的 NodeData 中的成员不能重名，因此至多包含一个
+ * RBTreeAggregateAugment
+ * */
+template<typename ...Policies>
+struct RBTreeAugments {
+    struct NodeData : Policies::NodeData... {};
+
+    static constexpr bool kEnabled = (Policies::kEnabled || ...);
+
+    template<typename Node>
+    static void update(Node *node) {
+        (Policies::update(node), ...);
+    }
+};
+
+// 节点类型中的聚合运算，没有使用 RBTreeAggregateAugment 时为 void
+template<typename NodeType, typename = void>
+struct rb_tree_aggregate_op {
+    using type = void;
+};
+
+template<typename NodeType>
+struct rb_tree_aggregate_op<NodeType, std::void_t<typename NodeType::AggregateOp>> {
+    using type = typename NodeType::AggregateOp;
+};
+
+// 增强策略 Augment 是否包含聚合运算，此时 map 节点的`值`不能通过迭代器直接修改
+template<typename Augment>
+inline constexpr bool rb_tree_has_aggregate_v =
+        !std::is_void_v<typename rb_tree_aggregate_op<typename Augment::NodeData>::type>;
+
 /*
  * 红黑树节点，用于set
  *
  * 不同于NodeBase，默认插入的节点中其左右子树均为空，即
- * left = right = nullptr，同时节点颜色为`红`
+ * left = right = nullptr，同时节点颜色为`红`（颜色位为 0）
  * */
-template<typename Key>
-struct RBTreeSetNode : public NodeBase {
-    RBTreeColor color;  // 当前节点的颜色，仅有`红`或`黑`两种
+template<typename Key, typename Augment = RBTreeNoAugment>
+struct RBTreeSetNode : public NodeBase, public Augment::NodeData {
     Key key;            // 当前节点存储的`键`值
 
     using ReturnType = const Key &;
+    using AugmentType = Augment;
+    static constexpr bool kHasValue = false;  // 节点中只有`键`
 
-    RBTreeSetNode() : NodeBase(), color(RBTreeColor::kRed) {
+    RBTreeSetNode() : NodeBase() {
         this->left = this->right = nullptr;
     }
 
-    explicit RBTreeSetNode(const Key &k)
+    // set 的节点只存储`键`，忽略多余的实参
+    template<typename ...Args>
+    explicit RBTreeSetNode(const Key &k, Args &&...)
             : NodeBase(),
-              color(RBTreeColor::kRed),
               key(k) {
         this->left = this->right = nullptr;
     }
 
-    template<typename ...Args>
-    static RBTreeSetNode *create_node(const Key &k, Args &&... args) {
-        return new RBTreeSetNode(k);
-    }
-
-    static void destroy_node(RBTreeSetNode *node, NodeBase *header) {
-        auto p = node->get_parent(header);
-        if (p != nullptr) {
-            if (p->left == node) p->left = nullptr;
-            if (p->right == node) p->right = nullptr;
-        }
-        node->key.~Key();
-        delete node;
-    }
-
     template<typename ...Args>
     void replace_val(Args &&...args) {}
 
-    inline void swap(RBTreeSetNode *other) {
-        std::swap(this->key, other->key);
-    }
-
     ReturnType get_data() { return key; }
     ReturnType get_data() const { return key; }
 };
@@ -111,56 +254,38 @@ struct RBTreeSetNode : public NodeBase {
  * 红黑树节点，用于map
  *
  * 不同于NodeBase，默认插入的节点中其左右子树均为空，即
- * left = right = nullptr，同时节点颜色为`红`
+ * left = right = nullptr，同时节点颜色为`红`（颜色位为 0）
  * */
-template<typename Key, typename Value>
-struct RBTreeMapNode : public NodeBase {
-    RBTreeColor color;  // 当前节点的颜色，仅有`红`或`黑`两种
+template<typename Key, typename Value, typename Augment = RBTreeNoAugment>
+struct RBTreeMapNode : public NodeBase, public Augment::NodeData {
     Key key;            // 当前节点存储的`键`值
     Value val{};        // 当前节点存储的`值`
 
-    using ReturnType = std::pair<const Key &, Value &>;
+    using AugmentType = Augment;
+    static constexpr bool kHasValue = true;  // 节点中既有`键`也有`值`
+    // 聚合结果可能依赖`值`，此时`值`只能通过 RBTree::modify 修改
+    static constexpr bool kConstValue = rb_tree_has_aggregate_v<Augment>;
+    using ReturnType = std::pair<const Key &, std::conditional_t<kConstValue, const Value &, Value &>>;
 
-    RBTreeMapNode() : NodeBase(), color(RBTreeColor::kRed) {
+    RBTreeMapNode() : NodeBase() {
         this->left = this->right = nullptr;
     }
 
-    explicit RBTreeMapNode(const Key &k)
+    // args 被转发给`值`的构造函数，没有实参时`值`被值初始化
+    template<typename ...Args>
+    explicit RBTreeMapNode(const Key &k, Args &&... args)
             : NodeBase(),
-              color(RBTreeColor::kRed),
-              key(k) {
+              key(k),
+              val(std::forward<Args>(args)...) {
         this->left = this->right = nullptr;
     }
 
-    template<typename ...Args>
-    static RBTreeMapNode *create_node(const Key &k, Args &&... args) {
-        auto node = new RBTreeMapNode(k);
-        new(&node->val) Value(std::forward<Args>(args)...);
-        return node;
-    }
-
-    static void destroy_node(RBTreeMapNode *node, NodeBase *header) {
-        auto p = node->get_parent(header);
-        if (p != nullptr) {
-            if (p->left == node) p->left = nullptr;
-            if (p->right == node) p->right = nullptr;
-        }
-        node->key.~Key();
-        node->val.~Value();
-        delete node;
-    }
-
     template<typename ...Args>
     void replace_val(Args &&...args) {
         val.~Value();
         new (&val) Value(std::forward<Args>(args)...);
     }
 
-    inline void swap(RBTreeMapNode *other) {
-        std::swap(this->key, other->key);
-        std::swap(this->val, other->val);
-    }
-
     ReturnType get_data() { return {key, val}; }
     ReturnType get_data() const { return {key, val}; }
 };
@@ -170,47 +295,119 @@ struct RBTreeMapNode : public NodeBase {
  *
  * @tparam K `键`的类型
  * @tparam V 红黑树节点真实存储的数据类型
+ * @tparam NodeType 节点类型，其 AugmentType 为红黑树维护的增强策略
  * @tparam Compare 可调用对象，用于 K 类型之间的比较
+ * @tparam Alloc 分配器，红黑树会将其 rebind 到 NodeType 后用于分配节点
  * */
 template<typename K, typename V, typename NodeType,
-        typename Compare = std::less<K>>
-class RBTree {
+        typename Compare = std::less<K>,
+        typename Alloc = std::allocator<NodeType>>
+class RBTree : private BAllocHolder<typename std::allocator_traits<Alloc>::template rebind_alloc<NodeType>> {
 public:
     using SizeType = std::size_t;
     using ReturnType = typename NodeType::ReturnType;
+    using AllocatorType = Alloc;
+    using AugmentType = typename NodeType::AugmentType;
     struct Iterator;
 
+    // 节点是否记录了子树大小，只有此时才能使用 rank / select / count_range
+    static constexpr bool kCountsSize = std::is_base_of_v<RBTreeSizeAugment::NodeData, NodeType>;
+
+    // 节点中维护的聚合运算，只有不为 void 时才能使用 prefix_aggregate / aggregate_range
+    using AggregateOp = typename rb_tree_aggregate_op<NodeType>::type;
+
 private:
-    NodeBase header_;  // 红黑树root节点的头结点
-    SizeType cnt_{};   // 红黑树节点的数目（不包括header_）
-    Compare cmp_;      // 红黑树中用于比较节点内元素大小的函数
+    using NodeAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<NodeType>;
+    using NodeAllocTraits = std::allocator_traits<NodeAllocType>;
+    using AllocHolder = BAllocHolder<NodeAllocType>;
+    using AllocHolder::alloc_;   // 分配节点所用的分配器
+
+    NodeBase header_;       // 红黑树root节点的头结点
+    SizeType cnt_{};        // 红黑树节点的数目（不包括header_）
+    Compare cmp_;           // 红黑树中用于比较节点内元素大小的函数
+
+    // 创建一个新节点，args 被转发给节点中`值`的构造函数
+    template<typename ...Args>
+    NodeType *create_node_(const K &key, Args &&... args) {
+        NodeType *node = NodeAllocTraits::allocate(alloc_(), 1);
+        try {
+            NodeAllocTraits::construct(alloc_(), node, key, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeAllocTraits::deallocate(alloc_(), node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    // 以 src 为根的子树的节点逐个移动到新节点中（保持树的形状和颜色），返回新的根节点
+    NodeBase *move_subtree_(NodeBase *src, NodeBase *parent);
+
+    // 重新计算节点 node 中的增强数据，不使用增强策略时为空操作
+    void update_(NodeBase *node) {
+        if constexpr (AugmentType::kEnabled) {
+            AugmentType::update(static_cast<NodeType *>(node));
+        }
+    }
+
+    // 从 node 开始向上重新计算到根节点为止的整条路径
+    void update_path_(NodeBase *node) {
+        if constexpr (AugmentType::kEnabled) {
+            for (; node != &header_; node = node->parent()) update_(node);
+        }
+    }
+
+    // 以 node 为根的子树中的节点数目
+    static SizeType subtree_size_(const NodeBase *node) {
+        return node == nullptr ? 0 : static_cast<const NodeType *>(node)->subtree_size;
+    }
 
 public:
     RBTree() = default;
 
+    // 创建一个使用分配器 alloc 的空树
+    explicit RBTree(const Alloc &alloc) : AllocHolder(NodeAllocType(alloc)) {}
+
     // 移动构造函数
     RBTree(RBTree &&other) noexcept;
 
-    // 移动赋值函数
-    RBTree &operator=(RBTree &&other) noexcept;
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的所有节点；
+     * 否则只能将节点逐个移动到由当前分配器创建的新节点中
+     * */
+    RBTree &operator=(RBTree &&other) noexcept(
+            NodeAllocTraits::propagate_on_container_move_assignment::value ||
+            NodeAllocTraits::is_always_equal::value);
 
     ~RBTree() { this->clear(); }
 
+    // 返回红黑树所使用的分配器
+    Alloc get_allocator() const { return Alloc(alloc_()); }
+
+    // 交换两棵红黑树的内容，不在单独的节点上进行任何操作
+    void swap(RBTree &other) noexcept;
+
 
 // @{  // 在红黑树中插入元素相关的操作
 private:
 
     /*
      * @brief 向红黑树中插入一个新节点
-     * @param node 当前遍历到的红黑树节点
+     * @param node 红黑树的根节点
      * @param key 新插入节点的`键`
      * @param args 新插入节点的`值`
      * @param replace 是否替换掉已经存在的值
+     *
+     * 从根节点循环向下查找插入位置，同时记录父节点，栈的使用与树高无关
      * */
     template<typename ...Args>
     NodeType *insert_(NodeType *node, bool replace,
                       const K &key, Args &&... args);
 
+    // 把新节点 node 挂到 parent 的左（is_left 为 true）或右孩子上，并调整平衡
+    void attach_(NodeType *node, NodeBase *parent, bool is_left);
+
     // 左旋操作
     void rotate_left_(NodeBase *node);
 
@@ -220,6 +417,50 @@ private:
     // 插入节点node后进行的调整平衡的操作
     void rebalance_after_insert_(NodeType *node);
 
+    // 用容器的一个元素（map 为`键值对`，set 为`键`）创建新节点
+    template<typename Elem>
+    NodeType *create_node_from_(const Elem &elem) {
+        if constexpr (NodeType::kHasValue) {
+            const auto &[k, v] = elem;
+            return create_node_(k, v);
+        } else {
+            return create_node_(elem);
+        }
+    }
+
+    // 以 end() 为提示插入容器的一个元素
+    template<typename Elem>
+    void append_elem_(bool replace, const Elem &elem) {
+        if constexpr (NodeType::kHasValue) {
+            const auto &[k, v] = elem;
+            this->insert_hint(this->end(), replace, k, v);
+        } else {
+            this->insert_hint(this->end(), replace, elem);
+        }
+    }
+
+    // 元素 a 的`键`是否小于元素 b 的`键`
+    template<typename Elem>
+    bool elem_less_(const Elem &a, const Elem &b) {
+        if constexpr (NodeType::kHasValue) {
+            const auto &[ka, va] = a;
+            const auto &[kb, vb] = b;
+            return cmp_(ka, kb);
+        } else {
+            return cmp_(a, b);
+        }
+    }
+
+    /*
+     * @brief 按中序消耗 beg 开始的 n 个元素，建立一棵平衡的子树，返回子树的根节点
+     * @param depth 子树的根节点在整棵树中的深度
+     * @param red_depth 位于该深度的节点染`红`，其余节点染`黑`
+     *
+     * 左右子树的元素数目至多相差 1，因此除最深的一层外每一层都是满的
+     * */
+    template<typename InputIter>
+    NodeBase *build_sorted_(InputIter &beg, SizeType n, SizeType depth, SizeType red_depth);
+
 public:
 
     template<typename ...Args>
@@ -230,16 +471,75 @@ public:
         return this->insert(replace, key, std::forward<Args>(args)...);
     }
 
-    Iterator get_or_insert(const K &key) {
-        if (cnt_ == 0) return Iterator(&header_, &header_);
-
-        auto root = static_cast<NodeType*>(header_.parent);
-        auto node = find_(root, key);
-        if (node == nullptr) {
-            node = insert_(root, true, key);
+    // 查找`键`为 key 的节点，不存在时插入一个`值`由 args 构造（默认为值初始化）的节点，只向下查找一次
+    template<typename ...Args>
+    Iterator get_or_insert(const K &key, Args &&... args) {
+        if (cnt_ == 0) return this->insert(true, key, std::forward<Args>(args)...);
+
+        NodeBase *parent = &header_;
+        NodeBase *cur = header_.parent();
+        bool is_left = false;
+        while (cur != nullptr) {
+            auto node = static_cast<NodeType *>(cur);
+            parent = cur;
+            if (cmp_(key, node->key)) {
+                is_left = true;
+                cur = cur->left;
+            } else if (cmp_(node->key, key)) {
+                is_left = false;
+                cur = cur->right;
+            } else {
+                return Iterator(cur, &header_);
+            }
         }
+
+        NodeType *node = create_node_(key, std::forward<Args>(args)...);
+        attach_(node, parent, is_left);
         return Iterator(node, &header_);
     }
+
+    /*
+     * @brief 以 hint 为提示插入一个新节点，新节点尽可能放在 hint 之前
+     *
+     * 新节点的`键`恰好位于 hint 的前驱与 hint 之间时（例如按升序插入时 hint 为
+     * end()），直接挂到两者之一的空孩子上，不需要从根节点向下查找，均摊时间
+     * 复杂度为 O(1)；提示不正确时退化为普通的插入
+     * */
+    template<typename ...Args>
+    Iterator insert_hint(Iterator hint, bool replace, const K &key, Args &&... args);
+
+    /*
+     * @brief 用 beg 开始的 n 个元素重建整棵树，时间复杂度为 O(n)
+     *
+     * 元素必须已经按`键`升序排列，replace 为 true 的树（BMap / BSet）中还不能有
+     * 重复的`键`。每次以中间的元素作为子树的根，最深一层不满时染`红`，
+     * 其余节点全部染`黑`，不需要任何旋转
+     * */
+    template<typename InputIter>
+    void assign_sorted(InputIter beg, SizeType n);
+
+    /*
+     * @brief 插入 [beg, end) 中的所有元素
+     *
+     * 空树且区间可以多次遍历时，先检查区间是否有序，有序时直接用 assign_sorted 建树；
+     * 否则逐个以 end() 为提示插入，对于接在已有元素之后的有序区间仍然是 O(n) 的
+     * */
+    template<typename InputIter>
+    void insert_range(bool replace, InputIter beg, InputIter end);
+
+    /*
+     * @brief 对 pos 指向的节点中的`值`调用 func(val)，再重新计算到根节点的增强数据
+     *
+     * 聚合结果依赖`值`时只能通过这里修改`值`，时间复杂度为 O(log n)。
+     * func 不能修改`键`，也不能插入或删除节点
+     * */
+    template<typename Func>
+    void modify(Iterator pos, Func &&func) {
+        static_assert(NodeType::kHasValue, "RBTree::modify requires a map node");
+        auto node = static_cast<NodeType *>(pos.node);
+        std::forward<Func>(func)(node->val);
+        update_path_(node);
+    }
 // @}  // 在红黑树中插入元素相关的操作
 
 
@@ -255,24 +555,83 @@ private:
     // 删除一个黑色叶子节点 node 后，对红黑树的调整操作
     void rebalance_after_remove_(NodeType *node);
 
-    //在以 node 为根节点的树中删除`键`为 key 的节点
+    // 在以 node 为根节点的树中删除`键`为 key 的节点
     bool remove_(NodeType *node, const K &key);
 
+    // 交换 node 与其后继 successor 在树中的位置（连同颜色），两个节点中的`键`和`值`都不移动
+    void swap_with_successor_(NodeBase *node, NodeBase *successor);
+
+    // 删除节点 node，返回它的后继节点（没有后继时为头节点），其他节点都不受影响
+    NodeBase *erase_node_(NodeType *node);
+
+    /*
+     * @brief 按中序把以 node 为根的子树中 pred 为假的节点通过 right 指针接到 tail 之后，其余节点直接释放
+     * @param error pred 第一次抛出的异常，此后不再调用 pred，剩余的节点全部保留
+     *
+     * 递归深度为树高，调用之后整棵子树的结构被破坏，必须用 link_sorted_ 重新建树
+     * */
+    template<typename Pred>
+    void filter_subtree_(NodeBase *node, NodeBase *&tail, Pred &pred, std::exception_ptr &error);
+
+    // 与 build_sorted_ 相同，但不创建新节点，而是按顺序取出链表 head（通过 right 指针相连）中的节点
+    NodeBase *link_sorted_(NodeBase *&head, SizeType n, SizeType depth, SizeType red_depth);
+
+    // n 个节点的完全平衡树中染`红`的深度，见 assign_sorted
+    static SizeType red_depth_(SizeType n) {
+        // 最深一层的深度为 floor(log2(n))；n + 1 是 2 的幂时这一层是满的，所有节点都为`黑`
+        SizeType max_depth = 0;
+        while ((SizeType(2) << max_depth) <= n) max_depth++;
+        return (n & (n + 1)) == 0 ? max_depth + 1 : max_depth;
+    }
+
+    // 把 root 设为整棵树的根节点，并更新头节点中的最小、最大节点
+    void set_root_(NodeBase *root);
+
 public:
 
+    // 删除 pos 指向的元素，返回指向下一个元素的迭代器，其他迭代器都不会失效
+    Iterator erase(Iterator pos) {
+        return Iterator(erase_node_(static_cast<NodeType *>(pos.node)), &header_);
+    }
+
+    /*
+     * @brief 删除 [first, last) 中的元素，返回 last
+     *
+     * 沿迭代器逐个删除，不需要从根节点查找，每次删除的调整是均摊 O(1) 的；
+     * 区间为整棵树时直接 clear()
+     * */
+    Iterator erase(Iterator first, Iterator last) {
+        if (first == this->begin() && last == this->end()) {
+            this->clear();
+            return this->end();
+        }
+        while (first != last) first = this->erase(first);
+        return last;
+    }
+
+    /*
+     * @brief 删除所有满足 pred(*iter) 的元素，返回删除的元素数目
+     *
+     * 一次中序遍历中释放被删除的节点，剩下的节点（不移动其中的`键`和`值`）
+     * 重新链接成一棵完全平衡的树，时间复杂度为 O(n)，不需要任何旋转。
+     * pred 抛出异常时，已经删除的元素不会恢复，剩下的元素仍然组成一棵合法的树
+     * */
+    template<typename Pred>
+    SizeType erase_if(Pred pred);
+
     bool remove(K &&key) {
-        auto root = static_cast<NodeType *>(header_.parent);
+        auto root = static_cast<NodeType *>(header_.parent());
         return remove_(root, key);
     }
 
     bool remove(const K &key) {
-        auto root = static_cast<NodeType *>(header_.parent);
+        auto root = static_cast<NodeType *>(header_.parent());
         return remove_(root, key);
     }
 
     void clear() {
-        this->clear_(header_.parent);
-        header_.parent = nullptr;
+        this->clear_(header_.parent());
+        header_.set_parent(nullptr);
         header_.left = header_.right = &header_;
         cnt_ = 0;
     }
@@ -303,81 +662,318 @@ public:
 // @{  // 在红黑树中查找元素的相关操作
 private:
 
-    // 在红黑树中查找键为`key`的节点
-    NodeType *find_(NodeType *node, const K &key);
+    // 在以 node 为根的树中查找键为`key`的节点，不存在时返回 nullptr
+    template<typename KeyArg>
+    NodeType *find_(NodeType *node, const KeyArg &key);
 
     /*
-     * @brief 返回红黑树中序遍历序列中第一个 >= key 的节点。
+     * @brief 返回以 node 为根的树中序遍历序列中第一个 >= key 的节点。
      *
-     * @param node 当前节点的指针。
+     * @param node 根节点的指针。
      * @param key 要查找的键值。
-     * @param satisfy_node 遍历到 node 节点时，上一次满足条件的节点
      *
-     * @return 如果树中不存在键为`key`的节点，则返回第一个 > key 的节点。
+     * @return 如果树中不存在键为`key`的节点，则返回第一个 > key 的节点，不存在时返回 nullptr。
      *         如果树中只有一个键为`key`的节点，则返回指向该节点的指针。
      *         如果树中存在多个键为`key`的节点，则返回指向中序遍历序列中第一个键为`key`的节点的指针。
      */
-    NodeType *lower_bound_(NodeType *node, const K &key, NodeType *satisfy_node);
+    template<typename KeyArg>
+    NodeType *lower_bound_(NodeType *node, const KeyArg &key);
 
     /*
-     * @brief 返回红黑树中序遍历序列中第一个 > key 的节点。
+     * @brief 返回以 node 为根的树中序遍历序列中最后一个 <= key 的节点。
      *
-     * @param node 当前节点的指针。
+     * @param node 根节点的指针。
      * @param key 要查找的键值。
-     * @param satisfy_node 遍历到 node 节点时，上一次满足条件的节点
      *
-     * @return 如果树中不存在键为`key`的节点，则返回第一个 < key 的节点（注意注意注意）。
+     * @return 如果树中不存在键为`key`的节点，则返回最后一个 < key 的节点（注意注意注意），
+     *         不存在时返回 nullptr。
      *         如果树中只有一个键为`key`的节点，则返回指向该节点的指针。
      *         如果树中存在多个键为`key`的节点，则返回指向中序遍历序列中最后一个键为`key`的节点的指针。
      */
-    NodeType *upper_bound_(NodeType *node, const K &key, NodeType *satisfy_node);
+    template<typename KeyArg>
+    NodeType *upper_bound_(NodeType *node, const KeyArg &key);
 
-public:
-
-    Iterator find(const K &key) {
+    // 以下三个函数是 find / lower_bound / upper_bound 的公共实现，
+    // 键的类型 KeyArg 可以是 K，也可以是能与 K 直接比较的其他类型
+    template<typename KeyArg>
+    Iterator find_key_(const KeyArg &key) {
         if (cnt_ == 0) return Iterator(&header_, &header_);
 
-        auto root = static_cast<NodeType *>(header_.parent);
+        auto root = static_cast<NodeType *>(header_.parent());
         auto node = find_(root, key);
         return Iterator(node == nullptr ? &header_ : node, &header_);
     }
 
-    Iterator find(const K &key) const {
-        return const_cast<RBTree*>(this)->find(key);
+    template<typename KeyArg>
+    Iterator lower_bound_key_(const KeyArg &key) {
+        if (cnt_ == 0) return Iterator(&header_, &header_);
+
+        auto root = static_cast<NodeType *>(header_.parent());
+        auto node = lower_bound_(root, key);
+        return Iterator(node == nullptr ? &header_ : node, &header_);
     }
 
-    Iterator lower_bound(const K &key) {
+    template<typename KeyArg>
+    Iterator upper_bound_key_(const KeyArg &key) {
         if (cnt_ == 0) return Iterator(&header_, &header_);
 
-        auto root = static_cast<NodeType *>(header_.parent);
-        auto node = lower_bound_(root, key, nullptr);
-        return Iterator(node == nullptr ? &header_ : node, &header_);
+        auto root = static_cast<NodeType *>(header_.parent());
+        auto node = upper_bound_(root, key);
+        if (node == nullptr) return this->begin();
+
+        // upper_bound_ 返回最后一个 <= key 的节点，它的后继就是第一个 > key 的节点
+        Iterator ans = Iterator(node, &header_);
+        return ++ans;
+    }
+
+    // 只向下查找一次：找到第一个`键`等于 key 的节点后，分别在它的左右子树中找两个边界
+    template<typename KeyArg>
+    std::pair<Iterator, Iterator> equal_range_key_(const KeyArg &key) {
+        NodeBase *upper = &header_;  // 目前已知的第一个 > key 的节点
+        NodeBase *cur = header_.parent();
+        while (cur != nullptr) {
+            auto tmp = static_cast<NodeType *>(cur);
+            if (cmp_(key, tmp->key)) {
+                upper = cur;
+                cur = cur->left;
+            } else if (cmp_(tmp->key, key)) {
+                cur = cur->right;
+            } else {
+                NodeBase *lower = cur;
+                for (NodeBase *l = cur->left; l != nullptr;) {
+                    if (cmp_(static_cast<NodeType *>(l)->key, key)) {
+                        l = l->right;
+                    } else {
+                        lower = l;
+                        l = l->left;
+                    }
+                }
+                for (NodeBase *r = cur->right; r != nullptr;) {
+                    if (cmp_(key, static_cast<NodeType *>(r)->key)) {
+                        upper = r;
+                        r = r->left;
+                    } else {
+                        r = r->right;
+                    }
+                }
+                return {Iterator(lower, &header_), Iterator(upper, &header_)};
+            }
+        }
+        return {Iterator(upper, &header_), Iterator(upper, &header_)};
+    }
+
+public:
+
+    Iterator find(const K &key) {
+        return find_key_(key);
+    }
+
+    Iterator find(const K &key) const {
+        return const_cast<RBTree*>(this)->find_key_(key);
+    }
+
+    Iterator lower_bound(const K &key) {
+        return lower_bound_key_(key);
     }
 
     Iterator lower_bound(const K &key) const {
-        return const_cast<RBTree*>(this)->lower_bound(key);
+        return const_cast<RBTree*>(this)->lower_bound_key_(key);
     }
 
     Iterator upper_bound(const K &key) {
-        if (cnt_ == 0) return Iterator(&header_, &header_);
-
-        auto root = static_cast<NodeType *>(header_.parent);
-        auto node = upper_bound_(root, key, nullptr);
-        if (node == nullptr) {
-            return this->begin();
-        } else {
-            Iterator ans = Iterator(node, &header_);
-            if (node->key == key) return ans;
-            else return ++ans;
-        }
+        return upper_bound_key_(key);
     }
 
     Iterator upper_bound(const K &key) const {
-        return const_cast<RBTree*>(this)->upper_bound(key);
+        return const_cast<RBTree*>(this)->upper_bound_key_(key);
+    }
+
+    // 返回`键`等于 key 的所有元素构成的区间 [lower_bound(key), upper_bound(key))
+    std::pair<Iterator, Iterator> equal_range(const K &key) const {
+        return const_cast<RBTree*>(this)->equal_range_key_(key);
+    }
+
+    /*
+     * 异构查找：只有当比较器声明了 is_transparent（如 std::less<>）时才启用，
+     * 此时可以直接使用与 K 可比较的其他类型查找，而不必先构造一个 K。
+     * 例如 BMap<BString, V, std::less<>> 可以直接使用 BStringView 或
+     * c 风格字符串查找，查找过程中不会申请内存
+     * */
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) {
+        return find_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator find(const KeyArg &key) const {
+        return const_cast<RBTree*>(this)->find_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) {
+        return lower_bound_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator lower_bound(const KeyArg &key) const {
+        return const_cast<RBTree*>(this)->lower_bound_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) {
+        return upper_bound_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    Iterator upper_bound(const KeyArg &key) const {
+        return const_cast<RBTree*>(this)->upper_bound_key_(key);
+    }
+
+    template<typename KeyArg, typename = b_transparent_key_t<Compare, KeyArg>>
+    std::pair<Iterator, Iterator> equal_range(const KeyArg &key) const {
+        return const_cast<RBTree*>(this)->equal_range_key_(key);
     }
+
+    // 返回红黑树使用的比较器
+    Compare key_comp() const { return cmp_; }
 // @}  // 在红黑树中查找元素的相关操作
 
 
+// @{  // 顺序统计（需要 RBTreeSizeAugment）
+private:
+
+    // 统计`键` < key（or_equal 为 true 时为 <= key）的节点数目，向下查找一次
+    template<bool or_equal, typename KeyArg>
+    SizeType count_less_(const KeyArg &key);
+
+public:
+
+    /*
+     * @brief 返回`键`小于 key 的元素数目，即 lower_bound(key) 在中序遍历序列中的下标
+     *
+     * 时间复杂度为 O(log n)，下同
+     * */
+    template<typename KeyArg>
+    SizeType rank(const KeyArg &key) const {
+        static_assert(kCountsSize, "RBTree::rank requires RBTreeSizeAugment");
+        return const_cast<RBTree *>(this)->template count_less_<false>(key);
+    }
+
+    // 返回中序遍历序列中下标为 k 的元素（第 k + 1 小）的迭代器，k >= size() 时返回 end()
+    Iterator select(SizeType k) const;
+
+    // 返回`键`位于闭区间 [lo, hi] 中的元素数目，hi < lo 时返回 0
+    template<typename KeyArg>
+    SizeType count_range(const KeyArg &lo, const KeyArg &hi) const {
+        static_assert(kCountsSize, "RBTree::count_range requires RBTreeSizeAugment");
+        auto self = const_cast<RBTree *>(this);
+        if (self->cmp_(hi, lo)) return 0;
+        return self->template count_less_<true>(hi) - self->template count_less_<false>(lo);
+    }
+// @}  // 顺序统计（需要 RBTreeSizeAugment）
+
+
+// @{  // 子树聚合（需要 RBTreeAggregateAugment）
+public:
+
+    // 返回根节点，空树时返回 nullptr。容器可以借助节点中的增强数据实现带剪枝的查找
+    NodeType *root() const {
+        return static_cast<NodeType *>(header_.parent());
+    }
+
+    // 返回指向树中节点 node 的迭代器
+    Iterator iterator_to(NodeBase *node) const {
+        return Iterator(node, &header_);
+    }
+
+    /*
+     * @brief 返回`键`小于 key 的所有元素按中序合并的结果，例如 RBTreeSumOp 的前缀和
+     *
+     * 向下查找一次，每次走向右孩子时合并左子树和当前节点，时间复杂度为 O(log n)
+     * */
+    template<typename KeyArg>
+    auto prefix_aggregate(const KeyArg &key) const {
+        static_assert(!std::is_void_v<AggregateOp>, "RBTree::prefix_aggregate requires RBTreeAggregateAugment");
+        auto self = const_cast<RBTree *>(this);
+        typename AggregateOp::ValueType acc = AggregateOp::identity();
+        for (NodeBase *cur = header_.parent(); cur != nullptr;) {
+            auto tmp = static_cast<NodeType *>(cur);
+            if (self->cmp_(tmp->key, key)) {
+                if (cur->left != nullptr) {
+                    acc = AggregateOp::combine(acc, static_cast<NodeType *>(cur->left)->aggregate);
+                }
+                acc = AggregateOp::combine(acc, AggregateOp::of(*tmp));
+                cur = cur->right;
+            } else {
+                cur = cur->left;
+            }
+        }
+        return acc;
+    }
+
+    /*
+     * @brief 返回`键`位于闭区间 [lo, hi] 中的所有元素按中序合并的结果
+     *
+     * 先找到 lo 和 hi 的查找路径分叉的节点，再分别沿两条路径向下，合并完全位于
+     * 区间内的子树。不要求运算可逆（例如求最大值），时间复杂度为 O(log n)
+     * */
+    template<typename KeyArg>
+    auto aggregate_range(const KeyArg &lo, const KeyArg &hi) const {
+        static_assert(!std::is_void_v<AggregateOp>, "RBTree::aggregate_range requires RBTreeAggregateAugment");
+        using ValueType = typename AggregateOp::ValueType;
+        auto self = const_cast<RBTree *>(this);
+        auto agg = [](NodeBase *node) {
+            return static_cast<NodeType *>(node)->aggregate;
+        };
+
+        // 分叉节点：第一个`键`位于 [lo, hi] 中的节点
+        NodeBase *split = header_.parent();
+        while (split != nullptr) {
+            auto tmp = static_cast<NodeType *>(split);
+            if (self->cmp_(tmp->key, lo)) {
+                split = split->right;
+            } else if (self->cmp_(hi, tmp->key)) {
+                split = split->left;
+            } else {
+                break;
+            }
+        }
+        if (split == nullptr) return AggregateOp::identity();
+
+        // 左侧路径：`键` >= lo 的节点及其右子树都在区间内，越往下的节点越靠前
+        ValueType left_part = AggregateOp::identity();
+        for (NodeBase *cur = split->left; cur != nullptr;) {
+            auto tmp = static_cast<NodeType *>(cur);
+            if (!self->cmp_(tmp->key, lo)) {
+                ValueType part = AggregateOp::of(*tmp);
+                if (cur->right != nullptr) part = AggregateOp::combine(part, agg(cur->right));
+                left_part = AggregateOp::combine(part, left_part);
+                cur = cur->left;
+            } else {
+                cur = cur->right;
+            }
+        }
+
+        // 右侧路径：`键` <= hi 的节点及其左子树都在区间内，越往下的节点越靠后
+        ValueType right_part = AggregateOp::identity();
+        for (NodeBase *cur = split->right; cur != nullptr;) {
+            auto tmp = static_cast<NodeType *>(cur);
+            if (!self->cmp_(hi, tmp->key)) {
+                ValueType part = AggregateOp::of(*tmp);
+                if (cur->left != nullptr) part = AggregateOp::combine(agg(cur->left), part);
+                right_part = AggregateOp::combine(right_part, part);
+                cur = cur->right;
+            } else {
+                cur = cur->left;
+            }
+        }
+
+        ValueType mid = AggregateOp::of(*static_cast<NodeType *>(split));
+        return AggregateOp::combine(AggregateOp::combine(left_part, mid), right_part);
+    }
+// @}  // 子树聚合（需要 RBTreeAggregateAugment）
+
+
 public:
     SizeType size() const { return this->cnt_; }
 };
@@ -386,15 +982,40 @@ public:
 
 
 // ----------------------RBTree类中部分函数的实现------------------------------
-template<typename K, typename V, typename NodeType, typename Compare>
-RBTree<K, V, NodeType, Compare>& RBTree<K, V, NodeType, Compare>::operator=(RBTree &&other) noexcept {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+RBTree<K, V, NodeType, Compare, Alloc>& RBTree<K, V, NodeType, Compare, Alloc>::operator=(RBTree &&other) noexcept(
+        NodeAllocTraits::propagate_on_container_move_assignment::value ||
+        NodeAllocTraits::is_always_equal::value) {
     if (this == &other) return *this;
-    if (other.header_.parent == nullptr) return *this;
+    this->clear();
+    cmp_ = other.cmp_;
 
-    auto p = other.header_.parent;
-    p->parent = &header_;
-    header_.parent = p;
-    other.header_.parent = nullptr;
+    if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+        alloc_() = other.alloc_();
+    } else {
+        if (alloc_() != other.alloc_()) {
+            if (other.header_.parent() == nullptr) return *this;
+
+            // other 的节点只能由 other 的分配器释放，因此在当前分配器中重建整棵树
+            header_.set_parent(move_subtree_(other.header_.parent(), &header_));
+            NodeBase *tmp = header_.parent();
+            while (tmp->left != nullptr) tmp = tmp->left;
+            header_.left = tmp;
+            tmp = header_.parent();
+            while (tmp->right != nullptr) tmp = tmp->right;
+            header_.right = tmp;
+
+            cnt_ = other.cnt_;
+            other.clear();
+            return *this;
+        }
+    }
+    if (other.header_.parent() == nullptr) return *this;
+
+    auto p = other.header_.parent();
+    p->set_parent(&header_);
+    header_.set_parent(p);
+    other.header_.set_parent(nullptr);
 
     header_.left = other.header_.left;
     header_.right = other.header_.right;
@@ -406,14 +1027,15 @@ RBTree<K, V, NodeType, Compare>& RBTree<K, V, NodeType, Compare>::operator=(RBTr
     return *this;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-RBTree<K, V, NodeType, Compare>::RBTree(RBTree &&other) noexcept {
-    if (other.header_.parent == nullptr) return;
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+RBTree<K, V, NodeType, Compare, Alloc>::RBTree(RBTree &&other) noexcept
+        : AllocHolder(other.alloc_()), cmp_(other.cmp_) {
+    if (other.header_.parent() == nullptr) return;
 
-    auto p = other.header_.parent;
-    p->parent = &header_;
-    header_.parent = p;
-    other.header_.parent = nullptr;
+    auto p = other.header_.parent();
+    p->set_parent(&header_);
+    header_.set_parent(p);
+    other.header_.set_parent(nullptr);
 
     header_.left = other.header_.left;
     header_.right = other.header_.right;
@@ -423,14 +1045,54 @@ RBTree<K, V, NodeType, Compare>::RBTree(RBTree &&other) noexcept {
     std::swap(cnt_, other.cnt_);
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::rotate_left_(NodeBase *node) {
-    //     |                       |
-    //     N                       S
-    //    / \     l-rotate(N)     / \
-    //   L   S    ==========>    N   R
-    //      / \                 / \
-    //     M   R               L   M
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::swap(RBTree &other) noexcept {
+    NodeBase *root = header_.parent();
+    header_.set_parent(other.header_.parent());
+    other.header_.set_parent(root);
+    std::swap(header_.left, other.header_.left);
+    std::swap(header_.right, other.header_.right);
+
+    // 交换后需要修正 root 节点的父节点，空树的 left 和 right 指向头结点自身
+    auto fix_header = [](NodeBase &header) {
+        if (header.parent() == nullptr) {
+            header.left = header.right = &header;
+        } else {
+            header.parent()->set_parent(&header);
+        }
+    };
+    fix_header(header_);
+    fix_header(other.header_);
+
+    std::swap(cnt_, other.cnt_);
+    std::swap(cmp_, other.cmp_);
+    if constexpr (NodeAllocTraits::propagate_on_container_swap::value) {
+        std::swap(alloc_(), other.alloc_());
+    }
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+NodeBase *RBTree<K, V, NodeType, Compare, Alloc>::move_subtree_(NodeBase *src, NodeBase *parent) {
+    if (src == nullptr) return nullptr;
+
+    NodeType *node = NodeAllocTraits::allocate(alloc_(), 1);
+    NodeAllocTraits::construct(alloc_(), node, std::move(*static_cast<NodeType *>(src)));
+    node->set_parent(parent);
+    node->left = move_subtree_(src->left, node);
+    node->right = move_subtree_(src->right, node);
+    return node;
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::rotate_left_(NodeBase *node) {
+    /*
+     *     |                       |
+     *     N                       S
+     *    / \     l-rotate(N)     / \
+     *   L   S    ==========>    N   R
+     *      / \                 / \
+     *     M   R               L   M
+     * */
     if (node == nullptr || node->right == nullptr) {
         throw std::invalid_argument(
                 "RBTree::rotate_left_: argument `node` or `node->right` "
@@ -443,35 +1105,41 @@ void RBTree<K, V, NodeType, Compare>::rotate_left_(NodeBase *node) {
 
     // 修改 node 父节点的指向
     if (parent == nullptr) {
-        header_.parent = r_son;
-        r_son->parent = &header_;
+        header_.set_parent(r_son);
+        r_son->set_parent(&header_);
     } else {
         if (parent->left == node) {
             parent->left = r_son;
         } else {
             parent->right = r_son;
         }
-        r_son->parent = parent;
+        r_son->set_parent(parent);
     }
 
     // 修改 node 右子树的指向
     node->right = r_son->left;
     if (r_son->left != nullptr)
-        r_son->left->parent = node;
+        r_son->left->set_parent(node);
 
     // 修改 r_son 左子树的指向
     r_son->left = node;
-    node->parent = r_son;
+    node->set_parent(r_son);
+
+    // node 成为 r_son 的孩子，先更新 node 再更新 r_son
+    update_(node);
+    update_(r_son);
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::rotate_right_(NodeBase *node) {
-    //       |                   |
-    //       N                   S
-    //      / \   r-rotate(N)   / \
-    //     S   R  ==========>  L   N
-    //    / \                     / \
-    //   L   M                   M   R
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::rotate_right_(NodeBase *node) {
+    /*
+     *       |                   |
+     *       N                   S
+     *      / \   r-rotate(N)   / \
+     *     S   R  ==========>  L   N
+     *    / \                     / \
+     *   L   M                   M   R
+     * */
     if (node == nullptr || node->left == nullptr) {
         throw std::invalid_argument(
                 "RBTree::rotate_right_: argument `node` or `node->left`"
@@ -484,214 +1152,361 @@ void RBTree<K, V, NodeType, Compare>::rotate_right_(NodeBase *node) {
 
     // 修改 node 父节点的指向
     if (parent == nullptr) {
-        header_.parent = l_son;
-        l_son->parent = &header_;
+        header_.set_parent(l_son);
+        l_son->set_parent(&header_);
     } else {
         if (parent->left == node) {
             parent->left = l_son;
         } else {
             parent->right = l_son;
         }
-        l_son->parent = parent;
+        l_son->set_parent(parent);
     }
 
     // 修改 node 左子树的指向
     node->left = l_son->right;
     if (l_son->right != nullptr)
-        l_son->right->parent = node;
+        l_son->right->set_parent(node);
 
     // 修改 l_son 右子树的指向
     l_son->right = node;
-    node->parent = l_son;
-}
+    node->set_parent(l_son);
 
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::rebalance_after_insert_(NodeType *node) {
-    if (node == nullptr) return;
+    // node 成为 l_son 的孩子，先更新 node 再更新 l_son
+    update_(node);
+    update_(l_son);
+}
 
-    // case1: 插入的节点为根节点 ==> 将该节点染`黑`
-    if (header_.parent == node) {
-        node->color = RBTreeColor::kBlack;
-        return;
-    }
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::rebalance_after_insert_(NodeType *node) {
+    // case4 会把爷节点当作新插入的节点继续向上调整，因此使用循环而不是递归
+    while (node != nullptr) {
+        // case1: 插入的节点为根节点 ==> 将该节点染`黑`
+        if (header_.parent() == node) {
+            node->set_color(RBTreeColor::kBlack);
+            return;
+        }
 
-    auto parent = static_cast<NodeType *>(node->get_parent(&header_));
-    auto grandpa = static_cast<NodeType *>(parent->get_parent(&header_));
-    auto uncle = static_cast<NodeType *>(node->get_uncle(&header_));
-
-    // case2: 插入节点的父节点为黑 ==> 无需任何操作
-    if (parent->color == RBTreeColor::kBlack) return;
-
-    // case3: 父节点为红，且叔父节点为黑或为空 ==> 分LL, RR, LR, RL四种类型
-    //        这种情况下，爷节点必然存在（不为空），因为`根叶黑`保证了根节点不为`红`
-    if (uncle == nullptr || uncle->color == RBTreeColor::kBlack) {
-        parent->color = parent->color == kRed ? kBlack : kRed;    // 父节点变色
-        grandpa->color = grandpa->color == kRed ? kBlack : kRed;  // 爷节点变色
-        if (grandpa->left == parent && parent->left == node) {
-            // case3.1: LL型 ==> 父节点和爷节点变色，右旋爷节点
-            rotate_right_(grandpa);  // 右旋爷节点
-        } else if (grandpa->right == parent && parent->right == node) {
-            // case3.2: RR型 ==> 父节点和爷节点变色，左旋爷节点
-            rotate_left_(grandpa);  // 左旋爷节点
-        } else if (grandpa->left == parent && parent->right == node) {
-            // case3.3: LR型 ==> 父节点和爷节点变色，左旋父节点，右旋爷节点
-            rotate_left_(parent);    // 左旋父节点
-            rotate_right_(grandpa);  // 右旋爷节点
-        } else {
-            // case3.4: RL型 ==> 父节点和爷节点变色，右旋父节点，左旋爷节点
-            rotate_right_(parent);  // 右旋父节点
-            rotate_left_(grandpa);  // 左旋爷节点
+        auto parent = static_cast<NodeType *>(node->parent());
+
+        // case2: 插入节点的父节点为黑 ==> 无需任何操作
+        if (parent->color() == RBTreeColor::kBlack) return;
+
+        // 父节点为红，因此父节点不是根节点，爷节点必然存在
+        auto grandpa = static_cast<NodeType *>(parent->parent());
+        auto uncle = static_cast<NodeType *>(grandpa->left == parent ? grandpa->right : grandpa->left);
+
+        // case3: 父节点为红，且叔父节点为黑或为空 ==> 分LL, RR, LR, RL四种类型
+        //        这种情况下，爷节点必然存在（不为空），因为`根叶黑`保证了根节点不为`红`
+        if (uncle == nullptr || uncle->color() == RBTreeColor::kBlack) {
+            grandpa->set_color(grandpa->color() == kRed ? kBlack : kRed);  // 爷节点变色
+            if (grandpa->left == parent && parent->left == node) {
+                // case3.1: LL型 ==> 父节点和爷节点变色，右旋爷节点
+                parent->set_color(RBTreeColor::kBlack);
+                rotate_right_(grandpa);  // 右旋爷节点
+            } else if (grandpa->right == parent && parent->right == node) {
+                // case3.2: RR型 ==> 父节点和爷节点变色，左旋爷节点
+                parent->set_color(RBTreeColor::kBlack);
+                rotate_left_(grandpa);  // 左旋爷节点
+            } else if (grandpa->left == parent && parent->right == node) {
+                // case3.3: LR型 ==> 插入节点和爷节点变色，左旋父节点，右旋爷节点
+                // （旋转后插入节点成为子树的根，因此变黑的是插入节点而非父节点）
+                node->set_color(RBTreeColor::kBlack);
+                rotate_left_(parent);    // 左旋父节点
+                rotate_right_(grandpa);  // 右旋爷节点
+            } else {
+                // case3.4: RL型 ==> 插入节点和爷节点变色，右旋父节点，左旋爷节点
+                node->set_color(RBTreeColor::kBlack);
+                rotate_right_(parent);  // 右旋父节点
+                rotate_left_(grandpa);  // 左旋爷节点
+            }
+            return;
         }
-        return;
+
+        // case4: 父节点为红，叔父节点为红 ==> 叔、父、爷节点变色，爷节点变插入节点
+        uncle->set_color(uncle->color() == kRed ? kBlack : kRed);      // 叔节点变色
+        parent->set_color(parent->color() == kRed ? kBlack : kRed);    // 父节点变色
+        grandpa->set_color(grandpa->color() == kRed ? kBlack : kRed);  // 爷节点变色
+        node = grandpa;
     }
+}
 
-    // case4: 父节点为红，叔父节点为红 ==> 叔、父、爷节点变色，爷节点变插入节点
-    uncle->color = uncle->color == kRed ? kBlack : kRed;      // 叔节点变色
-    parent->color = parent->color == kRed ? kBlack : kRed;    // 父节点变色
-    grandpa->color = grandpa->color == kRed ? kBlack : kRed;  // 爷节点变色
-    rebalance_after_insert_(grandpa);
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::attach_(NodeType *node, NodeBase *parent, bool is_left) {
+    node->set_parent(parent);
+    if (is_left) {
+        parent->left = node;
+        // 挂在最左节点的左边，成为新的最左节点
+        if (header_.left == parent) header_.left = node;
+    } else {
+        parent->right = node;
+        if (header_.right == parent) header_.right = node;
+    }
+    // 先更新新节点到根节点的路径，调整平衡时的旋转只需要更新被旋转的两个节点
+    update_path_(node);
+    rebalance_after_insert_(node);
+    this->cnt_++;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
 template<typename ...Args>
-NodeType *RBTree<K, V, NodeType, Compare>::insert_(NodeType *node, bool replace,
+NodeType *RBTree<K, V, NodeType, Compare, Alloc>::insert_(NodeType *node, bool replace,
                                                    const K &key, Args &&... args) {
     if (node == nullptr) {
         throw std::invalid_argument(
                 "RBTree::insert_: argument `node` can not be `nullptr`!");
     }
 
-    if (node->key == key && replace) {
-        node->replace_val(std::forward<Args>(args)...);
-        return node;
-    }
-
-    if (cmp_(key, node->key)) {
-        // key < node->key ==> 插入到 node 的左子树中
-        if (node->left == nullptr) {
-            auto tmp = NodeType::create_node(
-                    key, std::forward<Args>(args)...);
-            node->left = tmp;
-            node->left->parent = node;
-            rebalance_after_insert_(tmp);
-            this->cnt_++;
-
-            // 可能需要修改header_中left或right的指向
-            if (header_.left == node)
-                header_.left = node->left;
-            return tmp;
+    NodeBase *parent;
+    bool is_left;
+    while (true) {
+        if (cmp_(key, node->key)) {
+            // key < node->key ==> 插入到 node 的左子树中
+            is_left = true;
+        } else if (replace && !cmp_(node->key, key)) {
+            // key == node->key，替换掉已经存在的值，增强数据可能依赖于`值`
+            node->replace_val(std::forward<Args>(args)...);
+            update_path_(node);
+            return node;
         } else {
-            return insert_(static_cast<NodeType *>(node->left),
-                           replace, key, std::forward<Args>(args)...);
+            // key >= node->key ==> 插入到 node 的右子树中
+            is_left = false;
         }
-    } else {
-        // key >= node->key ==> 插入到 node 的右子树中
-        if (node->right == nullptr) {
-            auto tmp = NodeType::create_node(
-                    key, std::forward<Args>(args)...);
-            node->right = tmp;
-            node->right->parent = node;
-            rebalance_after_insert_(tmp);
-            this->cnt_++;
-
-            // 可能需要修改header_中left或right的指向
-            if (header_.right == node)
-                header_.right = node->right;
-            return tmp;
-        } else {
-            return insert_(static_cast<NodeType *>(node->right),
-                           replace, key, std::forward<Args>(args)...);
+
+        NodeBase *next = is_left ? node->left : node->right;
+        if (next == nullptr) {
+            parent = node;
+            break;
         }
+        node = static_cast<NodeType *>(next);
     }
+
+    auto tmp = create_node_(key, std::forward<Args>(args)...);
+    attach_(tmp, parent, is_left);
+    return tmp;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
 template<typename... Args>
-typename RBTree<K, V, NodeType, Compare>::Iterator
-RBTree<K, V, NodeType, Compare>::insert(bool replace, const K &key, Args &&... args) {
+typename RBTree<K, V, NodeType, Compare, Alloc>::Iterator
+RBTree<K, V, NodeType, Compare, Alloc>::insert(bool replace, const K &key, Args &&... args) {
     NodeType *node;
-    if (header_.parent == nullptr) {
-        node = NodeType::create_node(
-                key, std::forward<Args>(args)...
-        );
-        node->parent = &header_;
-        node->color = RBTreeColor::kBlack;
+    if (header_.parent() == nullptr) {
+        node = create_node_(key, std::forward<Args>(args)...);
+        node->set_parent(&header_);
+        node->set_color(RBTreeColor::kBlack);
+        update_(node);
 
-        header_.parent = node;
+        header_.set_parent(node);
         header_.left = header_.right = node;
         this->cnt_++;
     } else {
-        auto root = static_cast<NodeType *>(header_.parent);
+        auto root = static_cast<NodeType *>(header_.parent());
         node = this->insert_(root, replace, key, std::forward<Args>(args)...);
     }
     return Iterator(node, &header_);
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::destroy_node_(NodeType *node) {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename... Args>
+typename RBTree<K, V, NodeType, Compare, Alloc>::Iterator
+RBTree<K, V, NodeType, Compare, Alloc>::insert_hint(Iterator hint, bool replace,
+                                                    const K &key, Args &&... args) {
+    if (header_.parent() == nullptr) {
+        return this->insert(replace, key, std::forward<Args>(args)...);
+    }
+
+    // 新节点必须位于 prev 与 next 之间：不允许重复时要求 prev < key < next，
+    // 允许重复时只要求 prev <= key <= next
+    auto after = [&](NodeBase *prev) {
+        const K &k = static_cast<NodeType *>(prev)->key;
+        return replace ? cmp_(k, key) : !cmp_(key, k);
+    };
+    auto before = [&](NodeBase *next) {
+        const K &k = static_cast<NodeType *>(next)->key;
+        return replace ? cmp_(key, k) : !cmp_(k, key);
+    };
+
+    NodeBase *next = hint.node;
+    NodeBase *parent = nullptr;
+    bool is_left = false;
+    if (next == &header_) {
+        // 提示为 end()：插入到最右节点的右孩子上
+        if (after(header_.right)) parent = header_.right;
+    } else if (before(next)) {
+        if (next == header_.left) {
+            parent = next;
+            is_left = true;
+        } else {
+            Iterator prev = hint;
+            --prev;
+            // prev 与 next 在中序遍历中相邻，prev 的右孩子和 next 的左孩子至少有一个为空
+            if (after(prev.node)) {
+                if (prev.node->right == nullptr) {
+                    parent = prev.node;
+                } else {
+                    parent = next;
+                    is_left = true;
+                }
+            }
+        }
+    }
+
+    // 提示不正确，从根节点开始查找插入位置
+    if (parent == nullptr) {
+        return this->insert(replace, key, std::forward<Args>(args)...);
+    }
+
+    NodeType *node = create_node_(key, std::forward<Args>(args)...);
+    attach_(node, parent, is_left);
+    return Iterator(node, &header_);
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename InputIter>
+NodeBase *RBTree<K, V, NodeType, Compare, Alloc>::build_sorted_(InputIter &beg, SizeType n,
+                                                                SizeType depth, SizeType red_depth) {
+    if (n == 0) return nullptr;
+
+    // 递归深度为 O(log n)。创建节点失败时释放已经建好的部分，树仍然为空
+    SizeType n_left = (n - 1) / 2;
+    NodeBase *left = build_sorted_(beg, n_left, depth + 1, red_depth);
+    NodeType *node;
+    try {
+        node = create_node_from_(*beg);
+    } catch (...) {
+        this->clear_(left);
+        throw;
+    }
+    ++beg;
+    this->cnt_++;
+
+    node->set_color(depth == red_depth ? RBTreeColor::kRed : RBTreeColor::kBlack);
+    node->left = left;
+    if (left != nullptr) left->set_parent(node);
+    try {
+        node->right = build_sorted_(beg, n - 1 - n_left, depth + 1, red_depth);
+    } catch (...) {
+        this->clear_(node);
+        throw;
+    }
+    if (node->right != nullptr) node->right->set_parent(node);
+    update_(node);
+    return node;
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename InputIter>
+void RBTree<K, V, NodeType, Compare, Alloc>::assign_sorted(InputIter beg, SizeType n) {
+    this->clear();
+    if (n == 0) return;
+
+    set_root_(build_sorted_(beg, n, 0, red_depth_(n)));
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename InputIter>
+void RBTree<K, V, NodeType, Compare, Alloc>::insert_range(bool replace, InputIter beg, InputIter end) {
+    if constexpr (b_is_forward_iterator_v<InputIter>) {
+        if (cnt_ == 0 && beg != end) {
+            // 不允许重复时要求严格递增，否则重复的`键`应当由后面的元素覆盖
+            SizeType n = 1;
+            bool sorted = true;
+            for (InputIter prev = beg, cur = std::next(beg); cur != end; prev = cur, ++cur, ++n) {
+                if (replace ? !elem_less_(*prev, *cur) : elem_less_(*cur, *prev)) {
+                    sorted = false;
+                    break;
+                }
+            }
+            if (sorted) {
+                this->assign_sorted(beg, n);
+                return;
+            }
+        }
+    }
+
+    for (; beg != end; ++beg) this->append_elem_(replace, *beg);
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::destroy_node_(NodeType *node) {
     if (node == nullptr) {
         throw std::invalid_argument(
                 "RBTree::destroy_node_: argument `node` can not be `nullptr`"
         );
     }
 
-    NodeType::destroy_node(node, &header_);
+    // 断开与父节点的连接
+    auto p = node->get_parent(&header_);
+    if (p != nullptr) {
+        if (p->left == node) p->left = nullptr;
+        if (p->right == node) p->right = nullptr;
+    }
+
+    NodeAllocTraits::destroy(alloc_(), node);
+    NodeAllocTraits::deallocate(alloc_(), node, 1);
     this->cnt_--;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::clear_(NodeBase *node) {
-    if (node == nullptr) return;
-
-    this->clear_(node->left);   // 删除左子树
-    this->clear_(node->right);  // 删除右子树
-    this->destroy_node_(static_cast<NodeType *>(node));
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::clear_(NodeBase *node) {
+    // 不断右旋把左子树转到右边，左孩子为空时释放当前节点并转到右孩子，
+    // 不需要栈，也不需要访问父节点
+    while (node != nullptr) {
+        NodeBase *l_son = node->left;
+        if (l_son != nullptr) {
+            node->left = l_son->right;
+            l_son->right = node;
+            node = l_son;
+        } else {
+            NodeBase *next = node->right;
+            auto tmp = static_cast<NodeType *>(node);
+            NodeAllocTraits::destroy(alloc_(), tmp);
+            NodeAllocTraits::deallocate(alloc_(), tmp, 1);
+            this->cnt_--;
+            node = next;
+        }
+    }
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-bool RBTree<K, V, NodeType, Compare>::remove_(NodeType *node, const K &key) {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+bool RBTree<K, V, NodeType, Compare, Alloc>::remove_(NodeType *node, const K &key) {
+    // 自顶向下寻找`键`为 key 的节点
+    node = find_(node, key);
     if (node == nullptr) return false;
 
-    if (key != node->key) {
-        if (cmp_(key, node->key)) {
-            // key < node->key
-            auto l_son = static_cast<NodeType *>(node->left);
-            return remove_(l_son, key);
-        } else {
-            // key > node->key
-            auto r_son = static_cast<NodeType *>(node->right);
-            return remove_(r_son, key);
-        }
-    }
+    erase_node_(node);
+    return true;
+}
 
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+NodeBase *RBTree<K, V, NodeType, Compare, Alloc>::erase_node_(NodeType *node) {
     if (this->cnt_ == 1) {
         this->clear();
-        return true;
-    }
-
-    // case 1: 节点 node 左右子树均不为空
-    //     step 1: 寻找 node 的直接后继 successor
-    //     step 2: 交换 node 和 successor 的内容（key 和 val）
-    //     step 3: 转换为删除 successor
-    //     |                    |
-    //     N                    S
-    //    / \                  / \
-    //   L  ..   swap(N, S)   L  ..
-    //       |   =========>       |
-    //       P                    P
-    //      / \                  / \
-    //     S  ..                N  ..
-    if (node->left != nullptr && node->right != nullptr) {
-        // step 1: 寻找 node 的直接后继 successor
-        NodeBase *tmp = node->right;
-        while (tmp->left != nullptr) tmp = tmp->left;
-        auto successor = static_cast<NodeType *>(tmp);
+        return &header_;
+    }
 
-        // step 2: 交换 node 和 successor 的内容（key 和 val）
-        successor->swap(node);
+    // 后继节点在删除过程中不会被释放，也不会改变内容
+    Iterator next_iter(node, &header_);
+    ++next_iter;
+    NodeBase *next = next_iter.node;
 
-        // step 3: 转换为删除 successor
-        node = successor;  // 直接跳转到后面两种情况即可
+    /*
+     * case 1: 节点 node 左右子树均不为空
+     *     step 1: node 的直接后继 successor 是右子树中最左侧的节点
+     *     step 2: 交换 node 和 successor 在树中的位置和颜色，`键`和`值`留在原来的节点中
+     *     step 3: node 至多有一个右孩子，转换为后面两种情况
+     *     |                    |
+     *     N                    S
+     *    / \                  / \
+     *   L  ..   swap(N, S)   L  ..
+     *       |   =========>       |
+     *       P                    P
+     *      / \                  / \
+     *     S  ..                N  ..
+     * */
+    if (node->left != nullptr && node->right != nullptr) {
+        swap_with_successor_(node, next);
     }
 
     // case 2: node 有一个非空的左子树或右子树。由于红黑树的性质约束，
@@ -705,30 +1520,32 @@ bool RBTree<K, V, NodeType, Compare>::remove_(NodeType *node, const K &key) {
 
         // step 1: 用非空的左子树或右子树代替掉 node 节点，子树变为黑
         if (parent == nullptr) {
-            header_.parent = sub_tree;
-            sub_tree->parent = &header_;
+            header_.set_parent(sub_tree);
+            sub_tree->set_parent(&header_);
         } else {
             if (parent->left == node) {
                 parent->left = sub_tree;
             } else {
                 parent->right = sub_tree;
             }
-            sub_tree->parent = parent;
+            sub_tree->set_parent(parent);
         }
-        sub_tree->color = RBTreeColor::kBlack;
+        sub_tree->set_color(RBTreeColor::kBlack);
 
         // step 2: 删除掉 node 节点
         if (header_.left == node) header_.left = sub_tree;
         if (header_.right == node) header_.right = sub_tree;
         this->destroy_node_(node);
 
-        return true;
+        // case 1 中与 node 交换位置的节点是 node 的祖先，同样位于这条路径上
+        if (parent != nullptr) update_path_(parent);
+        return next;
     }
 
     // case 3: node 节点为叶节点
     //     step 1: 删除 node 节点
     //     step 2: 如果 node 为黑节点，删除后需要调整红黑树
-    if (node->color == RBTreeColor::kBlack) {
+    if (node->color() == RBTreeColor::kBlack) {
         // step 2: 如果 node 为黑节点，删除后需要调整红黑树
         // 删除后的调整操作 rebalance_after_remove_ 不会影响到节点本身
         // 因此，可以将 step 2 放到 step 1 之前执行
@@ -736,201 +1553,398 @@ bool RBTree<K, V, NodeType, Compare>::remove_(NodeType *node, const K &key) {
     }
 
     // step 1: 删除 node 节点
-    NodeBase *parent = node->parent;
+    NodeBase *parent = node->parent();
     if (header_.left == node) header_.left = parent;
     if (header_.right == node) header_.right = parent;
     this->destroy_node_(node);
 
-    return true;
+    update_path_(parent);
+    return next;
 }
 
-// 删除节点 node 后，红黑树的调整策略
-// 注意：首次调用rebalance_after_remove_时，node 为黑色叶节点
-template<typename K, typename V, typename NodeType, typename Compare>
-void RBTree<K, V, NodeType, Compare>::rebalance_after_remove_(NodeType *node) {
-    if (header_.parent == node) return;
-
-    auto sibling = static_cast<NodeType *>(node->get_sibling(&header_));
-
-    // case 1: node 节点的兄弟节点为红色
-    //     step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
-    //     step 2: 父兄节点变色（父节点变红，兄节点变黑）
-    //     step 3: 更新兄弟节点，并继续调整
-    //      [P]                   <S>
-    //      / \    l-rotate(P)    / \
-    //    [N] <S>  ==========>  [P] [D]
-    //        / \               / \
-    //      [C] [D]           [N] [C]
-    if (sibling->color == RBTreeColor::kRed) {
-        auto parent = static_cast<NodeType *>(node->get_parent(&header_));
-        // step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
-        if (parent->left == node) rotate_left_(parent);
-        else rotate_right_(parent);
-
-        // step 2: 父兄节点变色（父节点变红，兄节点变黑）
-        parent->color = RBTreeColor::kRed;
-        sibling->color = RBTreeColor::kBlack;
-
-        // step 3: 更新兄弟节点，并继续调整
-        sibling = static_cast<NodeType *>(node->get_sibling(&header_));
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::swap_with_successor_(NodeBase *node, NodeBase *successor) {
+    NodeBase *parent = node->parent();
+    NodeBase *succ_right = successor->right;
+    RBTreeColor color = node->color();
+
+    // successor 接到 node 原来的父节点上
+    if (parent == &header_) {
+        header_.set_parent(successor);
+    } else if (parent->left == node) {
+        parent->left = successor;
+    } else {
+        parent->right = successor;
     }
 
-    auto parent = static_cast<NodeType *>(node->get_parent(&header_));
-    NodeType *close_nephew, *distant_nephew;
-    if (parent->left == node) {
-        close_nephew = static_cast<NodeType *>(sibling->left);
-        distant_nephew = static_cast<NodeType *>(sibling->right);
+    // node 的左子树交给 successor，successor 原本没有左孩子
+    successor->left = node->left;
+    successor->left->set_parent(successor);
+    node->left = nullptr;
+
+    if (node->right == successor) {
+        // successor 是 node 的右孩子：node 成为 successor 的右孩子
+        successor->right = node;
+        node->set_parent(successor);
     } else {
-        close_nephew = static_cast<NodeType *>(sibling->right);
-        distant_nephew = static_cast<NodeType *>(sibling->left);
+        // successor 是右子树中最左侧的节点：node 接到 successor 原来的父节点的左侧
+        NodeBase *succ_parent = successor->parent();
+        successor->right = node->right;
+        successor->right->set_parent(successor);
+        succ_parent->left = node;
+        node->set_parent(succ_parent);
     }
+    successor->set_parent(parent);
 
-    bool all_nephew_is_black = true;
-    if (close_nephew != nullptr && close_nephew->color == kRed) {
-        all_nephew_is_black = false;
-    }
-    if (distant_nephew != nullptr && distant_nephew->color == kRed) {
-        all_nephew_is_black = false;
-    }
+    node->right = succ_right;
+    if (succ_right != nullptr) succ_right->set_parent(node);
 
+    node->set_color(successor->color());
+    successor->set_color(color);
+}
 
-    if (all_nephew_is_black) {
-        if (parent->color == RBTreeColor::kRed) {
-            // case 2: 兄弟节点为黑，侄子节点全为黑，且父节点为红
-            //     将父节点和兄弟节点变色（父变黑，兄变红）
-            //      <P>             [P]
-            //      / \             / \
-            //    [N] [S]  ====>  [N] <S>
-            //        / \             / \
-            //      [C] [D]         [C] [D]
-            parent->color = RBTreeColor::kBlack;
-            sibling->color = RBTreeColor::kRed;
-            return;
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename Pred>
+void RBTree<K, V, NodeType, Compare, Alloc>::filter_subtree_(NodeBase *node, NodeBase *&tail,
+                                                             Pred &pred, std::exception_ptr &error) {
+    // 左子树递归，右子树循环，递归深度不超过树高
+    while (node != nullptr) {
+        NodeBase *right = node->right;
+        filter_subtree_(node->left, tail, pred, error);
+
+        auto tmp = static_cast<NodeType *>(node);
+        bool remove = false;
+        if (!error) {
+            try {
+                remove = pred(tmp->get_data());
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        if (remove) {
+            // 父节点可能已经被释放，不能使用 destroy_node_
+            NodeAllocTraits::destroy(alloc_(), tmp);
+            NodeAllocTraits::deallocate(alloc_(), tmp, 1);
+            this->cnt_--;
         } else {
-            // case 3: 兄弟节点、所有侄子节点和父节点全为黑
-            //     step 1: 将兄弟节点变红
-            //     step 2: 递归处理父节点
-            //      [P]             [P]
-            //      / \             / \
-            //    [N] [S]  ====>  [N] <S>
-            //        / \             / \
-            //      [C] [D]         [C] [D]
-            sibling->color = RBTreeColor::kRed;
-            rebalance_after_remove_(parent);
-            return;
+            tail->right = node;
+            tail = node;
         }
-    } else {
-        // case 4: 兄弟节点为黑色，离 node 最近的侄子节点是红色（LR型或RL型）
-        //     step 1: 如果兄弟节点是左孩子，左旋兄弟节点；否则，右旋兄弟节点
-        //     step 2: 交换最近的侄子节点和兄弟节点的颜色
-        //     step 3: 转到 case 5
-        //                            {P}
-        //      {P}                   / \
-        //      / \    r-rotate(S)  [N] <C>
-        //    [N] [S]  ==========>        \
-        //        / \                     [S]
-        //      <C> [D]                     \
-        //                                  [D]
-        if (close_nephew != nullptr && close_nephew->color == kRed) {
-            // step 1: 如果兄弟节点是左孩子，左旋兄弟节点；否则，右旋兄弟节点
-            if (parent->left == sibling) {
-                rotate_left_(sibling);
-            } else rotate_right_(sibling);
-
-            // step 2: 交换最近的侄子节点和兄弟节点的颜色
-            sibling->color = RBTreeColor::kRed;
-            close_nephew->color = RBTreeColor::kBlack;
-
-            // 更新 sibling, close_nephew 和 distant_nephew
+        node = right;
+    }
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+NodeBase *RBTree<K, V, NodeType, Compare, Alloc>::link_sorted_(NodeBase *&head, SizeType n,
+                                                               SizeType depth, SizeType red_depth) {
+    if (n == 0) return nullptr;
+
+    SizeType n_left = (n - 1) / 2;
+    NodeBase *left = link_sorted_(head, n_left, depth + 1, red_depth);
+    NodeBase *node = head;
+    head = head->right;
+
+    node->set_color(depth == red_depth ? RBTreeColor::kRed : RBTreeColor::kBlack);
+    node->left = left;
+    if (left != nullptr) left->set_parent(node);
+    node->right = link_sorted_(head, n - 1 - n_left, depth + 1, red_depth);
+    if (node->right != nullptr) node->right->set_parent(node);
+    update_(node);
+    return node;
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::set_root_(NodeBase *root) {
+    header_.set_parent(root);
+    if (root == nullptr) {
+        header_.left = header_.right = &header_;
+        return;
+    }
+    root->set_parent(&header_);
+
+    NodeBase *tmp = root;
+    while (tmp->left != nullptr) tmp = tmp->left;
+    header_.left = tmp;
+    tmp = root;
+    while (tmp->right != nullptr) tmp = tmp->right;
+    header_.right = tmp;
+}
+
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename Pred>
+typename RBTree<K, V, NodeType, Compare, Alloc>::SizeType
+RBTree<K, V, NodeType, Compare, Alloc>::erase_if(Pred pred) {
+    const SizeType old_cnt = cnt_;
+    NodeBase head;
+    NodeBase *tail = &head;
+    std::exception_ptr error;
+    filter_subtree_(header_.parent(), tail, pred, error);
+    tail->right = nullptr;
+
+    NodeBase *list = head.right;
+    set_root_(link_sorted_(list, cnt_, 0, red_depth_(cnt_)));
+
+    if (error) std::rethrow_exception(error);
+    return old_cnt - cnt_;
+}
+
+// 删除节点 node 后，红黑树的调整策略
+// 注意：首次调用rebalance_after_remove_时，node 为黑色叶节点
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+void RBTree<K, V, NodeType, Compare, Alloc>::rebalance_after_remove_(NodeType *node) {
+    // case 3 会把父节点当作缺少一个黑节点的子树继续向上调整，因此使用循环而不是递归
+    while (header_.parent() != node) {
+        auto sibling = static_cast<NodeType *>(node->get_sibling(&header_));
+
+        /*
+         * case 1: node 节点的兄弟节点为红色
+         *     step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
+         *     step 2: 父兄节点变色（父节点变红，兄节点变黑）
+         *     step 3: 更新兄弟节点，并继续调整
+         *      [P]                   <S>
+         *      / \    l-rotate(P)    / \
+         *    [N] <S>  ==========>  [P] [D]
+         *        / \               / \
+         *      [C] [D]           [N] [C]
+         * */
+        if (sibling->color() == RBTreeColor::kRed) {
+            auto parent = static_cast<NodeType *>(node->get_parent(&header_));
+            // step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
+            if (parent->left == node) rotate_left_(parent);
+            else rotate_right_(parent);
+
+            // step 2: 父兄节点变色（父节点变红，兄节点变黑）
+            parent->set_color(RBTreeColor::kRed);
+            sibling->set_color(RBTreeColor::kBlack);
+
+            // step 3: 更新兄弟节点，并继续调整
             sibling = static_cast<NodeType *>(node->get_sibling(&header_));
-            if (parent->left == node) {
-                close_nephew = static_cast<NodeType *>(sibling->left);
-                distant_nephew = static_cast<NodeType *>(sibling->right);
-            } else {
-                close_nephew = static_cast<NodeType *>(sibling->right);
-                distant_nephew = static_cast<NodeType *>(sibling->left);
-            }
         }
 
-        // case 5: 兄弟节点为黑色，最远的侄子节点是红色（LL型或RR型）
-        //     step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
-        //     step 2: 交换父节点和兄弟节点的颜色
-        //     step 3: 将最远的侄子节点的颜色变为黑
-        //      {P}                   [S]               {S}
-        //      / \    l-rotate(P)    / \    repaint    / \
-        //    [N] [S]  ==========>  {P} <D>  ======>  [P] [D]
-        //        / \               / \               / \
-        //      {C} <D>           [N] {C}           [N] {C}
+        auto parent = static_cast<NodeType *>(node->get_parent(&header_));
+        NodeType *close_nephew, *distant_nephew;
+        if (parent->left == node) {
+            close_nephew = static_cast<NodeType *>(sibling->left);
+            distant_nephew = static_cast<NodeType *>(sibling->right);
+        } else {
+            close_nephew = static_cast<NodeType *>(sibling->right);
+            distant_nephew = static_cast<NodeType *>(sibling->left);
+        }
 
-        // step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
-        if (parent->left == node) rotate_left_(parent);
-        else rotate_right_(parent);
+        bool all_nephew_is_black = true;
+        if (close_nephew != nullptr && close_nephew->color() == kRed) {
+            all_nephew_is_black = false;
+        }
+        if (distant_nephew != nullptr && distant_nephew->color() == kRed) {
+            all_nephew_is_black = false;
+        }
 
-        // step 2: 交换父节点和兄弟节点的颜色
-        sibling->color = parent->color;
-        parent->color = RBTreeColor::kBlack;
 
-        // step 3: 将最远的侄子节点的颜色变为黑
-        if (distant_nephew != nullptr) {
-            distant_nephew->color = RBTreeColor::kBlack;
+        if (all_nephew_is_black) {
+            if (parent->color() == RBTreeColor::kRed) {
+                /*
+                 * case 2: 兄弟节点为黑，侄子节点全为黑，且父节点为红
+                 *     将父节点和兄弟节点变色（父变黑，兄变红）
+                 *      <P>             [P]
+                 *      / \             / \
+                 *    [N] [S]  ====>  [N] <S>
+                 *        / \             / \
+                 *      [C] [D]         [C] [D]
+                 * */
+                parent->set_color(RBTreeColor::kBlack);
+                sibling->set_color(RBTreeColor::kRed);
+                return;
+            } else {
+                /*
+                 * case 3: 兄弟节点、所有侄子节点和父节点全为黑
+                 *     step 1: 将兄弟节点变红
+                 *     step 2: 继续处理父节点
+                 *      [P]             [P]
+                 *      / \             / \
+                 *    [N] [S]  ====>  [N] <S>
+                 *        / \             / \
+                 *      [C] [D]         [C] [D]
+                 * */
+                sibling->set_color(RBTreeColor::kRed);
+                node = parent;
+                continue;
+            }
+        } else {
+            /*
+             * case 4: 兄弟节点为黑色，离 node 最近的侄子节点是红色（LR型或RL型）
+             *     step 1: 如果兄弟节点是左孩子，左旋兄弟节点；否则，右旋兄弟节点
+             *     step 2: 交换最近的侄子节点和兄弟节点的颜色
+             *     step 3: 转到 case 5
+             *                            {P}
+             *      {P}                   / \
+             *      / \    r-rotate(S)  [N] <C>
+             *    [N] [S]  ==========>        \
+             *        / \                     [S]
+             *      <C> [D]                     \
+             *                                  [D]
+             * */
+            if (close_nephew != nullptr && close_nephew->color() == kRed) {
+                // step 1: 如果兄弟节点是左孩子，左旋兄弟节点；否则，右旋兄弟节点
+                if (parent->left == sibling) {
+                    rotate_left_(sibling);
+                } else rotate_right_(sibling);
+
+                // step 2: 交换最近的侄子节点和兄弟节点的颜色
+                sibling->set_color(RBTreeColor::kRed);
+                close_nephew->set_color(RBTreeColor::kBlack);
+
+                // 更新 sibling, close_nephew 和 distant_nephew
+                sibling = static_cast<NodeType *>(node->get_sibling(&header_));
+                if (parent->left == node) {
+                    close_nephew = static_cast<NodeType *>(sibling->left);
+                    distant_nephew = static_cast<NodeType *>(sibling->right);
+                } else {
+                    close_nephew = static_cast<NodeType *>(sibling->right);
+                    distant_nephew = static_cast<NodeType *>(sibling->left);
+                }
+            }
+
+            /*
+             * case 5: 兄弟节点为黑色，最远的侄子节点是红色（LL型或RR型）
+             *     step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
+             *     step 2: 交换父节点和兄弟节点的颜色
+             *     step 3: 将最远的侄子节点的颜色变为黑
+             *      {P}                   [S]               {S}
+             *      / \    l-rotate(P)    / \    repaint    / \
+             *    [N] [S]  ==========>  {P} <D>  ======>  [P] [D]
+             *        / \               / \               / \
+             *      {C} <D>           [N] {C}           [N] {C}
+             * */
+
+            // step 1: 如果 node 是左孩子，左旋父节点；否则，右旋父节点
+            if (parent->left == node) rotate_left_(parent);
+            else rotate_right_(parent);
+
+            // step 2: 交换父节点和兄弟节点的颜色
+            sibling->set_color(parent->color());
+            parent->set_color(RBTreeColor::kBlack);
+
+            // step 3: 将最远的侄子节点的颜色变为黑
+            if (distant_nephew != nullptr) {
+                distant_nephew->set_color(RBTreeColor::kBlack);
+            }
+            return;
         }
     }
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-NodeType *RBTree<K, V, NodeType, Compare>::find_(NodeType *node, const K &key) {
-    if (node == nullptr) return nullptr;
-
-    if (key == node->key) return node;
-    else {
-        auto l_son = static_cast<NodeType *>(node->left);
-        auto r_son = static_cast<NodeType *>(node->right);
-        if (cmp_(key, node->key)) {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename KeyArg>
+NodeType *RBTree<K, V, NodeType, Compare, Alloc>::find_(NodeType *node, const KeyArg &key) {
+    // 只使用比较器判断相等（!(a < b) && !(b < a)），不要求 KeyArg 与 K 之间定义了 ==
+    NodeBase *cur = node;
+    while (cur != nullptr) {
+        auto tmp = static_cast<NodeType *>(cur);
+        NodeBase *l_son = cur->left;
+        NodeBase *r_son = cur->right;
+        if (cmp_(key, tmp->key)) {
             // key < node->key
-            return find_(l_son, key);
-        } else {
+            cur = l_son;
+        } else if (cmp_(tmp->key, key)) {
             // key > node->key
-            return find_(r_son, key);
+            cur = r_son;
+        } else {
+            return tmp;
         }
     }
+    return nullptr;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-NodeType *RBTree<K, V, NodeType, Compare>::lower_bound_(
-        NodeType *node, const K &key, NodeType *satisfy_node) {
-    if (node == nullptr) return satisfy_node;
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename KeyArg>
+NodeType *RBTree<K, V, NodeType, Compare, Alloc>::lower_bound_(NodeType *node, const KeyArg &key) {
+    NodeType *satisfy_node = nullptr;  // 上一次满足条件的节点
+    NodeBase *cur = node;
+    while (cur != nullptr) {
+        auto tmp = static_cast<NodeType *>(cur);
+        if (!cmp_(tmp->key, key)) {
+            // key <= node->key, 满足条件，继续走左孩子
+            satisfy_node = tmp;
+            cur = cur->left;
+        } else {
+            // key > node->key, 不满足条件，走右孩子
+            cur = cur->right;
+        }
+    }
+    return satisfy_node;
+}
 
-    auto l_son = static_cast<NodeType *>(node->left);
-    auto r_son = static_cast<NodeType *>(node->right);
-    if (!cmp_(node->key, key)) {
-        // key <= node->key, 满足条件，继续走左孩子
-        return lower_bound_(l_son, key, node);
-    } else {
-        // key > node->key, 不满足条件，走右孩子
-        return lower_bound_(r_son, key, satisfy_node);
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<typename KeyArg>
+NodeType *RBTree<K, V, NodeType, Compare, Alloc>::upper_bound_(NodeType *node, const KeyArg &key) {
+    NodeType *satisfy_node = nullptr;  // 上一次满足条件的节点
+    NodeBase *cur = node;
+    while (cur != nullptr) {
+        auto tmp = static_cast<NodeType *>(cur);
+        if (!cmp_(key, tmp->key)) {
+            // key >= node->key, 满足条件，继续走右孩子
+            satisfy_node = tmp;
+            cur = cur->right;
+        } else {
+            // key < node->key, 不满足条件，走左孩子
+            cur = cur->left;
+        }
     }
+    return satisfy_node;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-NodeType *RBTree<K, V, NodeType, Compare>::upper_bound_(
-        NodeType *node, const K &key, NodeType *satisfy_node) {
-    if (node == nullptr) return satisfy_node;
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+template<bool or_equal, typename KeyArg>
+typename RBTree<K, V, NodeType, Compare, Alloc>::SizeType
+RBTree<K, V, NodeType, Compare, Alloc>::count_less_(const KeyArg &key) {
+    // 每次走向右孩子时，左子树和当前节点都满足条件
+    SizeType cnt = 0;
+    NodeBase *cur = header_.parent();
+    while (cur != nullptr) {
+        auto tmp = static_cast<NodeType *>(cur);
+        bool satisfy = or_equal ? !cmp_(key, tmp->key) : cmp_(tmp->key, key);
+        if (satisfy) {
+            cnt += subtree_size_(cur->left) + 1;
+            cur = cur->right;
+        } else {
+            cur = cur->left;
+        }
+    }
+    return cnt;
+}
 
-    auto l_son = static_cast<NodeType *>(node->left);
-    auto r_son = static_cast<NodeType *>(node->right);
-    if (!cmp_(key, node->key)) {
-        // key >= node->key, 满足条件，继续走右孩子
-        return upper_bound_(r_son, key, node);
-    } else {
-        // key < node->key, 不满足条件，走左孩子
-        return upper_bound_(l_son, key, satisfy_node);
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+typename RBTree<K, V, NodeType, Compare, Alloc>::Iterator
+RBTree<K, V, NodeType, Compare, Alloc>::select(SizeType k) const {
+    static_assert(kCountsSize, "RBTree::select requires RBTreeSizeAugment");
+    if (k >= cnt_) return this->end();
+
+    // 左子树中有 left_size 个节点：k 更小时进入左子树，否则跳过左子树和当前节点
+    const NodeBase *cur = header_.parent();
+    while (true) {
+        SizeType left_size = subtree_size_(cur->left);
+        if (k < left_size) {
+            cur = cur->left;
+        } else if (k == left_size) {
+            return Iterator(cur, &header_);
+        } else {
+            k -= left_size + 1;
+            cur = cur->right;
+        }
     }
 }
 
 
 // 红黑树迭代器的实现 ********************************************************
-template<typename K, typename V, typename NodeType, typename Compare>
-struct RBTree<K, V, NodeType, Compare>::Iterator {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+struct RBTree<K, V, NodeType, Compare, Alloc>::Iterator {
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<ReturnType>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ReturnType;
+
     NodeBase *node;
     const NodeBase *header;
 
@@ -956,7 +1970,7 @@ struct RBTree<K, V, NodeType, Compare>::Iterator {
 
     Iterator operator--(int) {
         Iterator tmp = *this;
-        ++*this;
+        --*this;
         return tmp;
     }
 
@@ -969,9 +1983,9 @@ struct RBTree<K, V, NodeType, Compare>::Iterator {
     }
 };
 
-template<typename K, typename V, typename NodeType, typename Compare>
-typename RBTree<K, V, NodeType, Compare>::Iterator &
-RBTree<K, V, NodeType, Compare>::Iterator::operator++() {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+typename RBTree<K, V, NodeType, Compare, Alloc>::Iterator &
+RBTree<K, V, NodeType, Compare, Alloc>::Iterator::operator++() {
     if (node->right != nullptr) {
         auto tmp = node->right;
         while (tmp->left != nullptr) tmp = tmp->left;
@@ -979,19 +1993,29 @@ RBTree<K, V, NodeType, Compare>::Iterator::operator++() {
         return *this;
     }
 
-    auto p = node->get_parent(header);
-    if (p != nullptr && p->left == node) {
+    // 沿父节点向上回溯，直到 node 是其父节点的左孩子。根节点的父节点是头节点，
+    // 头节点的 right 是最后一个节点，因此从最后一个节点出发时会停在头节点上，
+    // 循环中不需要与头节点比较
+    auto p = node->parent();
+    while (p->right == node) {
         node = p;
-        return *this;
+        p = node->parent();
     }
 
-    node = const_cast<NodeBase *>(header);
+    // 根节点没有右子树且为最后一个节点时，上面的循环停在 node 为头节点、p 为根节点处
+    if (node->right != p) node = p;
     return *this;
 }
 
-template<typename K, typename V, typename NodeType, typename Compare>
-typename RBTree<K, V, NodeType, Compare>::Iterator &
-RBTree<K, V, NodeType, Compare>::Iterator::operator--() {
+template<typename K, typename V, typename NodeType, typename Compare, typename Alloc>
+typename RBTree<K, V, NodeType, Compare, Alloc>::Iterator &
+RBTree<K, V, NodeType, Compare, Alloc>::Iterator::operator--() {
+    // end() 的前一个位置为中序遍历的最后一个节点
+    if (node == header) {
+        node = header->right;
+        return *this;
+    }
+
     if (node->left != nullptr) {
         auto tmp = node->left;
         while (tmp->right != nullptr) tmp = tmp->right;
@@ -999,13 +2023,14 @@ RBTree<K, V, NodeType, Compare>::Iterator::operator--() {
         return *this;
     }
 
+    // 沿父节点向上回溯，直到 node 是其父节点的右孩子
     auto p = node->get_parent(header);
-    if (p != nullptr && p->right == node) {
+    while (p != nullptr && p->left == node) {
         node = p;
-        return *this;
+        p = node->get_parent(header);
     }
 
-    node = const_cast<NodeBase *>(header);
+    node = p == nullptr ? const_cast<NodeBase *>(header) : p;
     return *this;
 }
 
@@ -0,0 +1,694 @@
+//
+// Created by DELL on 2026/10/16.
+//
+// 开放寻址哈希表（SwissTable 风格），BUnorderedMap 与 BUnorderedSet 的底层实现
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+#include "baby_hash.h"
+#include "baby_type_traits.h"
+
+#ifndef CPPBABYSTL_SWISS_TABLE_H
+#define CPPBABYSTL_SWISS_TABLE_H
+
+// 支持 SSE2 时每次用一条比较指令检查 16 个控制字节，否则逐字节检查
+#if defined(__SSE2__)
+#define CPPBABYSTL_SWISS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/*
+ * 控制字节，每个槽对应一个：
+ *   1. kEmpty（0x80）：空槽，从未存放过元素，查找遇到空槽即可停止
+ *   2. kDeleted（0xFE）：墓碑，元素已被删除，查找需要越过它继续探测
+ *   3. 0 ~ 127：槽中存放着元素，值为该元素哈希值的低 7 位（h2）
+ * 空槽和墓碑的最高位都是 1，存放元素的槽最高位是 0
+ * */
+enum SwissCtrl : std::int8_t {
+    kSwissEmpty = -128,
+    kSwissDeleted = -2,
+};
+
+/*
+ * 由 16 个连续的控制字节组成的组，哈希表按组进行探测
+ *
+ * 所有 match 函数都返回 16 位的位掩码，第 i 位对应组内第 i 个控制字节
+ * */
+struct SwissGroup {
+    static constexpr std::size_t kWidth = 16;
+
+#ifdef CPPBABYSTL_SWISS_SSE2
+    static __m128i load_(const std::int8_t *g) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(g));
+    }
+
+    // 与 h2 相等的控制字节
+    static unsigned match(const std::int8_t *g, std::int8_t h2) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(load_(g), _mm_set1_epi8(h2))));
+    }
+
+    // 空槽
+    static unsigned match_empty(const std::int8_t *g) {
+        return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(load_(g), _mm_set1_epi8(kSwissEmpty))));
+    }
+
+    // 空槽或墓碑，即最高位为 1 的控制字节
+    static unsigned match_empty_or_deleted(const std::int8_t *g) {
+        return static_cast<unsigned>(_mm_movemask_epi8(load_(g)));
+    }
+#else
+    static unsigned match(const std::int8_t *g, std::int8_t h2) {
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < kWidth; i++) mask |= unsigned(g[i] == h2) << i;
+        return mask;
+    }
+
+    static unsigned match_empty(const std::int8_t *g) {
+        return match(g, kSwissEmpty);
+    }
+
+    static unsigned match_empty_or_deleted(const std::int8_t *g) {
+        unsigned mask = 0;
+        for (std::size_t i = 0; i < kWidth; i++) mask |= unsigned(g[i] < 0) << i;
+        return mask;
+    }
+#endif
+
+    // 存放着元素的槽
+    static unsigned match_full(const std::int8_t *g) {
+        return ~match_empty_or_deleted(g) & 0xFFFFu;
+    }
+};
+
+/*
+ * 哈希表的槽，用于 unordered_set，只存储`键`
+ * */
+template<typename Key>
+struct SwissSetSlot {
+    Key key;
+
+    using ReturnType = const Key &;
+
+    // set 的槽只存储`键`，忽略多余的实参。不参与槽自身的拷贝和移动
+    template<typename KeyArg, typename ...Args,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<KeyArg>, SwissSetSlot>>>
+    explicit SwissSetSlot(KeyArg &&k, Args &&...)
+            : key(std::forward<KeyArg>(k)) {}
+
+    ReturnType get_data() { return key; }
+    ReturnType get_data() const { return key; }
+};
+
+/*
+ * 哈希表的槽，用于 unordered_map，`键`和`值`相邻存放
+ * */
+template<typename Key, typename Value>
+struct SwissMapSlot {
+    Key key;
+    Value val;
+
+    using ReturnType = std::pair<const Key &, Value &>;
+
+    // args 被转发给`值`的构造函数，没有实参时`值`被值初始化。不参与槽自身的拷贝和移动
+    template<typename KeyArg, typename ...Args,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<KeyArg>, SwissMapSlot>>>
+    explicit SwissMapSlot(KeyArg &&k, Args &&... args)
+            : key(std::forward<KeyArg>(k)),
+              val(std::forward<Args>(args)...) {}
+
+    ReturnType get_data() { return {key, val}; }
+    ReturnType get_data() const { return {key, const_cast<Value &>(val)}; }
+};
+
+// 槽中的`键`和`值`都可以按字节搬迁时，扩容时直接 memcpy 整个槽
+template<typename Key>
+struct b_is_trivially_relocatable<SwissSetSlot<Key>> : b_is_trivially_relocatable<Key> {};
+
+template<typename Key, typename Value>
+struct b_is_trivially_relocatable<SwissMapSlot<Key, Value>>
+        : std::bool_constant<b_is_trivially_relocatable_v<Key> && b_is_trivially_relocatable_v<Value>> {};
+
+/*
+ * 开放寻址哈希表
+ *
+ *   1. 内存布局：控制字节数组 ctrl_ 和槽数组 slots_ 各占一块连续内存，
+ *      两者长度都是 capacity_（0 或不小于 16 的 2 的幂）。元素直接存放在
+ *      槽中，没有单独的节点，也没有链表指针
+ *   2. 探测：哈希值的高 57 位（h1）选择起始组，低 7 位（h2）存入控制字节。
+ *      查找时在一个组内用一条 SIMD 比较找出 h2 相同的槽，只有这些槽才需要
+ *      比较`键`，平均每次查找只比较约 1 次`键`；组内存在空槽时停止，否则
+ *      按 1、2、3... 的步长（三角数序列）跳到下一个组，组数是 2 的幂，
+ *      因此能够遍历所有的组
+ *   3. 删除：组内还有空槽时说明从未有查找越过该组，直接标记为空槽；否则
+ *      标记为墓碑。墓碑在下一次扩容或原地重建时被清除
+ *   4. 负载因子：元素与墓碑的总数不超过容量的 7/8
+ *
+ * 插入可能触发扩容，使所有迭代器失效；删除只使指向被删除元素的迭代器失效
+ *
+ * @tparam K `键`的类型
+ * @tparam SlotType 槽的类型，SwissSetSlot 或 SwissMapSlot
+ * @tparam Hash 可调用对象，计算 K 的哈希值
+ * @tparam KeyEqual 可调用对象，判断两个 K 是否相等
+ * @tparam Alloc 分配器，哈希表会将其 rebind 到 SlotType 后用于分配槽数组
+ * */
+template<typename K, typename SlotType,
+        typename Hash = std::hash<K>,
+        typename KeyEqual = std::equal_to<K>,
+        typename Alloc = std::allocator<SlotType>>
+class SwissTable {
+public:
+    using SizeType = std::size_t;
+    using CtrlType = std::int8_t;
+    using ReturnType = typename SlotType::ReturnType;
+    struct Iterator;
+
+    enum : SizeType {
+        kGroupWidth = SwissGroup::kWidth,
+        kMinCapacity = SwissGroup::kWidth,  // 非空表的最小容量，即一个组
+        kNotFound = SizeType(-1)
+    };
+
+private:
+    using SlotAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<SlotType>;
+    using SlotAllocTraits = std::allocator_traits<SlotAllocType>;
+    using CtrlAllocType = typename std::allocator_traits<Alloc>::template rebind_alloc<CtrlType>;
+    using CtrlAllocTraits = std::allocator_traits<CtrlAllocType>;
+
+    CtrlType *ctrl_{};        // 控制字节数组，空表时为 nullptr
+    SlotType *slots_{};       // 槽数组，空表时为 nullptr
+    SizeType capacity_{};     // 槽的数目
+    SizeType size_{};         // 元素的数目
+    SizeType growth_left_{};  // 不扩容的前提下还能占用的空槽数目
+    Hash hash_;
+    KeyEqual eq_;
+    SlotAllocType alloc_;     // 分配槽数组所用的分配器
+
+    // 容量为 cap 时最多能容纳的元素与墓碑的总数
+    static SizeType max_load_(SizeType cap) { return cap - cap / 8; }
+
+    // 能容纳 n 个元素的最小容量
+    static SizeType capacity_for_(SizeType n) {
+        SizeType cap = kMinCapacity;
+        while (max_load_(cap) < n) cap *= 2;
+        return cap;
+    }
+
+    /*
+     * 用户提供的哈希函数（如整数的 std::hash）可能只是恒等映射，低位和高位
+     * 都不够随机。再做一次 64 x 64 -> 128 位乘法混合，使 h1、h2 都依赖于
+     * 全部的输入位
+     * */
+    template<typename KeyArg>
+    SizeType hash_of_(const KeyArg &key) const {
+        return static_cast<SizeType>(BHash::mix(static_cast<std::uint64_t>(hash_(key))));
+    }
+
+    static SizeType h1_(SizeType hash) { return hash >> 7; }
+
+    static CtrlType h2_(SizeType hash) { return static_cast<CtrlType>(hash & 0x7F); }
+
+    SizeType group_mask_() const { return capacity_ / kGroupWidth - 1; }
+
+    // 查找`键`为 key 的元素所在的槽，不存在时返回 kNotFound
+    template<typename KeyArg>
+    SizeType find_index_(const KeyArg &key, SizeType hash) const;
+
+    // 沿 hash 的探测序列找到第一个空槽或墓碑，调用前必须保证 growth_left_ > 0
+    SizeType find_insert_slot_(SizeType hash) const;
+
+    // 申请容量为 cap 的数组，所有控制字节置为空槽
+    void allocate_(SizeType cap);
+
+    // 释放 ctrl_ 和 slots_，不析构任何元素
+    void deallocate_();
+
+    // 析构所有元素
+    void destroy_slots_();
+
+    // 把 src 槽中的元素搬迁到 dst 槽中，src 不再持有元素
+    void relocate_slot_(SlotType *dst, SlotType *src);
+
+    // 以容量 cap 重建哈希表，所有元素重新插入，墓碑被清除
+    void resize_(SizeType cap);
+
+    // 没有剩余空间时调用：墓碑较多时原地重建，否则容量翻倍
+    void make_room_();
+
+    // 在第 idx 个槽中构造元素
+    template<typename ...Args>
+    void construct_at_(SizeType idx, SizeType hash, Args &&... args);
+
+    // 析构第 idx 个槽中的元素
+    void erase_at_(SizeType idx);
+
+    Iterator iter_at_(SizeType idx) const {
+        return Iterator(ctrl_ + idx, slots_ + idx, ctrl_ + capacity_);
+    }
+
+    // 复制 other 的控制字节和元素，元素位于与 other 相同的槽中，不需要重新计算哈希值
+    void copy_from_(const SwissTable &other);
+
+    // 接管 other 的数组，other 变为空表
+    void steal_(SwissTable &other) noexcept;
+
+public:
+    SwissTable() = default;
+
+    // 创建一个使用分配器 alloc 的空表
+    explicit SwissTable(const Alloc &alloc) : alloc_(alloc) {}
+
+    SwissTable(const SwissTable &other, const Alloc &alloc)
+            : hash_(other.hash_), eq_(other.eq_), alloc_(alloc) {
+        copy_from_(other);
+    }
+
+    // 拷贝构造函数
+    SwissTable(const SwissTable &other)
+            : SwissTable(other, SlotAllocTraits::select_on_container_copy_construction(other.alloc_)) {}
+
+    // 移动构造函数
+    SwissTable(SwissTable &&other) noexcept
+            : hash_(other.hash_), eq_(other.eq_), alloc_(other.alloc_) {
+        steal_(other);
+    }
+
+    SwissTable &operator=(const SwissTable &other);
+
+    /*
+     * @brief 移动赋值函数
+     *
+     * 分配器随容器一起转移或两者的分配器相等时，直接接管 other 的数组；
+     * 否则只能将元素逐个移动到由当前分配器申请的数组中
+     * */
+    SwissTable &operator=(SwissTable &&other) noexcept(
+            SlotAllocTraits::propagate_on_container_move_assignment::value ||
+            SlotAllocTraits::is_always_equal::value);
+
+    ~SwissTable() {
+        destroy_slots_();
+        deallocate_();
+    }
+
+    // 返回哈希表所使用的分配器
+    Alloc get_allocator() const { return Alloc(alloc_); }
+
+    // 交换两个哈希表的内容，不移动任何元素
+    void swap(SwissTable &other) noexcept;
+
+
+// @{  // 容量相关的操作
+public:
+
+    SizeType size() const noexcept { return size_; }
+
+    // 槽的数目
+    SizeType capacity() const noexcept { return capacity_; }
+
+    // 当前的负载因子（元素数目 / 槽的数目）
+    float load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+    }
+
+    // 预留至少能容纳 n 个元素的空间，此后插入不超过 n 个元素时不会扩容
+    void reserve(SizeType n) {
+        if (n > size_ + growth_left_) resize_(capacity_for_(n));
+    }
+// @}  // 容量相关的操作
+
+
+// @{  // 插入与删除
+public:
+
+    /*
+     * @brief 查找`键`为 key 的元素，不存在时用 key 和 args 构造一个新元素
+     * @return 元素的迭代器，以及是否插入了新元素。已经存在时 args 不会被使用
+     * */
+    template<typename KeyArg, typename ...Args>
+    std::pair<Iterator, bool> try_emplace(KeyArg &&key, Args &&... args);
+
+    // 删除`键`为 key 的元素，返回删除的元素数目（0 或 1）
+    template<typename KeyArg>
+    SizeType erase(const KeyArg &key) {
+        SizeType idx = find_index_(key, hash_of_(key));
+        if (idx == kNotFound) return 0;
+        erase_at_(idx);
+        return 1;
+    }
+
+    // 删除迭代器 pos 指向的元素，返回指向下一个元素的迭代器
+    Iterator erase(Iterator pos) {
+        auto idx = static_cast<SizeType>(pos.slot - slots_);
+        erase_at_(idx);
+        return ++pos;
+    }
+
+    // 删除所有元素，保留已经申请的数组
+    void clear() noexcept;
+// @}  // 插入与删除
+
+
+// @{  // 查找与迭代器
+public:
+
+    template<typename KeyArg>
+    Iterator find(const KeyArg &key) const {
+        SizeType idx = find_index_(key, hash_of_(key));
+        return idx == kNotFound ? this->end() : iter_at_(idx);
+    }
+
+    template<typename KeyArg>
+    bool contains(const KeyArg &key) const {
+        return find_index_(key, hash_of_(key)) != kNotFound;
+    }
+
+    Iterator begin() const {
+        Iterator it = iter_at_(0);
+        it.skip_empty_();
+        return it;
+    }
+
+    Iterator end() const { return iter_at_(capacity_); }
+// @}  // 查找与迭代器
+};
+
+/*
+ * 哈希表的迭代器，按槽的顺序遍历所有元素，顺序与插入顺序无关
+ * */
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+struct SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::Iterator {
+    const CtrlType *ctrl;
+    SlotType *slot;
+    const CtrlType *last;  // 控制字节数组的末尾
+
+    explicit Iterator(const CtrlType *c, SlotType *s, const CtrlType *l)
+            : ctrl(c), slot(s), last(l) {}
+
+    // 跳过空槽和墓碑，停在下一个存放着元素的槽或末尾
+    void skip_empty_() {
+        while (ctrl != last && *ctrl < 0) {
+            ++ctrl;
+            ++slot;
+        }
+    }
+
+    ReturnType operator*() {
+        return slot->get_data();
+    }
+
+    Iterator &operator++() {
+        ++ctrl;
+        ++slot;
+        skip_empty_();
+        return *this;
+    }
+
+    Iterator operator++(int) {
+        Iterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+        return this->ctrl == other.ctrl;
+    }
+
+    bool operator!=(const Iterator &other) const {
+        return this->ctrl != other.ctrl;
+    }
+};
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+template<typename KeyArg>
+typename SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::SizeType
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::find_index_(const KeyArg &key, SizeType hash) const {
+    if (size_ == 0) return kNotFound;
+
+    const SizeType mask = group_mask_();
+    const CtrlType h2 = h2_(hash);
+    SizeType g = h1_(hash) & mask;
+    for (SizeType step = 1;; step++) {
+        const CtrlType *grp = ctrl_ + g * kGroupWidth;
+        for (unsigned m = SwissGroup::match(grp, h2); m != 0; m &= m - 1) {
+            SizeType idx = g * kGroupWidth + static_cast<SizeType>(__builtin_ctz(m));
+            if (eq_(slots_[idx].key, key)) return idx;
+        }
+        // 组内存在空槽时，插入 key 时不会越过该组，key 一定不存在
+        if (SwissGroup::match_empty(grp) != 0) return kNotFound;
+        g = (g + step) & mask;
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+typename SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::SizeType
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::find_insert_slot_(SizeType hash) const {
+    const SizeType mask = group_mask_();
+    SizeType g = h1_(hash) & mask;
+    for (SizeType step = 1;; step++) {
+        unsigned m = SwissGroup::match_empty_or_deleted(ctrl_ + g * kGroupWidth);
+        if (m != 0) return g * kGroupWidth + static_cast<SizeType>(__builtin_ctz(m));
+        g = (g + step) & mask;
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::allocate_(SizeType cap) {
+    CtrlAllocType ctrl_alloc(alloc_);
+    CtrlType *ctrl = CtrlAllocTraits::allocate(ctrl_alloc, cap);
+    try {
+        slots_ = SlotAllocTraits::allocate(alloc_, cap);
+    } catch (...) {
+        CtrlAllocTraits::deallocate(ctrl_alloc, ctrl, cap);
+        throw;
+    }
+    ctrl_ = ctrl;
+    std::memset(ctrl_, static_cast<unsigned char>(kSwissEmpty), cap);
+    capacity_ = cap;
+    growth_left_ = max_load_(cap);
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::deallocate_() {
+    if (capacity_ == 0) return;
+
+    CtrlAllocType ctrl_alloc(alloc_);
+    CtrlAllocTraits::deallocate(ctrl_alloc, ctrl_, capacity_);
+    SlotAllocTraits::deallocate(alloc_, slots_, capacity_);
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = growth_left_ = 0;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::destroy_slots_() {
+    if constexpr (!std::is_trivially_destructible_v<SlotType>) {
+        for (SizeType g = 0; g < capacity_ && size_ != 0; g += kGroupWidth) {
+            for (unsigned m = SwissGroup::match_full(ctrl_ + g); m != 0; m &= m - 1) {
+                SlotAllocTraits::destroy(alloc_, slots_ + g + static_cast<SizeType>(__builtin_ctz(m)));
+            }
+        }
+    }
+    size_ = 0;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::relocate_slot_(SlotType *dst, SlotType *src) {
+    if constexpr (b_is_trivially_relocatable_v<SlotType>) {
+        std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), sizeof(SlotType));
+    } else {
+        SlotAllocTraits::construct(alloc_, dst, std::move(*src));
+        SlotAllocTraits::destroy(alloc_, src);
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::resize_(SizeType cap) {
+    CtrlType *old_ctrl = ctrl_;
+    SlotType *old_slots = slots_;
+    SizeType old_cap = capacity_;
+
+    allocate_(cap);
+    for (SizeType g = 0; g < old_cap; g += kGroupWidth) {
+        for (unsigned m = SwissGroup::match_full(old_ctrl + g); m != 0; m &= m - 1) {
+            SlotType *src = old_slots + g + static_cast<SizeType>(__builtin_ctz(m));
+            SizeType hash = hash_of_(src->key);
+            SizeType idx = find_insert_slot_(hash);
+            relocate_slot_(slots_ + idx, src);
+            ctrl_[idx] = h2_(hash);
+        }
+    }
+    growth_left_ -= size_;
+
+    if (old_cap != 0) {
+        CtrlAllocType ctrl_alloc(alloc_);
+        CtrlAllocTraits::deallocate(ctrl_alloc, old_ctrl, old_cap);
+        SlotAllocTraits::deallocate(alloc_, old_slots, old_cap);
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::make_room_() {
+    if (capacity_ == 0) {
+        allocate_(kMinCapacity);
+    } else if (size_ * 32 <= capacity_ * 25) {
+        // 元素不到容量的 25/32，空间主要被墓碑占用：原地重建后至少还有 3/32 的空槽
+        resize_(capacity_);
+    } else {
+        resize_(capacity_ * 2);
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+template<typename ...Args>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::construct_at_(SizeType idx, SizeType hash, Args &&... args) {
+    // 先构造元素再修改控制字节，构造抛出异常时哈希表保持不变
+    SlotAllocTraits::construct(alloc_, slots_ + idx, std::forward<Args>(args)...);
+    if (ctrl_[idx] == kSwissEmpty) growth_left_--;
+    ctrl_[idx] = h2_(hash);
+    size_++;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+template<typename KeyArg, typename ...Args>
+std::pair<typename SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::Iterator, bool>
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::try_emplace(KeyArg &&key, Args &&... args) {
+    SizeType hash = hash_of_(key);
+    SizeType idx = find_index_(key, hash);
+    if (idx != kNotFound) return {iter_at_(idx), false};
+
+    if (growth_left_ == 0) make_room_();
+    idx = find_insert_slot_(hash);
+    construct_at_(idx, hash, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    return {iter_at_(idx), true};
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::erase_at_(SizeType idx) {
+    SlotAllocTraits::destroy(alloc_, slots_ + idx);
+    size_--;
+
+    // 组内已有空槽说明自上次重建以来该组从未被填满，没有查找会越过该组
+    if (SwissGroup::match_empty(ctrl_ + (idx & ~SizeType(kGroupWidth - 1))) != 0) {
+        ctrl_[idx] = kSwissEmpty;
+        growth_left_++;
+    } else {
+        ctrl_[idx] = kSwissDeleted;
+    }
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::clear() noexcept {
+    if (capacity_ == 0) return;
+
+    destroy_slots_();
+    std::memset(ctrl_, static_cast<unsigned char>(kSwissEmpty), capacity_);
+    growth_left_ = max_load_(capacity_);
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::copy_from_(const SwissTable &other) {
+    if (other.size_ == 0) return;
+
+    allocate_(other.capacity_);
+    for (SizeType g = 0; g < capacity_; g += kGroupWidth) {
+        for (unsigned m = SwissGroup::match_full(other.ctrl_ + g); m != 0; m &= m - 1) {
+            SizeType idx = g + static_cast<SizeType>(__builtin_ctz(m));
+            try {
+                SlotAllocTraits::construct(alloc_, slots_ + idx, other.slots_[idx]);
+            } catch (...) {
+                destroy_slots_();
+                deallocate_();
+                throw;
+            }
+            ctrl_[idx] = other.ctrl_[idx];
+            size_++;
+        }
+    }
+    // 墓碑也要复制：其他元素的探测序列可能越过了墓碑所在的组
+    std::memcpy(ctrl_, other.ctrl_, capacity_);
+    growth_left_ = other.growth_left_;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::steal_(SwissTable &other) noexcept {
+    ctrl_ = std::exchange(other.ctrl_, nullptr);
+    slots_ = std::exchange(other.slots_, nullptr);
+    capacity_ = std::exchange(other.capacity_, 0);
+    size_ = std::exchange(other.size_, 0);
+    growth_left_ = std::exchange(other.growth_left_, 0);
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc> &
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::operator=(const SwissTable &other) {
+    if (this == &other) return *this;
+
+    destroy_slots_();
+    deallocate_();
+    hash_ = other.hash_;
+    eq_ = other.eq_;
+    if constexpr (SlotAllocTraits::propagate_on_container_copy_assignment::value) {
+        alloc_ = other.alloc_;
+    }
+    copy_from_(other);
+    return *this;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc> &
+SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::operator=(SwissTable &&other) noexcept(
+        SlotAllocTraits::propagate_on_container_move_assignment::value ||
+        SlotAllocTraits::is_always_equal::value) {
+    if (this == &other) return *this;
+
+    destroy_slots_();
+    deallocate_();
+    hash_ = other.hash_;
+    eq_ = other.eq_;
+
+    if constexpr (SlotAllocTraits::propagate_on_container_move_assignment::value) {
+        alloc_ = other.alloc_;
+    } else {
+        if (alloc_ != other.alloc_) {
+            // other 的数组只能由 other 的分配器释放，因此在当前分配器申请的数组中重建
+            if (other.size_ == 0) return *this;
+            allocate_(other.capacity_);
+            for (SizeType g = 0; g < capacity_; g += kGroupWidth) {
+                for (unsigned m = SwissGroup::match_full(other.ctrl_ + g); m != 0; m &= m - 1) {
+                    SizeType idx = g + static_cast<SizeType>(__builtin_ctz(m));
+                    SlotAllocTraits::construct(alloc_, slots_ + idx, std::move(other.slots_[idx]));
+                    ctrl_[idx] = other.ctrl_[idx];
+                    size_++;
+                }
+            }
+            std::memcpy(ctrl_, other.ctrl_, capacity_);
+            growth_left_ = other.growth_left_;
+            other.destroy_slots_();
+            other.deallocate_();
+            return *this;
+        }
+    }
+    steal_(other);
+    return *this;
+}
+
+template<typename K, typename SlotType, typename Hash, typename KeyEqual, typename Alloc>
+void SwissTable<K, SlotType, Hash, KeyEqual, Alloc>::swap(SwissTable &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(eq_, other.eq_);
+    if constexpr (SlotAllocTraits::propagate_on_container_swap::value) {
+        std::swap(alloc_, other.alloc_);
+    }
+}
+
+#endif //CPPBABYSTL_SWISS_TABLE_H